@@ -17,50 +17,355 @@
 #define CLIENT_H
 #pragma once
 
+#include "../protocol/package/capture.h"
 #include "../protocol/package/definition.h"
+#include "../protocol/package/frame.h"
 #include "../protocol/package/package.h"
+#include "../world/chunkStore.h"
+#include "../world/entityTable.h"
 #include "clientBase.h"
-#include <typeindex>
-#include <any>
+#include "coroutine.h"
+#include "executor.h"
+#include "handlers.h"
+#include "latency.h"
+#include "metrics.h"
+#include "timeline.h"
 
 namespace minecraft::client {
 
+    /**
+     * @if zh
+     * @brief 用户回调的分发方式
+     * @details
+     * - @c INLINE 所有回调在接收线程内执行
+     * - @c SHARDED 解码后的数据包按 @c ShardKey 投递到工作线程池，同一键的数据包保持顺序；压缩、状态切换、KeepAlive等协议内置处理仍在接收线程内执行
+     * @note 分片模式下同一类型的回调可能在不同工作线程上并发执行
+     *
+     * @else
+     * @brief How user callbacks are dispatched
+     * @details
+     * - @c INLINE every callback runs on the receive thread
+     * - @c SHARDED decoded packets are posted to a worker pool by @c ShardKey, packets with the same key keep their order;
+     *   built-in protocol handling (compression, state changes, KeepAlive, ...) still runs on the receive thread
+     * @note In sharded mode callbacks of the same type may run concurrently on different workers
+     *
+     * @endif
+     * */
+    enum class DispatchMode { INLINE, SHARDED };
+
+    /** @struct AnyPacket
+     *
+     * @if zh
+     * @brief 默认匹配器，接受任意数据包
+     *
+     * @else
+     * @brief Default matcher, accepts any packet
+     *
+     * @endif
+     * */
+    struct AnyPacket {
+        template<protocol::is_package T>
+        constexpr bool operator()(const T&) const {
+            return true;
+        }
+    };
+
+    template<has_handler_slot T, typename M, bool Timed>
+    class PacketAwaiter;
+
     class Client final : public ClientBase<std::vector<std::byte>> {
     public:
         explicit Client(std::string ip = "127.0.0.1", short port = 25565, bool debug = false);
 
+        ~Client() override;
+
         void start() override;
 
-        template<protocol::is_package T>
-        void on(std::function<void(const T&)> callback, int times = -1);
+        /**
+         * @if zh
+         * @brief 设置用户回调的分发方式
+         * @details 须在 @c start 之前调用：接收线程对每个数据包都读取执行器与并发标志，运行中替换会与其竞争并可能销毁仍在执行的工作线程；
+         * 启动后调用将被忽略并输出警告
+         * @param workers 分片模式下的工作线程数
+         *
+         * @else
+         * @brief Set how user callbacks are dispatched
+         * @details Must be called before @c start: the receive thread reads the executor and the concurrency flag for every packet,
+         * replacing them while running would race with it and could destroy workers that are still executing; calls after start are
+         * ignored with a warning
+         * @param workers Number of worker threads in sharded mode
+         *
+         * @endif
+         * */
+        void setDispatchMode(DispatchMode mode, std::size_t workers = std::thread::hardware_concurrency());
 
-        template<protocol::State S, int I>
-        void on(std::function<void(const typename protocol::ServerPacketType<S, I>::type&)> callback, int times = -1);
+        /**
+         * @if zh
+         * @brief 将收发的原始帧写入二进制抓包文件
+         * @details 须在 @c start 之前调用；文件可用 @c protocol::printCapture 离线解码
+         *
+         * @else
+         * @brief Write every sent and received raw frame to a binary capture file
+         * @details Must be called before @c start; the file can be decoded offline with @c protocol::printCapture
+         *
+         * @endif
+         * */
+        bool capture(const std::string& path);
 
-        template<protocol::is_package T>
-        void once(std::function<void(const T&)> callback);
+        /**
+         * @if zh
+         * @brief 开启按数据包类型的流量与耗时统计
+         * @details 须在 @c start 之前调用；未开启时 @c metrics 返回空快照，@c dumpMetrics 返回false
+         *
+         * @else
+         * @brief Enable per-packet-type traffic and timing metrics
+         * @details Must be called before @c start; while disabled @c metrics returns an empty snapshot and @c dumpMetrics returns false
+         *
+         * @endif
+         * */
+        void enableMetrics();
+
+        [[nodiscard]] MetricsSnapshot metrics() const;
+
+        bool dumpMetrics(const std::string& path) const;
+
+        /**
+         * @if zh
+         * @brief 设置本连接压缩模式下的跳过策略
+         * @details 须在 @c start 之前调用：发送路径在序列化时读取策略，启动后调用将被忽略并输出警告；策略与统计均按连接持有，多个客户端互不影响
+         *
+         * @else
+         * @brief Set the skip policy this connection uses in compressed mode
+         * @details Must be called before @c start: the send path reads the policy while serializing, calls after start are ignored with a
+         * warning; policy and counters are held per connection, clients do not affect each other
+         *
+         * @endif
+         * */
+        void setCompressionPolicy(const protocol::CompressionPolicy& policy);
+
+        [[nodiscard]] const protocol::CompressionStats& compressionStats() const;
+
+        /**
+         * @if zh
+         * @brief 开启区块跟踪：Chunk Data、Update Light、Update Section Blocks与Unload Chunk在接收线程上写入内置的 @c world::ChunkStore
+         * @details 须在 @c start 之前调用；未开启时这些数据包没有回调便不会被解码，@c chunks 返回空指针
+         * @param minY 世界最低高度
+         * @param keepLight 是否保留光照数组
+         *
+         * @else
+         * @brief Enable chunk tracking: Chunk Data, Update Light, Update Section Blocks and Unload Chunk are written into the built-in @c world::ChunkStore on the receive thread
+         * @details Must be called before @c start; while disabled these packets have no handler and are not decoded, and @c chunks returns null
+         * @param minY Lowest height of the world
+         * @param keepLight Whether to keep the light arrays
+         *
+         * @endif
+         * */
+        void enableChunks(int minY = -64, bool keepLight = true);
+
+        /**
+         * @if zh
+         * @brief 内置的区块存储
+         * @details 存储在接收线程上写入且非线程安全，只能在接收线程上使用：协议回调、 @c INLINE 模式的用户回调与 @c spawn 启动的协程；
+         * @c SHARDED 模式的工作线程或其他线程读取会与写入竞争
+         *
+         * @else
+         * @brief The built-in chunk store
+         * @details The store is written on the receive thread and is not thread safe, use it only on the receive thread: protocol callbacks,
+         * user callbacks in @c INLINE mode and coroutines started with @c spawn; reading it from @c SHARDED workers or any other thread races with the writes
+         *
+         * @endif
+         * */
+        [[nodiscard]] const world::ChunkStore* chunks() const;
+
+        /**
+         * @if zh
+         * @brief 开启实体跟踪：各Spawn数据包、Set Entity Velocity与Remove Entities在接收线程上写入内置的 @c world::EntityTable
+         * @details 须在 @c start 之前调用；未开启时 @c entities 返回空指针
+         *
+         * @else
+         * @brief Enable entity tracking: the Spawn packets, Set Entity Velocity and Remove Entities are written into the built-in @c world::EntityTable on the receive thread
+         * @details Must be called before @c start; while disabled @c entities returns null
+         *
+         * @endif
+         * */
+        void enableEntities();
+
+        [[nodiscard]] const world::EntityTable* entities() const;
+
+        template<has_handler_slot T, typename F>
+        Subscription on(F&& callback, int times = -1);
+
+        template<protocol::State S, int I, typename F>
+        Subscription on(F&& callback, int times = -1);
+
+        template<has_handler_slot T, FStrChar V, typename F>
+        Subscription on(FieldFilter<V>&& filter, F&& callback, int times = -1);
 
-        template<protocol::State S, int I>
-        void once(std::function<void(const typename protocol::ServerPacketType<S, I>::type&)> callback);
+        template<has_handler_slot T, typename F>
+        Subscription once(F&& callback);
+
+        template<has_handler_slot T, FStrChar V, typename F>
+        Subscription once(FieldFilter<V>&& filter, F&& callback);
+
+        template<protocol::State S, int I, typename F>
+        Subscription once(F&& callback);
 
         template<protocol::is_package T>
         void emit(T&& package, std::optional<std::function<void()>> callback = std::nullopt);
 
+        void spawn(Task<> task);
+
+        template<has_handler_slot T>
+        PacketAwaiter<T, AnyPacket, false> next();
+
+        template<has_handler_slot T, typename M>
+        PacketAwaiter<T, M, false> next(M matcher);
+
+        template<has_handler_slot R, protocol::is_package T, typename M = AnyPacket>
+        PacketAwaiter<R, M, true> request(T&& package, M matcher = {}, EventLoop::Clock::duration timeout = std::chrono::seconds(5));
+
+        SleepAwaiter sleep(EventLoop::Clock::duration duration);
+
+        [[nodiscard]] std::uint64_t skippedBytes(protocol::State state, int id) const;
+
+        [[nodiscard]] LatencyTracker& latency();
+
+        [[nodiscard]] TimelineTracker& timeline();
+
     private:
-        protocol::State state = protocol::State::HANDSHAKE;
+        template<has_handler_slot T, typename M, bool Timed>
+        friend class PacketAwaiter;
+
+        static constexpr std::size_t MAX_TRACKED_ID = 256;
+        // 工作线程中的回调会调用emit，连接参数需原子读写
+        std::atomic<protocol::State> state = protocol::State::HANDSHAKE;
+
+        std::atomic_bool compress = false;
+
+        std::atomic_int threshold = 0;
+
+        std::atomic_bool started = false;
+
+        protocol::CompressionPolicy compressionPolicy;
+
+        protocol::CompressionStats compressionCounters;
+
+        HandlerTable protocolCallbacks;
+
+        HandlerTable packageCallbacks;
+
+        std::unique_ptr<ShardedExecutor> executor;
 
-        bool compress = false;
+        std::unique_ptr<protocol::CaptureWriter> captureWriter;
 
-        int threshold = 0;
+        std::unique_ptr<MetricsRegistry> metricsRegistry;
 
-        std::unordered_map<std::type_index, std::vector<std::pair<int, std::function<void(const std::any&)>>>> packageCallbacks;
+        std::unique_ptr<world::ChunkStore> chunkStore;
+
+        std::unique_ptr<world::EntityTable> entityTable;
+
+        EventLoop loop;
+
+        LatencyTracker latencyTracker;
+
+        TimelineTracker frameTimes;
+
+        // 当前正在处理的数据的接收时刻
+        LatencyTracker::Clock::time_point recvTime;
+
+        protocol::FrameReader frameReader;
+
+        std::vector<std::byte> frame;
+
+        std::array<std::array<std::atomic<std::uint64_t>, MAX_TRACKED_ID>, minecraft::detail::enumMax<protocol::State>()> skipped{};
+
+        template<has_handler_slot T, typename F>
+        void hook(F&& callback);
+
+        template<protocol::is_package T>
+        [[nodiscard]] bool wants(const std::vector<std::byte>& data, int id) const;
+
+        void replied(Challenge kind, std::int64_t id);
+
+        void handleFrame(const std::vector<std::byte>& data, FrameTimeline timeline);
 
         void handleRecv(std::vector<std::byte>& msg, std::size_t size) override;
 
+        void handleSent(std::vector<std::byte>& msg, std::size_t size, SendTag tag, std::chrono::steady_clock::duration queued) override;
+
+        void tick() override;
+
         std::vector<std::byte> castChar2T(char* msg, std::size_t size) const override;
 
         char* castT2Char(std::vector<std::byte>& msg, std::size_t size) const override;
     };
+
+    /** @class PacketAwaiter
+     *
+     * @if zh
+     * @brief 等待下一个满足条件的数据包
+     * @details
+     * - 挂起时向协议回调表注册一次性回调，数据包在接收线程中按到达顺序匹配，分片分发模式下同样不会错过
+     * - 请求模式在注册后才把请求放入发送队列，带超时，超时返回空
+     * - 等待器本身即是回调捕获对象与定时器目标，挂起不产生额外分配
+     * - 协程在等待期间被销毁时，析构函数注销回调并取消定时器，之后到达的数据包不会访问已销毁的等待器
+     * - 必须在由 @c Client::spawn 启动的协程中使用
+     *
+     * @else
+     * @brief Waits for the next packet that satisfies a matcher
+     * @details
+     * - On suspension a callback is registered in the protocol handler table, packets are matched on the receive thread
+     *   in arrival order, so nothing is missed in sharded dispatch mode either
+     * - Request mode queues the request only after registering and carries a timeout, an expired wait yields empty
+     * - The awaiter itself is the callback capture and the timer target, suspending allocates nothing extra
+     * - If the coroutine is destroyed while waiting, the destructor unsubscribes the callback and cancels the timer,
+     *   so a packet arriving afterwards never reaches the destroyed awaiter
+     * - Must be used from a coroutine started by @c Client::spawn
+     *
+     * @endif
+     * */
+    template<has_handler_slot T, typename M, bool Timed>
+    class PacketAwaiter final : TimerTarget {
+    public:
+        using result_type = std::conditional_t<Timed, std::optional<T>, T>;
+
+        PacketAwaiter(Client& client, M matcher, EventLoop::Clock::duration timeout = {}, std::vector<std::byte> outgoing = {}, Client::SendTag outgoingTag = {});
+
+        PacketAwaiter(const PacketAwaiter&) = delete;
+
+        PacketAwaiter& operator=(const PacketAwaiter&) = delete;
+
+        ~PacketAwaiter();
+
+        [[nodiscard]] bool await_ready() const noexcept;
+
+        void await_suspend(std::coroutine_handle<> awaiting);
+
+        result_type await_resume();
+
+    private:
+        Client& client;
+
+        M matcher;
+
+        EventLoop::Clock::duration timeout;
+
+        std::vector<std::byte> outgoing;
+
+        Client::SendTag outgoingTag;
+
+        std::optional<T> result;
+
+        Subscription subscription;
+
+        EventLoop::TimerId timer = 0;
+
+        std::coroutine_handle<> handle;
+
+        void complete(const T& packet);
+
+        void expire() override;
+    };
 }  // namespace minecraft::client
 
 #include "client.hpp"
@@ -19,11 +19,9 @@
 
 #include "../protocol/package/definition.h"
 #include "logging.h"
-#include <any>
 
-#ifdef DEBUG
-    #include "../utils/debugger.h"
-#endif
+#include "../utils/tracer.h"
+#include <algorithm>
 
 namespace minecraft::client {
 
@@ -33,80 +31,377 @@ namespace minecraft::client {
         namespace svr = server_bound;
         namespace cli = client_bound;
 
-        on<svr::login_step::CompressionPacketType>([this](const auto& packet) {
+        // 协议内置处理不受分发模式影响，始终在接收线程内执行
+        hook<svr::login_step::CompressionPacketType>([this](const auto& packet) {
             if (auto t = packet.template get<"Threshold">().value(); t >= 0) {
                 compress  = true;
                 threshold = t;
             }
         });
 
-        on<svr::login_step::LoginSuccessPacketType>([this](const auto&) {
+        hook<svr::login_step::LoginSuccessPacketType>([this](const auto&) {
             state = State::PLAY;
 
             emit(cli::login_step::LoginConfirmPacketType{});
         });
 
-        on<svr::play_step::SpawnEntityPacketType>([this](const auto&) { emit(cli::configuration_step::FinishConfigurationPacketType{}); });
+        hook<svr::play_step::SpawnEntityPacketType>([this](const auto&) { emit(cli::configuration_step::FinishConfigurationPacketType{}); });
+
+        hook<svr::play_step::SynchronizePlayerPositionPacketType>([this](const auto& packet) {
+            const auto id = packet.template get<"TeleportID">().value();
+
+            latencyTracker.challenged(Challenge::TELEPORT, id, recvTime);
+
+            emit(cli::play_step::TeleportConfirmPacketType{VarInt(id)}, [this, id] { replied(Challenge::TELEPORT, id); });
+        });
+
+        hook<svr::play_step::KeepAlivePacketType>([this](const auto& packet) {
+            const auto id = packet.template get<"KeepAliveID">().value();
 
-        on<svr::play_step::SynchronizePlayerPositionPacketType>([this](const auto& packet) { emit(cli::play_step::TeleportConfirmPacketType{packet.template get<"TeleportID">()}); });
+            latencyTracker.challenged(Challenge::KEEP_ALIVE, id, recvTime);
 
-        on<svr::play_step::KeepAlivePacketType>([this](const auto& packet) { emit(cli::play_step::KeepAlivePacketType{packet.template get<"KeepAliveID">()}); });
+            emit(cli::play_step::KeepAlivePacketType{Long(id)}, [this, id] { replied(Challenge::KEEP_ALIVE, id); });
+        });
     }
 
-    template<protocol::is_package T>
-    void Client::on(std::function<void(const T&)> callback, int times) {
-        auto& vec = packageCallbacks[typeid(T)];
+    inline Client::~Client() {
+        // 先停止接收线程，再回收工作线程，保证回调不会投递到已销毁的线程池
+        cleanUp();
+
+        executor.reset();
+    }
+
+    inline void Client::setDispatchMode(const DispatchMode mode, const std::size_t workers) {
+        if (started.load()) {
+            debugPrint<"setDispatchMode must be called before start, ignored", LogLevel::WARNING>();
+
+            return;
+        }
+
+        const bool sharded = mode == DispatchMode::SHARDED;
+
+        std::apply([sharded](auto&... lists) { (lists.setConcurrent(sharded), ...); }, packageCallbacks);
+
+        executor = sharded ? std::make_unique<ShardedExecutor>(workers) : nullptr;
+    }
+
+    inline bool Client::capture(const std::string& path) {
+        captureWriter = std::make_unique<protocol::CaptureWriter>(path);
+
+        if (!captureWriter->isOpen()) {
+            debugPrint<LogLevel::WARNING>([&path] { return std::format("Cannot open capture file {}", path); });
+
+            captureWriter.reset();
+        }
 
-        vec.push_back(std::make_pair(times, [callback](const std::any& packet) { callback(std::any_cast<const T&>(packet)); }));
+        return captureWriter != nullptr;
     }
 
-    template<protocol::State S, int I>
-    void Client::on(std::function<void(const typename protocol::ServerPacketType<S, I>::type&)> callback, const int times) {
+    inline void Client::enableMetrics() {
+        if (!metricsRegistry) metricsRegistry = std::make_unique<MetricsRegistry>();
+    }
+
+    inline MetricsSnapshot Client::metrics() const { return metricsRegistry ? metricsRegistry->snapshot() : MetricsSnapshot{}; }
+
+    inline bool Client::dumpMetrics(const std::string& path) const { return metricsRegistry && metricsRegistry->dump(path); }
+
+    inline void Client::setCompressionPolicy(const protocol::CompressionPolicy& policy) {
+        if (started.load()) {
+            debugPrint<"setCompressionPolicy must be called before start, ignored", LogLevel::WARNING>();
+
+            return;
+        }
+
+        compressionPolicy = policy;
+    }
+
+    inline const protocol::CompressionStats& Client::compressionStats() const { return compressionCounters; }
+
+    inline void Client::enableChunks(const int minY, const bool keepLight) {
+        if (chunkStore) return;
+
+        namespace play = protocol::server_bound::play_step;
+
+        chunkStore = std::make_unique<world::ChunkStore>(minY, keepLight);
+
+        hook<play::ChunkDataPacketType>([this](const auto& packet) { chunkStore->apply(packet); });
+        hook<play::UpdateLightPacketType>([this](const auto& packet) { chunkStore->apply(packet); });
+        hook<play::UnloadChunkPacketType>([this](const auto& packet) { chunkStore->apply(packet); });
+        hook<play::UpdateSectionBlocksPacketType>([this](const auto& packet) { chunkStore->apply(packet); });
+    }
+
+    inline const world::ChunkStore* Client::chunks() const { return chunkStore.get(); }
+
+    inline void Client::enableEntities() {
+        if (entityTable) return;
+
+        namespace play = protocol::server_bound::play_step;
+
+        entityTable = std::make_unique<world::EntityTable>();
+
+        hook<play::SpawnEntityPacketType>([this](const auto& packet) { entityTable->apply(packet); });
+        hook<play::SpawnEntity2PacketType>([this](const auto& packet) { entityTable->apply(packet); });
+        hook<play::SpawnPlayerPacketType>([this](const auto& packet) { entityTable->apply(packet); });
+        hook<play::SpawnExperienceOrbPacketType>([this](const auto& packet) { entityTable->apply(packet); });
+        hook<play::SetEntityVelocityPacketType>([this](const auto& packet) { entityTable->apply(packet); });
+        hook<play::RemoveEntitiesPacketType>([this](const auto& packet) { entityTable->apply(packet); });
+    }
+
+    inline const world::EntityTable* Client::entities() const { return entityTable.get(); }
+
+    template<has_handler_slot T, typename F>
+    void Client::hook(F&& callback) {
+        std::get<HandlerList<T>>(protocolCallbacks).add(typename HandlerList<T>::Callback(std::forward<F>(callback)), -1);
+    }
+
+    template<has_handler_slot T, typename F>
+    Subscription Client::on(F&& callback, const int times) {
+        return std::get<HandlerList<T>>(packageCallbacks).add(typename HandlerList<T>::Callback(std::forward<F>(callback)), times);
+    }
+
+    template<protocol::State S, int I, typename F>
+    Subscription Client::on(F&& callback, const int times) {
         using T = typename protocol::ServerPacketType<S, I>::type;
 
-        on<T>(callback, times);
+        return on<T>(std::forward<F>(callback), times);
     }
 
-    template<protocol::is_package T>
-    void Client::once(std::function<void(const T&)> callback) {
-        on<T>(callback, 1);
+    template<has_handler_slot T, FStrChar V, typename F>
+    Subscription Client::on(FieldFilter<V>&& filter, F&& callback, const int times) {
+        return std::get<HandlerList<T>>(packageCallbacks).add(typename HandlerList<T>::Callback(std::forward<F>(callback)), times, PacketFilter<T>::bind(std::move(filter)));
     }
 
-    template<protocol::State S, int I>
-    void Client::once(std::function<void(const typename protocol::ServerPacketType<S, I>::type&)> callback) {
-        on<S, I>(callback, 1);
+    template<has_handler_slot T, typename F>
+    Subscription Client::once(F&& callback) {
+        return on<T>(std::forward<F>(callback), 1);
+    }
+
+    template<has_handler_slot T, FStrChar V, typename F>
+    Subscription Client::once(FieldFilter<V>&& filter, F&& callback) {
+        return on<T>(std::move(filter), std::forward<F>(callback), 1);
+    }
+
+    template<protocol::State S, int I, typename F>
+    Subscription Client::once(F&& callback) {
+        return on<S, I>(std::forward<F>(callback), 1);
     }
 
     template<protocol::is_package T>
     void Client::emit(T&& package, std::optional<std::function<void()>> callback) {
-        auto packetBytes = package.serialize(compress, threshold);
+        const bool compressed = compress.load();
+
+        auto packetBytes = package.serialize(compressed, threshold.load(), compressionPolicy, &compressionCounters);
+        const auto size  = packetBytes.size();
 
-        msgQueue.emplace(packetBytes, packetBytes.size(), callback);
+        // 数据包ID在压缩前随条目入队，发送线程统计时无需再解压；压缩模式取序列化时的值，发送前切换压缩不影响归类
+        enqueue(std::move(packetBytes), size, std::move(callback), {T::id, compressed});
     }
 
-    inline void Client::handleRecv(std::vector<std::byte>& msg, const std::size_t size) {
+    inline void Client::spawn(Task<> task) {
+        if (const auto handle = task.detach()) loop.post(handle);
+    }
+
+    template<has_handler_slot T>
+    PacketAwaiter<T, AnyPacket, false> Client::next() {
+        return {*this, AnyPacket{}};
+    }
+
+    template<has_handler_slot T, typename M>
+    PacketAwaiter<T, M, false> Client::next(M matcher) {
+        return {*this, std::move(matcher)};
+    }
+
+    template<has_handler_slot R, protocol::is_package T, typename M>
+    PacketAwaiter<R, M, true> Client::request(T&& package, M matcher, const EventLoop::Clock::duration timeout) {
+        const bool compressed = compress.load();
+
+        return {*this, std::move(matcher), timeout, package.serialize(compressed, threshold.load(), compressionPolicy, &compressionCounters), {T::id, compressed}};
+    }
+
+    inline SleepAwaiter Client::sleep(const EventLoop::Clock::duration duration) { return {loop, duration}; }
+
+    inline std::uint64_t Client::skippedBytes(const protocol::State state, const int id) const {
+        if (id < 0 || static_cast<std::size_t>(id) >= MAX_TRACKED_ID) return 0;
+
+        return skipped[static_cast<std::size_t>(state)][static_cast<std::size_t>(id)].load(std::memory_order_relaxed);
+    }
+
+    inline LatencyTracker& Client::latency() { return latencyTracker; }
+
+    inline TimelineTracker& Client::timeline() { return frameTimes; }
+
+    inline void Client::replied(const Challenge kind, const std::int64_t id) {
+        const auto latency = latencyTracker.replied(kind, id);
+
+        if (latency && *latency > latencyTracker.warnThreshold)
+            debugInfo<LogLevel::WARNING>(std::format("{} reply {} took {} ms on our side", kind == Challenge::KEEP_ALIVE ? "KeepAlive" : "Teleport", id,
+                                                     std::chrono::duration_cast<std::chrono::milliseconds>(*latency).count()));
+    }
+
+    template<protocol::is_package T>
+    bool Client::wants(const std::vector<std::byte>& data, const int id) const {
+        // 调试输出同样需要完整解码，但被分类过滤关闭的数据包不必解码
+        if (debug && logConfig.enabled<LogLevel::INFO>(static_cast<std::size_t>(state.load()), id)) return true;
+
+        if (!std::get<HandlerList<T>>(protocolCallbacks).empty()) return true;
+
+        const auto& handlers = std::get<HandlerList<T>>(packageCallbacks);
+
+        if (!handlers.allFiltered()) return !handlers.empty();
+
+        // 所有回调都带过滤条件时，先在原始字节上求值，全部不匹配则跳过解码
+        std::array<std::byte, protocol::PEEK_WINDOW> scratch;
+
+        return handlers.accepts(protocol::peekPacketBody(data, compress, scratch));
+    }
+
+    inline void Client::handleFrame(const std::vector<std::byte>& data, FrameTimeline timeline) {
         using namespace protocol;
+        using Clock = FrameTimeline::Clock;
+
+        // 指标与时间线按解码前的状态与ID归类，协议回调可能在本帧内切换状态
+        const auto frameState = timeline.state;
+        Clock::time_point decodeStart;
+
+        auto cb = [this, frameState, &timeline, &decodeStart]<is_package T>(T packet) {
+            timeline.decoded = Clock::now();
+
+            // 解码期间发生过解压时取解压完成时刻，否则解压阶段为0
+            timeline.inflated = std::clamp(protocol::detail::inflateMark, timeline.framed, timeline.decoded);
+
+            if (metricsRegistry) metricsRegistry->time(Stage::DECODE, frameState, timeline.id, timeline.decoded - decodeStart);
+
+            TraceSpan span("dispatch", timeline.id);
+
+            std::get<HandlerList<T>>(protocolCallbacks).dispatch(packet);
+
+            if (debug) {
+                int id;
+
+                if constexpr (std::is_same_v<T, Package<>>)
+                    id = packet.id();
+                else
+                    id = T::id;
+
+                packetInfo<TO_CLIENT>(static_cast<std::size_t>(frameState), id, [frameState, &packet] { return std::format("[{}] {}", enumToStr(frameState), packet); });
+            }
+
+            auto& handlers = std::get<HandlerList<T>>(packageCallbacks);
+
+            if (executor && !handlers.empty()) {
+                const auto key = ShardKey<T>::of(packet);
+
+                executor->post(key, [this, &handlers, timeline, packet = std::move(packet)] mutable {
+                    timeline.handlerStart = Clock::now();
+
+                    handlers.dispatch(packet);
+
+                    timeline.handlerEnd = Clock::now();
+
+                    frameTimes.record(timeline);
+
+                    if (metricsRegistry) metricsRegistry->time(Stage::DISPATCH, timeline.state, timeline.id, timeline.stage(FrameStage::HANDLER), false);
+                });
+
+                if (metricsRegistry) metricsRegistry->time(Stage::DISPATCH, frameState, timeline.id, Clock::now() - timeline.decoded);
+            }
 
-        auto cb = [this]<is_package T>(const T& packet) {
-            if (const auto it = packageCallbacks.find(typeid(T)); it != packageCallbacks.end())
-                for (auto& [times, callback] : it->second) {
-                    if (times != 0) callback(std::any(packet));
+            else {
+                timeline.handlerStart = Clock::now();
 
-                    if (times > 0) --times;
-                }
+                handlers.dispatch(packet);
 
-            networkInfo<TO_CLIENT>(std::format("[{}] {}", enumToStr(state), packet.toString()));
+                timeline.handlerEnd = Clock::now();
+
+                frameTimes.record(timeline);
+
+                if (metricsRegistry) metricsRegistry->time(Stage::DISPATCH, frameState, timeline.id, timeline.handlerEnd - timeline.decoded);
+            }
+        };
+
+        auto pred = [this, &data, frameState, &timeline, &decodeStart]<is_package T>(std::type_identity<T>, const int id) {
+            timeline.id = id;
+
+            // 只统计跳转表中登记了类型的ID，未登记的ID落到Package<>，不计入
+            if constexpr (!std::is_same_v<T, Package<>>)
+                if (metricsRegistry) metricsRegistry->count(Direction::INBOUND, frameState, id, data.size(), uncompressedSize(data, compress.load()));
+
+            if (wants<T>(data, id)) {
+                if (metricsRegistry) decodeStart = Clock::now();
+
+                return true;
+            }
+
+            traceEvent("skip", id);
+
+            if (id >= 0 && static_cast<std::size_t>(id) < MAX_TRACKED_ID)
+                skipped[static_cast<std::size_t>(frameState)][static_cast<std::size_t>(id)].fetch_add(data.size(), std::memory_order_relaxed);
+
+            return false;
         };
 
 #ifdef DEBUG
-        Debugger parsePacketDbg(&parsePacket<decltype(cb)>);
-        parsePacketDbg
+        // 回调抛出的异常只报告，不终止接收线程
+        try {
+            parsePacket(frameState, data, compress.load(), cb, pred);
+        } catch (const std::exception& e) {
+            traceError(e);
+        }
 #else
+        parsePacket(frameState, data, compress.load(), cb, pred);
+#endif
+    }
 
-        parsePacket
+    inline void Client::handleRecv(std::vector<std::byte>& msg, const std::size_t size) {
+        TraceSpan span("handleRecv", static_cast<std::int64_t>(size));
 
-#endif
-            (state, msg, compress, cb);
+        recvTime = LatencyTracker::Clock::now();
+
+        frameReader.feed(msg.data(), size);
+
+        // 一次接收可能包含多个帧或半个帧，逐帧处理保证状态切换及时生效
+        while (true) {
+            // 帧长度非法说明字节流已失去同步，后续数据无法再分帧，只能断开
+            try {
+                if (!frameReader.next(frame)) break;
+            } catch (const std::exception& e) {
+                debugPrint<LogLevel::CRITICAL>([&e] { return std::format("Malformed frame, closing connection: {}", e.what()); });
+
+                stop();
+                return;
+            }
+
+            const auto framed = FrameTimeline::Clock::now();
+
+            // 按帧到达时的状态记录，处理本帧可能切换状态
+            if (captureWriter) captureWriter->write(protocol::Direction::INBOUND, state.load(), compress.load(), frame);
+
+            handleFrame(frame, {.state = state.load(), .read = recvTime, .framed = framed});
+
+            // 被本帧唤醒的协程在处理下一帧前恢复，其新注册的等待不会错过后续数据包
+            loop.runReady();
+        }
+    }
+
+    inline void Client::handleSent(std::vector<std::byte>& msg, const std::size_t size, const SendTag tag, const std::chrono::steady_clock::duration queued) {
+        // 发送回调已执行，随包切换的状态（如LoginStart之后的LOGIN）此时已生效
+        const auto sentState = state.load();
+
+        // 帧格式由序列化时的压缩模式决定，发送时的开关可能已被其后收到的SetCompression切换，抓包与指标均按标记解析
+        if (captureWriter) captureWriter->write(protocol::Direction::OUTBOUND, sentState, tag.compressed, {msg.data(), size});
+
+        if (metricsRegistry) {
+            metricsRegistry->count(protocol::Direction::OUTBOUND, sentState, tag.id, size, protocol::uncompressedSize(msg, tag.compressed));
+            metricsRegistry->time(Stage::SEND_QUEUE, sentState, -1, queued);
+        }
+
+        // 与接收侧一致：受调试开关与按包分类的级别共同控制
+        if (debug) networkBytes<TO_SERVER>(static_cast<std::size_t>(sentState), tag.id, castT2Char(msg, size), size);
+    }
+
+    inline void Client::tick() {
+        loop.runTimers();
+        loop.runReady();
     }
 
     inline std::vector<std::byte> Client::castChar2T(char* msg, const std::size_t size) const {
@@ -118,20 +413,17 @@ namespace minecraft::client {
         return bytes;
     }
 
-    inline char* Client::castT2Char(std::vector<std::byte>& msg, const std::size_t size) const {
-        const auto chars = new char[size + 1];
-
-        for (std::size_t i = 0; i < size; i++) chars[i] = static_cast<char>(msg[i]);
-
-        chars[size] = '\0';
-
-        return chars;
+    inline char* Client::castT2Char(std::vector<std::byte>& msg, std::size_t) const {
+        // 直接返回数据包自身的缓冲区，每次发送不再分配（原先new出的副本从未释放）
+        return reinterpret_cast<char*>(msg.data());
     }
 
     inline void Client::start() {
         using namespace protocol;
         using namespace client_bound;
 
+        started = true;
+
         emit(handshake_step::HandShakePacketType{VarInt(765), String(ip), UShort(port), VarInt(2)});
 
         emit(login_step::LoginStartPacketType{String("edocsitahw"), UUID(genUUID<"edocsitahw">())}, [this] { state = State::LOGIN; });
@@ -139,6 +431,69 @@ namespace minecraft::client {
         ClientBase::start();
     }
 
+    template<has_handler_slot T, typename M, bool Timed>
+    PacketAwaiter<T, M, Timed>::PacketAwaiter(Client& client, M matcher, const EventLoop::Clock::duration timeout, std::vector<std::byte> outgoing, const Client::SendTag outgoingTag)
+        : client(client)
+        , matcher(std::move(matcher))
+        , timeout(timeout)
+        , outgoing(std::move(outgoing))
+        , outgoingTag(outgoingTag) {}
+
+    template<has_handler_slot T, typename M, bool Timed>
+    PacketAwaiter<T, M, Timed>::~PacketAwaiter() {
+        // 已完成或已超时时二者均为空操作
+        subscription.unsubscribe();
+
+        if constexpr (Timed) client.loop.cancel(timer);
+    }
+
+    template<has_handler_slot T, typename M, bool Timed>
+    bool PacketAwaiter<T, M, Timed>::await_ready() const noexcept {
+        return false;
+    }
+
+    template<has_handler_slot T, typename M, bool Timed>
+    void PacketAwaiter<T, M, Timed>::await_suspend(const std::coroutine_handle<> awaiting) {
+        handle = awaiting;
+
+        subscription = std::get<HandlerList<T>>(client.protocolCallbacks).add([this](const T& packet) { complete(packet); }, -1);
+
+        if constexpr (Timed) timer = client.loop.schedule(EventLoop::Clock::now() + timeout, this);
+
+        if (!outgoing.empty()) {
+            const auto size = outgoing.size();
+
+            client.enqueue(std::move(outgoing), size, std::nullopt, outgoingTag);
+        }
+    }
+
+    template<has_handler_slot T, typename M, bool Timed>
+    typename PacketAwaiter<T, M, Timed>::result_type PacketAwaiter<T, M, Timed>::await_resume() {
+        if constexpr (Timed)
+            return std::move(result);
+        else
+            return std::move(*result);
+    }
+
+    template<has_handler_slot T, typename M, bool Timed>
+    void PacketAwaiter<T, M, Timed>::complete(const T& packet) {
+        if (!matcher(packet)) return;
+
+        result.emplace(packet);
+        subscription.unsubscribe();
+
+        if constexpr (Timed) client.loop.cancel(timer);
+
+        client.loop.post(handle);
+    }
+
+    template<has_handler_slot T, typename M, bool Timed>
+    void PacketAwaiter<T, M, Timed>::expire() {
+        subscription.unsubscribe();
+
+        client.loop.post(handle);
+    }
+
 }  // namespace minecraft::client
 
 #endif  // CLIENT_HPP
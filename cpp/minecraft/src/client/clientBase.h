@@ -22,14 +22,20 @@
 
     #pragma comment(lib, "Ws2_32.lib")
 #else
+    #include <poll.h>
     #include <sys/socket.h>
 #endif
 
 #include "logging.h"
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <optional>
 #include <queue>
 #include <thread>
+#include <tuple>
 
 namespace minecraft::client {
 
@@ -37,17 +43,56 @@ namespace minecraft::client {
         void scoketInit();
 
         void socketClose(SOCKET sock);
+
+        /**
+         * @if zh
+         * @brief 等待套接字可读，至多 @p milliseconds 毫秒
+         * @details 以poll/WSAPoll等待而非 @c SO_RCVTIMEO ：Windows上recv超时后套接字状态未定义，不能继续使用
+         * @return 可读（含对端关闭与出错）时大于0，超时为0，出错小于0
+         *
+         * @else
+         * @brief Wait at most @p milliseconds for the socket to become readable
+         * @details Waits with poll/WSAPoll rather than @c SO_RCVTIMEO: on Windows a socket is in an undefined state after a recv timed out
+         * @return Greater than 0 when readable (including peer close and errors), 0 on timeout, less than 0 on failure
+         *
+         * @endif
+         * */
+        int waitReadable(SOCKET sock, int milliseconds);
     }  // namespace detail
 
+    // 等待可读的超时，保证连接空闲时接收线程仍定期调用tick
+    inline constexpr int RECV_TICK_MS = 50;
+
     template<typename T>
     class ClientBase {
     public:
+        // 调用方随条目入队的标记：数据包ID与序列化时的压缩模式，发送后按此归类，不受期间压缩开关变化影响
+        struct SendTag {
+            int id = -1;
+
+            bool compressed = false;
+        };
+
+        // 发送队列的条目：数据、长度、发送后回调、入队时刻、调用方附带的标记
+        using QueueEntry = std::tuple<T, std::size_t, std::optional<std::function<void()>>, std::chrono::steady_clock::time_point, SendTag>;
+
         ClientBase(std::string ip, short port, bool debug = false);
 
         virtual ~ClientBase();
 
         virtual void start();
 
+        /**
+         * @if zh
+         * @brief 请求停止收发线程，可在任意线程调用；阻塞中的 @c start 随后返回
+         *
+         * @else
+         * @brief Ask the receive and send threads to stop, callable from any thread; a blocked @c start returns afterwards
+         *
+         * @endif
+         * */
+        void stop();
+
         std::string ip;
 
         short port;
@@ -55,7 +100,11 @@ namespace minecraft::client {
     protected:
         SOCKET sock;
 
-        std::queue<std::tuple<T, std::size_t, std::optional<std::function<void()>>>> msgQueue;
+        std::queue<QueueEntry> msgQueue;
+
+        std::mutex queueMutex;
+
+        std::condition_variable queueReady;
 
         char recvBuf[1024 * 100];
 
@@ -69,21 +118,33 @@ namespace minecraft::client {
 
         std::thread sendThread;
 
+        // 返回msg中前size个字节的视图，不转移所有权、不保证以'\0'结尾，只在msg存活期间有效
         virtual char* castT2Char(T& msg, std::size_t size) const = 0;
 
         virtual T castChar2T(char* msg, std::size_t size) const = 0;
 
         virtual void handleRecv(T& msg, std::size_t size);
 
+        // 发送线程在数据写入套接字并执行完发送回调后调用，tag为入队时附带的标记，queued为数据在发送队列中的停留时间
+        virtual void handleSent(T& msg, std::size_t size, SendTag tag, std::chrono::steady_clock::duration queued);
+
+        // 接收线程每轮循环调用一次（包括等待超时时），用于驱动定时任务
+        virtual void tick() {}
+
         void recvLoop();
 
         void sendLoop();
 
+        void enqueue(T msg, std::size_t size, std::optional<std::function<void()>> callback, SendTag tag = {});
+
         void raiseError(const char* msg);
 
         template<LogLevel L = LogLevel::INFO>
         void debugPrint(std::string msg) const;
 
+        template<LogLevel L = LogLevel::INFO, lazy_message F>
+        void debugPrint(F&& msg) const;
+
         template<FStrChar S, LogLevel L = LogLevel::INFO>
         void debugPrint() const;
 
@@ -21,6 +21,7 @@
     #include <ws2tcpip.h>
 #endif
 
+#include <cerrno>
 #include <iostream>
 #include <thread>
 
@@ -46,6 +47,19 @@ namespace minecraft::client {
 
             if (GLOBAL_WSA_COUNT == 0) WSACleanup();
         }
+
+        inline int waitReadable(const SOCKET sock, const int milliseconds) {
+            pollfd fd{sock, POLLIN, 0};
+
+#ifdef _WIN32
+            return WSAPoll(&fd, 1, milliseconds);
+#else
+            const int ready = poll(&fd, 1, milliseconds);
+
+            // 被信号打断按超时处理，下一轮重新等待
+            return ready < 0 && errno == EINTR ? 0 : ready;
+#endif
+        }
     }  // namespace detail
 
     template<typename T>
@@ -62,7 +76,8 @@ namespace minecraft::client {
         hints.ai_family   = AF_INET;      // IPv4
         hints.ai_socktype = SOCK_STREAM;  // TCP
 
-        std::string portStr = std::to_string(port);
+        // 端口以short保存，高于32767的临时端口按无符号数解释
+        std::string portStr = std::to_string(static_cast<unsigned short>(port));
 
         int status = getaddrinfo(this->ip.c_str(), portStr.c_str(), &hints, &res);
         if (status != 0) raiseError("Host resolution failed");
@@ -76,6 +91,8 @@ namespace minecraft::client {
         // 连接服务器
         if (connect(sock, res->ai_addr, res->ai_addrlen) == SOCKET_ERROR) raiseError("Connection failed");
 
+        freeaddrinfo(res);
+
         debugPrint<"Connected to server successfully">();
     }
 
@@ -99,9 +116,16 @@ namespace minecraft::client {
         debugPrint<"Send thread joined">();
     }
 
+    template<typename T>
+    void ClientBase<T>::stop() {
+        stopFlag = true;
+
+        queueReady.notify_all();
+    }
+
     template<typename T>
     void ClientBase<T>::raiseError(const char* msg) {
-        debugPrint<LogLevel::CRITICAL>(std::format("{}: {}", msg, WSAGetLastError()));
+        debugPrint<LogLevel::CRITICAL>([msg] { return std::format("{}: {}", msg, WSAGetLastError()); });
 
         cleanUp();
         exit(1);
@@ -112,20 +136,31 @@ namespace minecraft::client {
         debugPrint<"Receive thread started">();
 
         while (!stopFlag) {
+            const int ready = detail::waitReadable(sock, RECV_TICK_MS);
+
+            if (ready < 0) raiseError("Wait for data failed");
+
+            if (ready == 0) {
+                tick();
+                continue;
+            }
+
             int len = recv(sock, recvBuf, sizeof(recvBuf), 0);
 
-            if (len == SOCKET_ERROR)
-                raiseError("Receive failed");
+            if (len == SOCKET_ERROR) raiseError("Receive failed");
 
-            else if (len == 0)
+            // 对端关闭连接时一并结束发送线程，否则start永不返回
+            if (len == 0) {
+                stop();
                 break;
+            }
 
             auto msg = castChar2T(recvBuf, len);
 
             handleRecv(msg, len);
 
-            // 防止CPU占用过高，休眠50毫秒
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            // 等待本身带超时阻塞，无需额外休眠；休眠会直接推迟下一批数据的处理
+            tick();
         }
     }
 
@@ -134,31 +169,46 @@ namespace minecraft::client {
         debugPrint<"Send thread started">();
 
         while (!stopFlag) {
-            if (!msgQueue.empty()) {
-                auto [msg, size, callback] = msgQueue.front();
+            std::unique_lock lock(queueMutex);
 
-                msgQueue.pop();
+            // 入队时立即唤醒；空闲时定期醒来检查停止标志
+            if (!queueReady.wait_for(lock, std::chrono::milliseconds(RECV_TICK_MS), [this] { return !msgQueue.empty(); })) continue;
 
-                auto buffer = castT2Char(msg, size);
+            auto [msg, size, callback, queuedAt, tag] = std::move(msgQueue.front());
 
-                if (send(sock, buffer, size, 0) == SOCKET_ERROR) raiseError("Send failed");
+            msgQueue.pop();
+            lock.unlock();
 
-                if (callback.has_value()) callback->operator()();
+            auto buffer = castT2Char(msg, size);
 
-                std::string hexMsg;
-                for (std::size_t i = 0; i < size; i++) hexMsg += std::format("\\0x{:02x} ", static_cast<unsigned char>(buffer[i]));
+            if (send(sock, buffer, size, 0) == SOCKET_ERROR) raiseError("Send failed");
 
-                networkInfo<TO_SERVER>(hexMsg);
-            }
+            if (callback.has_value()) callback->operator()();
 
-            // 防止CPU占用过高，休眠100毫秒
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            handleSent(msg, size, tag, std::chrono::steady_clock::now() - queuedAt);
         }
     }
 
+    template<typename T>
+    void ClientBase<T>::handleSent(T& msg, const std::size_t size, SendTag, std::chrono::steady_clock::duration) {
+        if (debug) networkBytes<TO_SERVER>(castT2Char(msg, size), size);
+    }
+
+    template<typename T>
+    void ClientBase<T>::enqueue(T msg, const std::size_t size, std::optional<std::function<void()>> callback, const SendTag tag) {
+        // 工作线程中的回调同样可能发送数据包
+        {
+            std::lock_guard lock(queueMutex);
+
+            msgQueue.emplace(std::move(msg), size, std::move(callback), std::chrono::steady_clock::now(), tag);
+        }
+
+        queueReady.notify_one();
+    }
+
     template<typename T>
     void ClientBase<T>::handleRecv(T& msg, const size_t size) {
-        networkInfo<TO_CLIENT>(castT2Char(msg, size));
+        networkInfo<TO_CLIENT>(std::string(castT2Char(msg, size), size));
     }
 
     template<typename T>
@@ -167,6 +217,13 @@ namespace minecraft::client {
         if (debug) debugInfo<L>(msg);
     }
 
+    template<typename T>
+    template<LogLevel L, lazy_message F>
+    void ClientBase<T>::debugPrint(F&& msg) const {
+        // 先判断开关与级别，关闭时不构造消息
+        if (debug && logConfig.enabled<L>()) debugInfo<L>(std::forward<F>(msg)());
+    }
+
     template<typename T>
     template<FStrChar S, LogLevel L>
     void ClientBase<T>::debugPrint() const {
@@ -0,0 +1,255 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file coroutine.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 17:30
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef COROUTINE_H
+#define COROUTINE_H
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace minecraft::client {
+
+    template<typename T = void>
+    class Task;
+
+    namespace detail {
+        template<typename T>
+        struct TaskPromiseBase {
+            std::coroutine_handle<> continuation;
+
+            std::exception_ptr exception;
+
+            bool detached = false;
+
+            struct FinalAwaiter {
+                [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+                template<typename P>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept;
+
+                void await_resume() const noexcept {}
+            };
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+
+            void unhandled_exception() { exception = std::current_exception(); }
+        };
+
+        template<typename T>
+        struct TaskPromise : TaskPromiseBase<T> {
+            std::optional<T> value;
+
+            Task<T> get_return_object();
+
+            template<typename U>
+            void return_value(U&& v) {
+                value.emplace(std::forward<U>(v));
+            }
+        };
+
+        template<>
+        struct TaskPromise<void> : TaskPromiseBase<void> {
+            Task<> get_return_object();
+
+            void return_void() {}
+        };
+    }  // namespace detail
+
+    /** @class Task
+     *
+     * @if zh
+     * @brief 惰性启动的协程任务
+     * @details
+     * - 被 @c co_await 时才开始执行，结束时以对称转移恢复等待者，不经过调度队列
+     * - 交给 @c Client::spawn 后由连接的事件循环启动，并在结束时自行销毁协程帧
+     *
+     * @else
+     * @brief Lazily started coroutine task
+     * @details
+     * - Starts when it is @c co_await -ed and resumes the awaiter through symmetric transfer on completion, bypassing the ready queue
+     * - Handed to @c Client::spawn it is started by the connection's event loop and frees its own frame when it finishes
+     *
+     * @endif
+     * */
+    template<typename T>
+    class Task {
+    public:
+        using promise_type = detail::TaskPromise<T>;
+
+        Task() = default;
+
+        Task(Task&& other) noexcept;
+
+        Task& operator=(Task&& other) noexcept;
+
+        Task(const Task&) = delete;
+
+        Task& operator=(const Task&) = delete;
+
+        ~Task();
+
+        [[nodiscard]] bool await_ready() const noexcept;
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept;
+
+        T await_resume();
+
+        // 转交协程帧的所有权，结束时自行销毁
+        std::coroutine_handle<> detach();
+
+    private:
+        friend promise_type;
+
+        explicit Task(std::coroutine_handle<promise_type> handle);
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    /** @struct TimerTarget
+     *
+     * @if zh
+     * @brief 定时器到期时被通知的对象，通常是挂起中的等待器本身
+     *
+     * @else
+     * @brief Object notified when a timer expires, usually the suspended awaiter itself
+     *
+     * @endif
+     * */
+    struct TimerTarget {
+        virtual void expire() = 0;
+
+    protected:
+        ~TimerTarget() = default;
+    };
+
+    /** @class EventLoop
+     *
+     * @if zh
+     * @brief 连接的协程调度器，由接收线程驱动
+     * @details
+     * - 就绪队列可从任意线程投递，只在接收线程中恢复协程
+     * - 定时器为带位置索引的最小堆加带代数的槽位，取消时立即从堆中移除，为O(log n)，堆中只有仍在等待的定时器
+     * - 队列、堆与槽位均复用容量，稳定运行后挂起与恢复不再分配
+     *
+     * @else
+     * @brief Coroutine scheduler of a connection, driven by the receive thread
+     * @details
+     * - The ready queue may be posted to from any thread, coroutines are only resumed on the receive thread
+     * - Timers are a position-indexed min-heap plus generation-tagged slots, cancelling removes the entry from the heap at once in O(log n),
+     *   so the heap only holds timers that are still pending
+     * - The queue, heap and slots keep their capacity, so suspending and resuming do not allocate once warmed up
+     *
+     * @endif
+     * */
+    class EventLoop {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        using TimerId = std::uint64_t;
+
+        void post(std::coroutine_handle<> handle);
+
+        TimerId schedule(Clock::time_point deadline, TimerTarget* target);
+
+        void cancel(TimerId id);
+
+        void runTimers(Clock::time_point now = Clock::now());
+
+        void runReady();
+
+        [[nodiscard]] std::size_t pendingTimers() const;
+
+    private:
+        struct TimerSlot {
+            TimerTarget* target = nullptr;
+
+            // 代数从1开始，ID为0永远无效，未调度的等待器可安全地取消0
+            std::uint32_t generation = 1;
+
+            // 该定时器在堆中的下标，堆调整时同步更新
+            std::uint32_t position = 0;
+        };
+
+        struct TimerEntry {
+            Clock::time_point deadline;
+
+            std::uint32_t slot;
+        };
+
+        std::mutex readyMutex;
+
+        std::vector<std::coroutine_handle<>> ready;
+
+        std::vector<std::coroutine_handle<>> running;
+
+        std::vector<TimerSlot> slots;
+
+        std::vector<std::uint32_t> freeSlots;
+
+        std::vector<TimerEntry> heap;
+
+        void place(std::size_t index, TimerEntry entry);
+
+        void siftUp(std::size_t index);
+
+        void siftDown(std::size_t index);
+
+        // 移除堆中下标为index的条目并释放其槽位，返回其目标
+        TimerTarget* remove(std::size_t index);
+    };
+
+    /** @class SleepAwaiter
+     *
+     * @if zh
+     * @brief 在事件循环上挂起指定时长
+     *
+     * @else
+     * @brief Suspends for a duration on the event loop
+     *
+     * @endif
+     * */
+    class SleepAwaiter final : TimerTarget {
+    public:
+        SleepAwaiter(EventLoop& loop, EventLoop::Clock::duration duration);
+
+        [[nodiscard]] bool await_ready() const noexcept;
+
+        void await_suspend(std::coroutine_handle<> awaiting);
+
+        void await_resume() const noexcept {}
+
+    private:
+        EventLoop& loop;
+
+        EventLoop::Clock::duration duration;
+
+        std::coroutine_handle<> handle;
+
+        void expire() override;
+    };
+
+}  // namespace minecraft::client
+
+#include "coroutine.hpp"
+
+#endif  // COROUTINE_H
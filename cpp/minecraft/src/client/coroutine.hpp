@@ -0,0 +1,251 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file coroutine.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 17:30
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef COROUTINE_HPP
+#define COROUTINE_HPP
+#pragma once
+
+#include "logging.h"
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace minecraft::client {
+
+    namespace detail {
+        template<typename T>
+        template<typename P>
+        std::coroutine_handle<> TaskPromiseBase<T>::FinalAwaiter::await_suspend(std::coroutine_handle<P> handle) noexcept {
+            auto& promise = handle.promise();
+
+            if (promise.continuation) return promise.continuation;
+
+            if (promise.detached) {
+                if (promise.exception) {
+                    try {
+                        std::rethrow_exception(promise.exception);
+                    }
+
+                    catch (const std::exception& e) {
+                        debugInfo<LogLevel::CRITICAL>(std::format("Detached task threw: {}", e.what()));
+                    }
+
+                    catch (...) {
+                        debugInfo<"Detached task threw a non-standard exception", LogLevel::CRITICAL>();
+                    }
+                }
+
+                handle.destroy();
+            }
+
+            return std::noop_coroutine();
+        }
+
+        template<typename T>
+        Task<T> TaskPromise<T>::get_return_object() {
+            return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+        }
+
+        inline Task<> TaskPromise<void>::get_return_object() { return Task<>(std::coroutine_handle<TaskPromise>::from_promise(*this)); }
+    }  // namespace detail
+
+    template<typename T>
+    Task<T>::Task(std::coroutine_handle<promise_type> handle)
+        : handle(handle) {}
+
+    template<typename T>
+    Task<T>::Task(Task&& other) noexcept
+        : handle(std::exchange(other.handle, nullptr)) {}
+
+    template<typename T>
+    Task<T>& Task<T>::operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+
+            handle = std::exchange(other.handle, nullptr);
+        }
+
+        return *this;
+    }
+
+    template<typename T>
+    Task<T>::~Task() {
+        if (handle) handle.destroy();
+    }
+
+    template<typename T>
+    bool Task<T>::await_ready() const noexcept {
+        return !handle || handle.done();
+    }
+
+    template<typename T>
+    std::coroutine_handle<> Task<T>::await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+
+        return handle;
+    }
+
+    template<typename T>
+    T Task<T>::await_resume() {
+        auto& promise = handle.promise();
+
+        if (promise.exception) std::rethrow_exception(promise.exception);
+
+        if constexpr (!std::is_void_v<T>) return std::move(*promise.value);
+    }
+
+    template<typename T>
+    std::coroutine_handle<> Task<T>::detach() {
+        if (!handle) return nullptr;
+
+        handle.promise().detached = true;
+
+        return std::exchange(handle, nullptr);
+    }
+
+    inline void EventLoop::post(const std::coroutine_handle<> handle) {
+        std::lock_guard lock(readyMutex);
+
+        ready.push_back(handle);
+    }
+
+    inline void EventLoop::place(const std::size_t index, const TimerEntry entry) {
+        heap[index]                = entry;
+        slots[entry.slot].position = static_cast<std::uint32_t>(index);
+    }
+
+    inline void EventLoop::siftUp(std::size_t index) {
+        const auto entry = heap[index];
+
+        while (index > 0) {
+            const auto parent = (index - 1) / 2;
+
+            if (heap[parent].deadline <= entry.deadline) break;
+
+            place(index, heap[parent]);
+            index = parent;
+        }
+
+        place(index, entry);
+    }
+
+    inline void EventLoop::siftDown(std::size_t index) {
+        const auto entry = heap[index];
+
+        while (true) {
+            auto child = index * 2 + 1;
+
+            if (child >= heap.size()) break;
+
+            if (child + 1 < heap.size() && heap[child + 1].deadline < heap[child].deadline) ++child;
+
+            if (entry.deadline <= heap[child].deadline) break;
+
+            place(index, heap[child]);
+            index = child;
+        }
+
+        place(index, entry);
+    }
+
+    inline TimerTarget* EventLoop::remove(const std::size_t index) {
+        const auto slot = heap[index].slot;
+        const auto last = heap.back();
+
+        heap.pop_back();
+
+        // 末尾条目填入空位，再按其与父节点的大小关系上浮或下沉
+        if (index < heap.size()) {
+            place(index, last);
+
+            if (index > 0 && last.deadline < heap[(index - 1) / 2].deadline)
+                siftUp(index);
+            else
+                siftDown(index);
+        }
+
+        const auto target = std::exchange(slots[slot].target, nullptr);
+        ++slots[slot].generation;
+        freeSlots.push_back(slot);
+
+        return target;
+    }
+
+    inline EventLoop::TimerId EventLoop::schedule(const Clock::time_point deadline, TimerTarget* target) {
+        std::uint32_t slot;
+
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+
+        else {
+            slot = static_cast<std::uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+
+        slots[slot].target = target;
+
+        heap.push_back({deadline, slot});
+        siftUp(heap.size() - 1);
+
+        return static_cast<TimerId>(slots[slot].generation) << 32 | slot;
+    }
+
+    inline void EventLoop::cancel(const TimerId id) {
+        const auto slot       = static_cast<std::uint32_t>(id);
+        const auto generation = static_cast<std::uint32_t>(id >> 32);
+
+        if (slot >= slots.size() || slots[slot].generation != generation || !slots[slot].target) return;
+
+        remove(slots[slot].position);
+    }
+
+    inline void EventLoop::runTimers(const Clock::time_point now) {
+        while (!heap.empty() && heap.front().deadline <= now) remove(0)->expire();
+    }
+
+    inline void EventLoop::runReady() {
+        {
+            std::lock_guard lock(readyMutex);
+
+            running.swap(ready);
+        }
+
+        // 恢复的协程可能再次投递，新投递的在下一轮执行
+        for (const auto handle : running) handle.resume();
+
+        running.clear();
+    }
+
+    inline std::size_t EventLoop::pendingTimers() const { return heap.size(); }
+
+    inline SleepAwaiter::SleepAwaiter(EventLoop& loop, const EventLoop::Clock::duration duration)
+        : loop(loop)
+        , duration(duration) {}
+
+    inline bool SleepAwaiter::await_ready() const noexcept { return duration <= EventLoop::Clock::duration::zero(); }
+
+    inline void SleepAwaiter::await_suspend(const std::coroutine_handle<> awaiting) {
+        handle = awaiting;
+
+        loop.schedule(EventLoop::Clock::now() + duration, this);
+    }
+
+    inline void SleepAwaiter::expire() { loop.post(handle); }
+
+}  // namespace minecraft::client
+
+#endif  // COROUTINE_HPP
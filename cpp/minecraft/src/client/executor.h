@@ -0,0 +1,112 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file executor.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 15:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+#pragma once
+
+#include "../protocol/package/package.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace minecraft::client {
+
+    /** @class ShardedExecutor
+     *
+     * @if zh
+     * @brief 按键分片的工作线程池
+     * @details
+     * - 每个分片一个工作线程与一个FIFO队列，同一键的任务总是落在同一分片，因此按提交顺序执行
+     * - 不同分片之间没有顺序保证
+     * - 析构时执行完已提交的任务后再回收线程
+     *
+     * @else
+     * @brief Worker pool sharded by key
+     * @details
+     * - Every shard owns one worker thread and one FIFO queue; tasks with the same key always land on the same shard
+     *   and therefore run in submission order
+     * - There is no ordering between shards
+     * - The destructor drains submitted tasks before joining the workers
+     *
+     * @endif
+     * */
+    class ShardedExecutor {
+    public:
+        using Task = std::move_only_function<void()>;
+
+        explicit ShardedExecutor(std::size_t shards);
+
+        ShardedExecutor(const ShardedExecutor&) = delete;
+
+        ShardedExecutor& operator=(const ShardedExecutor&) = delete;
+
+        ~ShardedExecutor();
+
+        void post(std::uint64_t key, Task&& task);
+
+        [[nodiscard]] std::size_t shards() const;
+
+    private:
+        struct Shard {
+            std::mutex mutex;
+
+            std::condition_variable cv;
+
+            std::deque<Task> tasks;
+
+            bool stop = false;
+
+            std::thread worker;
+        };
+
+        std::vector<std::unique_ptr<Shard>> shards_;
+
+        static void run(Shard& shard);
+    };
+
+    /** @struct ShardKey
+     *
+     * @if zh
+     * @brief 数据包的分片键
+     * @details 默认取 @c EntityID 字段，没有该字段的数据包返回0（全部落在0号分片并保持相互顺序）；可对具体类型特化以改变分片方式
+     *
+     * @else
+     * @brief Shard key of a packet
+     * @details Uses the @c EntityID field by default; packets without it return 0 (they all land on shard 0 and keep
+     * their relative order). Specialize for a concrete type to change how it is sharded
+     *
+     * @endif
+     * */
+    template<protocol::is_package T>
+    struct ShardKey {
+        static std::uint64_t of(const T& packet);
+    };
+
+    template<>
+    struct ShardKey<protocol::Package<>> {
+        static std::uint64_t of(const protocol::Package<>& packet);
+    };
+
+}  // namespace minecraft::client
+
+#include "executor.hpp"
+
+#endif  // EXECUTOR_H
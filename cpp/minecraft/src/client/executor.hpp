@@ -0,0 +1,102 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file executor.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 15:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef EXECUTOR_HPP
+#define EXECUTOR_HPP
+#pragma once
+
+#include "logging.h"
+#include <algorithm>
+#include <exception>
+
+namespace minecraft::client {
+
+    inline ShardedExecutor::ShardedExecutor(const std::size_t shards) {
+        shards_.reserve(std::max<std::size_t>(shards, 1));
+
+        for (std::size_t i = 0; i < std::max<std::size_t>(shards, 1); ++i) {
+            auto& shard  = *shards_.emplace_back(std::make_unique<Shard>());
+            shard.worker = std::thread(&ShardedExecutor::run, std::ref(shard));
+        }
+    }
+
+    inline ShardedExecutor::~ShardedExecutor() {
+        for (const auto& shard : shards_) {
+            {
+                std::lock_guard lock(shard->mutex);
+                shard->stop = true;
+            }
+
+            shard->cv.notify_one();
+        }
+
+        for (const auto& shard : shards_)
+            if (shard->worker.joinable()) shard->worker.join();
+    }
+
+    inline void ShardedExecutor::post(const std::uint64_t key, Task&& task) {
+        auto& shard = *shards_[key % shards_.size()];
+
+        {
+            std::lock_guard lock(shard.mutex);
+            shard.tasks.push_back(std::move(task));
+        }
+
+        shard.cv.notify_one();
+    }
+
+    inline std::size_t ShardedExecutor::shards() const { return shards_.size(); }
+
+    inline void ShardedExecutor::run(Shard& shard) {
+        std::deque<Task> batch;
+
+        while (true) {
+            {
+                std::unique_lock lock(shard.mutex);
+                shard.cv.wait(lock, [&shard] { return shard.stop || !shard.tasks.empty(); });
+
+                if (shard.tasks.empty()) return;
+
+                // 整批取出，执行期间不持锁，接收线程投递不会被慢回调阻塞
+                batch.swap(shard.tasks);
+            }
+
+            for (auto& task : batch) {
+                try {
+                    task();
+                }
+
+                catch (const std::exception& e) {
+                    debugInfo<LogLevel::CRITICAL>(std::format("Handler threw: {}", e.what()));
+                }
+            }
+
+            batch.clear();
+        }
+    }
+
+    template<protocol::is_package T>
+    std::uint64_t ShardKey<T>::of(const T& packet) {
+        if constexpr (T::template hasField<"EntityID">())
+            return static_cast<std::uint64_t>(static_cast<std::uint32_t>(packet.template get<"EntityID">().value()));
+        else
+            return 0;
+    }
+
+    inline std::uint64_t ShardKey<protocol::Package<>>::of(const protocol::Package<>&) { return 0; }
+
+}  // namespace minecraft::client
+
+#endif  // EXECUTOR_HPP
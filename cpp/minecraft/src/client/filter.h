@@ -0,0 +1,126 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file filter.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 16:35
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef FILTER_H
+#define FILTER_H
+#pragma once
+
+#include "../protocol/package/layout.h"
+#include "../utils/inlineFunction.h"
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+namespace minecraft::client {
+
+    using FilterTest = InlineFunction<bool(std::int64_t), 48>;
+
+    /** @class FieldFilter
+     *
+     * @if zh
+     * @brief 针对单个整数类字段的过滤条件，由 @c where 构造
+     *
+     * @else
+     * @brief Condition on a single integer-like field, built with @c where
+     *
+     * @endif
+     * */
+    template<FStrChar V>
+    class FieldFilter {
+    public:
+        static constexpr auto name = V;
+
+        explicit FieldFilter(FilterTest&& test);
+
+        FilterTest test;
+    };
+
+    /** @struct Where
+     *
+     * @if zh
+     * @brief 字段过滤条件构造器
+     * @details 例如 @c where<"EntityID">.in({1,2,3})
+     *
+     * @else
+     * @brief Builder of field conditions
+     * @details For example @c where<"EntityID">.in({1,2,3})
+     *
+     * @endif
+     * */
+    template<FStrChar V>
+    struct Where {
+        [[nodiscard]] FieldFilter<V> in(std::initializer_list<std::int64_t> values) const;
+
+        [[nodiscard]] FieldFilter<V> in(std::vector<std::int64_t> values) const;
+
+        [[nodiscard]] FieldFilter<V> equals(std::int64_t value) const;
+
+        [[nodiscard]] FieldFilter<V> between(std::int64_t min, std::int64_t max) const;
+
+        template<typename F>
+        [[nodiscard]] FieldFilter<V> matches(F&& predicate) const;
+    };
+
+    template<FStrChar V>
+    inline constexpr Where<V> where{};
+
+    /** @struct PacketFilter
+     *
+     * @if zh
+     * @brief 绑定到具体数据包类型的字段过滤条件
+     * @details
+     * - 解码前在原始字段字节上求值，字段位置由 @c FieldLayout 在编译期确定；无法判断（字节被截断）时视为通过
+     * - 解码后再按解码出的字段值求值，决定具体回调是否执行
+     *
+     * @else
+     * @brief Field condition bound to a concrete packet type
+     * @details
+     * - Before decoding it is evaluated on the raw field bytes, the field position is resolved at compile time by
+     *   @c FieldLayout; undecidable cases (truncated bytes) pass
+     * - After decoding it is evaluated on the decoded field value to decide whether a given callback runs
+     *
+     * @endif
+     * */
+    template<protocol::is_package T>
+    struct PacketFilter {
+        using Raw = std::optional<std::int64_t> (*)(std::span<const std::byte>);
+
+        using Decoded = std::int64_t (*)(const T&);
+
+        PacketFilter() = default;
+
+        template<FStrChar V>
+        static PacketFilter bind(FieldFilter<V>&& filter);
+
+        explicit operator bool() const;
+
+        [[nodiscard]] bool matches(std::span<const std::byte> body) const;
+
+        [[nodiscard]] bool matches(const T& packet) const;
+
+    private:
+        Raw raw = nullptr;
+
+        Decoded decoded = nullptr;
+
+        FilterTest test;
+    };
+
+}  // namespace minecraft::client
+
+#include "filter.hpp"
+
+#endif  // FILTER_H
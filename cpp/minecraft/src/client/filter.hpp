@@ -0,0 +1,89 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file filter.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 16:35
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef FILTER_HPP
+#define FILTER_HPP
+#pragma once
+
+#include <algorithm>
+
+namespace minecraft::client {
+
+    template<FStrChar V>
+    FieldFilter<V>::FieldFilter(FilterTest&& test)
+        : test(std::move(test)) {}
+
+    template<FStrChar V>
+    FieldFilter<V> Where<V>::in(std::initializer_list<std::int64_t> values) const {
+        return in(std::vector<std::int64_t>(values));
+    }
+
+    template<FStrChar V>
+    FieldFilter<V> Where<V>::in(std::vector<std::int64_t> values) const {
+        std::ranges::sort(values);
+
+        return FieldFilter<V>([values = std::move(values)](const std::int64_t value) { return std::ranges::binary_search(values, value); });
+    }
+
+    template<FStrChar V>
+    FieldFilter<V> Where<V>::equals(const std::int64_t value) const {
+        return FieldFilter<V>([value](const std::int64_t v) { return v == value; });
+    }
+
+    template<FStrChar V>
+    FieldFilter<V> Where<V>::between(const std::int64_t min, const std::int64_t max) const {
+        return FieldFilter<V>([min, max](const std::int64_t v) { return min <= v && v <= max; });
+    }
+
+    template<FStrChar V>
+    template<typename F>
+    FieldFilter<V> Where<V>::matches(F&& predicate) const {
+        return FieldFilter<V>(std::forward<F>(predicate));
+    }
+
+    template<protocol::is_package T>
+    template<FStrChar V>
+    PacketFilter<T> PacketFilter<T>::bind(FieldFilter<V>&& filter) {
+        static_assert(protocol::FieldLayout<V, T>::readable, "Field is missing, not integer-like, or preceded by a field that cannot be skipped on raw bytes");
+
+        PacketFilter result;
+
+        result.raw     = &protocol::FieldLayout<V, T>::read;
+        result.decoded = [](const T& packet) { return static_cast<std::int64_t>(packet.template get<V>().value()); };
+        result.test    = std::move(filter.test);
+
+        return result;
+    }
+
+    template<protocol::is_package T>
+    PacketFilter<T>::operator bool() const {
+        return raw != nullptr;
+    }
+
+    template<protocol::is_package T>
+    bool PacketFilter<T>::matches(std::span<const std::byte> body) const {
+        const auto value = raw(body);
+
+        return !value || test(*value);
+    }
+
+    template<protocol::is_package T>
+    bool PacketFilter<T>::matches(const T& packet) const {
+        return test(decoded(packet));
+    }
+
+}  // namespace minecraft::client
+
+#endif  // FILTER_HPP
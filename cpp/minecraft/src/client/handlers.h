@@ -0,0 +1,255 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file handlers.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 13:41
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef HANDLERS_H
+#define HANDLERS_H
+#pragma once
+
+#include "../protocol/package/definition.h"
+#include "../utils/inlineFunction.h"
+#include "filter.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace minecraft::client {
+
+    class HandlerListBase;
+
+    /** @class Subscription
+     *
+     * @if zh
+     * @brief 回调注册令牌
+     * @details 由 @c Client::on / @c Client::once 返回，@c unsubscribe 为O(1)；令牌不得比其所属的 @c Client 存活更久
+     *
+     * @else
+     * @brief Handler registration token
+     * @details Returned by @c Client::on / @c Client::once, @c unsubscribe is O(1); a token must not outlive its @c Client
+     *
+     * @endif
+     * */
+    class Subscription {
+    public:
+        Subscription() = default;
+
+        void unsubscribe();
+
+        [[nodiscard]] bool active() const;
+
+    private:
+        friend class HandlerListBase;
+
+        Subscription(HandlerListBase* list, std::uint32_t index, std::uint32_t generation);
+
+        HandlerListBase* list = nullptr;
+
+        std::uint32_t index = 0;
+
+        std::uint32_t generation = 0;
+    };
+
+    /** @class HandlerListBase
+     *
+     * @if zh
+     * @brief 回调列表的生命周期簿记
+     * @details
+     * - 槽位带代数，令牌失效判断与注销均为O(1)
+     * - 到期（times归零）或注销的条目只做标记，在分发结束后统一从分发顺序中压缩移除，槽位随后复用
+     * - 注册与注销可在回调执行期间进行；回调抛出异常时分发照常退出，锁与压缩状态不受影响
+     * - 开启并发模式后簿记由互斥锁保护，回调本身在锁外执行，多个线程可同时分发同一列表
+     *
+     * @else
+     * @brief Lifecycle bookkeeping of a callback list
+     * @details
+     * - Slots carry a generation, so validating a token and unsubscribing are O(1)
+     * - Expired (times reached 0) or unsubscribed entries are only marked, then compacted out of the dispatch order
+     *   once dispatch finishes, and their slots are reused
+     * - Registering and unsubscribing are allowed while callbacks run; when a callback throws the dispatch still exits cleanly,
+     *   lock and compaction state are unaffected
+     * - In concurrent mode the bookkeeping is guarded by a mutex while callbacks run outside of it, so several threads
+     *   may dispatch the same list at once
+     *
+     * @endif
+     * */
+    class HandlerListBase {
+    public:
+        HandlerListBase() = default;
+
+        HandlerListBase(const HandlerListBase&) = delete;
+
+        HandlerListBase& operator=(const HandlerListBase&) = delete;
+
+        virtual ~HandlerListBase() = default;
+
+        [[nodiscard]] bool empty() const;
+
+        [[nodiscard]] std::size_t size() const;
+
+        void setConcurrent(bool enabled);
+
+        [[nodiscard]] bool allFiltered() const;
+
+    protected:
+        struct Meta {
+            int times = 0;
+
+            std::uint32_t generation = 0;
+
+            bool alive = false;
+
+            bool filtered = false;
+        };
+
+        std::deque<Meta> metas;
+
+        std::vector<std::uint32_t> order;
+
+        std::vector<std::uint32_t> freeSlots;
+
+        std::atomic<std::size_t> live = 0;
+
+        std::atomic<std::size_t> filtered = 0;
+
+        std::size_t dead = 0;
+
+        int depth = 0;
+
+        bool concurrent = false;
+
+        mutable std::mutex mutex;
+
+        [[nodiscard]] std::unique_lock<std::mutex> guard() const;
+
+        /** @class DispatchScope
+         *
+         * @if zh
+         * @brief 一轮分发的作用域：构造时进入分发，析构时（包括回调抛出异常时）重新加锁、退出分发并压缩失效条目
+         *
+         * @else
+         * @brief Scope of one dispatch round: entering on construction, and on destruction (including when a callback throws)
+         * re-acquiring the lock, leaving the dispatch and compacting dead entries
+         *
+         * @endif
+         * */
+        class DispatchScope {
+        public:
+            DispatchScope(HandlerListBase& list, std::unique_lock<std::mutex>& lock);
+
+            DispatchScope(const DispatchScope&) = delete;
+
+            DispatchScope& operator=(const DispatchScope&) = delete;
+
+            ~DispatchScope();
+
+        private:
+            HandlerListBase& list;
+
+            std::unique_lock<std::mutex>& lock;
+
+            bool locking;
+        };
+
+        std::pair<std::uint32_t, bool> acquire(int times, bool withFilter);
+
+        Subscription token(std::uint32_t index);
+
+        void retire(std::uint32_t index);
+
+        void compact();
+
+        virtual void release(std::uint32_t index) = 0;
+
+    private:
+        friend class Subscription;
+
+        void unsubscribe(std::uint32_t index, std::uint32_t generation);
+
+        [[nodiscard]] bool active(std::uint32_t index, std::uint32_t generation) const;
+    };
+
+    /** @class HandlerList
+     *
+     * @if zh
+     * @brief 单一数据包类型的回调列表
+     * @details 回调以 @c InlineFunction 形式存放，分发时每个回调仅一次间接调用；使用deque保证回调执行期间注册新回调不会移动已有回调。
+     * 回调可附带 @c PacketFilter，@c accepts 在解码前用原始字节对其求值
+     * @note 注册优先复用已释放的槽位，此时不分配；回调数超过历史最大值时deque会分配新块，捕获超过内联容量的回调也会分配一次
+     *
+     * @else
+     * @brief Callback list of a single packet type
+     * @details Callbacks are stored as @c InlineFunction, dispatch costs one indirect call per callback;
+     * a deque keeps existing callbacks in place when new ones are registered from inside a callback.
+     * A callback may carry a @c PacketFilter, @c accepts evaluates those on raw bytes before decoding
+     * @note Registering reuses released slots first and then does not allocate; growing past the previous maximum number of callbacks
+     * makes the deques allocate a new block, and a callback whose capture exceeds the inline capacity is allocated once as well
+     *
+     * @endif
+     * */
+    template<protocol::is_package T>
+    class HandlerList final : public HandlerListBase {
+    public:
+        using Callback = InlineFunction<void(const T&)>;
+
+        Subscription add(Callback&& callback, int times, PacketFilter<T>&& filter = {});
+
+        [[nodiscard]] bool accepts(std::span<const std::byte> body) const;
+
+        void dispatch(const T& packet);
+
+    private:
+        std::deque<Callback> callbacks;
+
+        std::deque<PacketFilter<T>> filters;
+
+        void release(std::uint32_t index) override;
+    };
+
+    namespace detail {
+        template<typename L>
+        struct HandlerTableOf;
+
+        template<protocol::is_package... Ps>
+        struct HandlerTableOf<protocol::PacketList<Ps...>> {
+            using type = std::tuple<HandlerList<Ps>..., HandlerList<protocol::Package<>>>;
+
+            template<typename T>
+            static constexpr bool contains = (std::is_same_v<T, Ps> || ...) || std::is_same_v<T, protocol::Package<>>;
+        };
+
+        using ServerHandlerTableOf = HandlerTableOf<protocol::AllPacketList<protocol::ServerPacketList>>;
+    }  // namespace detail
+
+    /**
+     * @if zh
+     * @brief 所有服务端数据包类型（含未知包）的回调槽位表，槽位在编译期按类型确定
+     *
+     * @else
+     * @brief Callback slots for every server packet type (plus the unknown package), slots are resolved by type at compile time
+     *
+     * @endif
+     * */
+    using HandlerTable = detail::ServerHandlerTableOf::type;
+
+    template<typename T>
+    concept has_handler_slot = protocol::is_package<T> && detail::ServerHandlerTableOf::contains<T>;
+
+}  // namespace minecraft::client
+
+#include "handlers.hpp"
+
+#endif  // HANDLERS_H
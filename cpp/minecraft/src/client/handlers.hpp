@@ -0,0 +1,211 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file handlers.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 13:41
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef HANDLERS_HPP
+#define HANDLERS_HPP
+#pragma once
+
+#include <algorithm>
+
+namespace minecraft::client {
+
+    inline Subscription::Subscription(HandlerListBase* list, const std::uint32_t index, const std::uint32_t generation)
+        : list(list)
+        , index(index)
+        , generation(generation) {}
+
+    inline void Subscription::unsubscribe() {
+        if (list) list->unsubscribe(index, generation);
+
+        list = nullptr;
+    }
+
+    inline bool Subscription::active() const { return list && list->active(index, generation); }
+
+    inline bool HandlerListBase::empty() const { return live.load(std::memory_order_relaxed) == 0; }
+
+    inline std::size_t HandlerListBase::size() const { return live.load(std::memory_order_relaxed); }
+
+    inline bool HandlerListBase::allFiltered() const {
+        const auto count = live.load(std::memory_order_relaxed);
+
+        return count != 0 && filtered.load(std::memory_order_relaxed) == count;
+    }
+
+    inline void HandlerListBase::setConcurrent(const bool enabled) { concurrent = enabled; }
+
+    inline std::unique_lock<std::mutex> HandlerListBase::guard() const {
+        // 单线程模式不加锁，保持分发路径无同步开销
+        return concurrent ? std::unique_lock(mutex) : std::unique_lock(mutex, std::defer_lock);
+    }
+
+    inline HandlerListBase::DispatchScope::DispatchScope(HandlerListBase& list, std::unique_lock<std::mutex>& lock)
+        : list(list)
+        , lock(lock)
+        , locking(lock.owns_lock()) {
+        ++list.depth;
+    }
+
+    inline HandlerListBase::DispatchScope::~DispatchScope() {
+        // 回调在锁外执行，异常可能在解锁期间抛出
+        if (locking && !lock.owns_lock()) lock.lock();
+
+        if (--list.depth == 0 && list.dead) list.compact();
+    }
+
+    inline std::pair<std::uint32_t, bool> HandlerListBase::acquire(const int times, const bool withFilter) {
+        std::uint32_t index;
+        bool reused = !freeSlots.empty();
+
+        if (reused) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        }
+
+        else {
+            index = static_cast<std::uint32_t>(metas.size());
+            metas.emplace_back();
+        }
+
+        auto& meta    = metas[index];
+        meta.times    = times;
+        meta.alive    = true;
+        meta.filtered = withFilter;
+
+        order.push_back(index);
+        ++live;
+
+        if (withFilter) ++filtered;
+
+        return {index, reused};
+    }
+
+    inline Subscription HandlerListBase::token(const std::uint32_t index) { return {this, index, metas[index].generation}; }
+
+    inline void HandlerListBase::retire(const std::uint32_t index) {
+        auto& meta = metas[index];
+
+        meta.alive = false;
+        ++meta.generation;
+
+        --live;
+        ++dead;
+
+        if (meta.filtered) --filtered;
+    }
+
+    inline void HandlerListBase::compact() {
+        std::erase_if(order, [this](const std::uint32_t index) {
+            if (metas[index].alive) return false;
+
+            release(index);
+            freeSlots.push_back(index);
+
+            return true;
+        });
+
+        dead = 0;
+    }
+
+    inline void HandlerListBase::unsubscribe(const std::uint32_t index, const std::uint32_t generation) {
+        auto lock = guard();
+
+        if (index >= metas.size() || !metas[index].alive || metas[index].generation != generation) return;
+
+        retire(index);
+
+        // 分发期间由分发结束时压缩；否则在失效条目过半时压缩，均摊O(1)
+        if (depth == 0 && dead * 2 > order.size()) compact();
+    }
+
+    inline bool HandlerListBase::active(const std::uint32_t index, const std::uint32_t generation) const {
+        auto lock = guard();
+
+        return index < metas.size() && metas[index].alive && metas[index].generation == generation;
+    }
+
+    template<protocol::is_package T>
+    Subscription HandlerList<T>::add(Callback&& callback, const int times, PacketFilter<T>&& filter) {
+        if (times == 0) return {};
+
+        auto lock = guard();
+
+        const auto [index, reused] = acquire(times, static_cast<bool>(filter));
+
+        if (reused) {
+            callbacks[index] = std::move(callback);
+            filters[index]   = std::move(filter);
+        }
+
+        else {
+            callbacks.push_back(std::move(callback));
+            filters.push_back(std::move(filter));
+        }
+
+        return token(index);
+    }
+
+    template<protocol::is_package T>
+    bool HandlerList<T>::accepts(std::span<const std::byte> body) const {
+        auto lock = guard();
+
+        for (const auto index : order)
+            if (metas[index].alive && (!filters[index] || filters[index].matches(body))) return true;
+
+        return false;
+    }
+
+    template<protocol::is_package T>
+    void HandlerList<T>::dispatch(const T& packet) {
+        auto lock = guard();
+
+        // 回调抛出异常时同样退出分发，否则深度永不归零，失效条目再也不会被压缩
+        const DispatchScope scope(*this, lock);
+
+        // 回调中可能注册新回调，只分发本轮开始时已存在的条目
+        for (std::size_t i = 0, n = order.size(); i < n; ++i) {
+            const auto index = order[i];
+            auto& meta       = metas[index];
+
+            if (!meta.alive) continue;
+
+            if (meta.filtered && !filters[index].matches(packet)) continue;
+
+            // 到期条目先标记，回调对象在压缩前保持有效
+            if (meta.times > 0 && --meta.times == 0) retire(index);
+
+            // deque的引用在追加时保持有效，回调对象只在无分发进行时才被释放
+            auto& callback = callbacks[index];
+
+            if (lock.owns_lock()) {
+                lock.unlock();
+                callback(packet);
+                lock.lock();
+            }
+
+            else
+                callback(packet);
+        }
+    }
+
+    template<protocol::is_package T>
+    void HandlerList<T>::release(const std::uint32_t index) {
+        callbacks[index] = Callback{};
+        filters[index]   = PacketFilter<T>{};
+    }
+
+}  // namespace minecraft::client
+
+#endif  // HANDLERS_HPP
@@ -0,0 +1,145 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file latency.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 18:20
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef LATENCY_H
+#define LATENCY_H
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace minecraft::client {
+
+    /** @struct LatencySummary
+     *
+     * @if zh
+     * @brief 滚动窗口内的延迟分位数
+     *
+     * @else
+     * @brief Latency percentiles over a rolling window
+     *
+     * @endif
+     * */
+    struct LatencySummary {
+        std::uint64_t count = 0;
+
+        std::chrono::nanoseconds p50{0};
+
+        std::chrono::nanoseconds p90{0};
+
+        std::chrono::nanoseconds p99{0};
+
+        std::chrono::nanoseconds max{0};
+    };
+
+    /** @class RollingWindow
+     *
+     * @if zh
+     * @brief 固定容量的延迟样本环，新样本覆盖最旧样本
+     *
+     * @else
+     * @brief Fixed-capacity ring of latency samples, new samples overwrite the oldest
+     *
+     * @endif
+     * */
+    class RollingWindow {
+    public:
+        explicit RollingWindow(std::size_t capacity = 256);
+
+        void add(std::chrono::nanoseconds sample);
+
+        [[nodiscard]] LatencySummary summary() const;
+
+    private:
+        mutable std::mutex mutex;
+
+        std::vector<std::int64_t> samples;
+
+        std::size_t capacity;
+
+        std::size_t next = 0;
+
+        std::uint64_t total = 0;
+    };
+
+    enum class Challenge { KEEP_ALIVE, TELEPORT };
+
+    /** @class LatencyTracker
+     *
+     * @if zh
+     * @brief 服务端质询（KeepAlive、传送）与客户端应答的关联与计时
+     * @details
+     * - 应答延迟：从收到质询所在的数据到应答写入套接字为止，即本端处理造成的全部延迟
+     * - KeepAlive到达延迟：原版服务端以毫秒时间戳作为KeepAliveID，到达时刻减去ID得到“时钟偏差+单向延迟”，
+     *   减去观测到的最小值即为服务端到客户端的排队延迟；ID明显不是时间戳时不计入
+     * - @c replied 返回本次应答延迟，超过 @c warnThreshold 时由 @c Client 发出警告，提示正在逼近服务端超时
+     *
+     * @else
+     * @brief Correlates server challenges (KeepAlive, teleport) with the client's replies and times them
+     * @details
+     * - Reply latency: from receiving the bytes holding the challenge until the reply is written to the socket,
+     *   i.e. all of the delay added on our side
+     * - KeepAlive arrival delay: vanilla servers use a millisecond timestamp as KeepAliveID, the arrival time minus
+     *   the id is "clock offset + one-way delay", minus the smallest value seen it is the server-to-client queueing delay;
+     *   ids that are clearly not timestamps are ignored
+     * - @c replied returns the latency of this reply, @c Client warns when it exceeds @c warnThreshold, a sign of drifting toward server timeouts
+     *
+     * @endif
+     * */
+    class LatencyTracker {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        std::chrono::nanoseconds warnThreshold = std::chrono::seconds(1);
+
+        void challenged(Challenge kind, std::int64_t id, Clock::time_point received);
+
+        std::optional<std::chrono::nanoseconds> replied(Challenge kind, std::int64_t id, Clock::time_point sent = Clock::now());
+
+        [[nodiscard]] LatencySummary replyLatency(Challenge kind) const;
+
+        [[nodiscard]] LatencySummary keepAliveDelay() const;
+
+    private:
+        static constexpr std::size_t MAX_PENDING = 64;
+
+        struct Pending {
+            Challenge kind;
+
+            std::int64_t id;
+
+            Clock::time_point received;
+        };
+
+        mutable std::mutex mutex;
+
+        std::vector<Pending> pending;
+
+        std::optional<std::int64_t> minOffset;
+
+        std::array<RollingWindow, 2> replies;
+
+        RollingWindow arrival;
+    };
+
+}  // namespace minecraft::client
+
+#include "latency.hpp"
+
+#endif  // LATENCY_H
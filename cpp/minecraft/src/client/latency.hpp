@@ -0,0 +1,114 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file latency.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 18:20
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef LATENCY_HPP
+#define LATENCY_HPP
+#pragma once
+
+#include <algorithm>
+
+namespace minecraft::client {
+
+    inline RollingWindow::RollingWindow(const std::size_t capacity)
+        : capacity(std::max<std::size_t>(capacity, 1)) {
+        samples.reserve(this->capacity);
+    }
+
+    inline void RollingWindow::add(const std::chrono::nanoseconds sample) {
+        std::lock_guard lock(mutex);
+
+        if (samples.size() < capacity)
+            samples.push_back(sample.count());
+        else
+            samples[next] = sample.count();
+
+        next = (next + 1) % capacity;
+        ++total;
+    }
+
+    inline LatencySummary RollingWindow::summary() const {
+        std::vector<std::int64_t> sorted;
+        LatencySummary result;
+
+        {
+            std::lock_guard lock(mutex);
+
+            sorted       = samples;
+            result.count = total;
+        }
+
+        if (sorted.empty()) return result;
+
+        std::ranges::sort(sorted);
+
+        const auto at = [&sorted](const double q) { return std::chrono::nanoseconds(sorted[static_cast<std::size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5)]); };
+
+        result.p50 = at(0.50);
+        result.p90 = at(0.90);
+        result.p99 = at(0.99);
+        result.max = std::chrono::nanoseconds(sorted.back());
+
+        return result;
+    }
+
+    inline void LatencyTracker::challenged(const Challenge kind, const std::int64_t id, const Clock::time_point received) {
+        std::lock_guard lock(mutex);
+
+        // 应答丢失时不让待关联表无限增长
+        if (pending.size() >= MAX_PENDING) pending.erase(pending.begin());
+
+        pending.push_back({kind, id, received});
+
+        if (kind != Challenge::KEEP_ALIVE) return;
+
+        const auto now    = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        const auto offset = now - id;
+
+        // 偏差超过一天说明ID不是毫秒时间戳
+        if (offset < -86'400'000 || offset > 86'400'000) return;
+
+        if (!minOffset || offset < *minOffset) minOffset = offset;
+
+        arrival.add(std::chrono::milliseconds(offset - *minOffset));
+    }
+
+    inline std::optional<std::chrono::nanoseconds> LatencyTracker::replied(const Challenge kind, const std::int64_t id, const Clock::time_point sent) {
+        Clock::time_point received;
+
+        {
+            std::lock_guard lock(mutex);
+
+            const auto it = std::ranges::find_if(pending, [kind, id](const Pending& p) { return p.kind == kind && p.id == id; });
+
+            if (it == pending.end()) return std::nullopt;
+
+            received = it->received;
+            pending.erase(it);
+        }
+
+        const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(sent - received);
+
+        replies[static_cast<std::size_t>(kind)].add(latency);
+
+        return latency;
+    }
+
+    inline LatencySummary LatencyTracker::replyLatency(const Challenge kind) const { return replies[static_cast<std::size_t>(kind)].summary(); }
+
+    inline LatencySummary LatencyTracker::keepAliveDelay() const { return arrival.summary(); }
+
+}  // namespace minecraft::client
+
+#endif  // LATENCY_HPP
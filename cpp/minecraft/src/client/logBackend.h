@@ -0,0 +1,203 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file logBackend.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 19:05
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef LOGBACKEND_H
+#define LOGBACKEND_H
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace minecraft {
+
+    enum class LogLevel { INFO, WARNING, CRITICAL };
+
+    enum NetDest { TO_SERVER, TO_CLIENT };
+
+    namespace detail {
+        enum class RecordKind : std::uint8_t { GENERAL, NETWORK_TEXT, NETWORK_BYTES };
+
+        /** @struct LogRecord
+         *
+         * @if zh
+         * @brief 定长二进制日志记录
+         * @details
+         * - 负载超出一个槽位时占用连续的多个槽位，后续槽位只使用 @c payload ，首个槽位的 @c parts 记录总槽位数
+         * - 至多占用 @c MAX_PARTS 个槽位，更长的负载被截断，输出时带截断标记与原始长度
+         *
+         * @else
+         * @brief Fixed-size binary log record
+         * @details
+         * - A payload larger than one slot spans consecutive slots, the following slots only use @c payload and
+         *   @c parts of the first slot holds the slot count
+         * - At most @c MAX_PARTS slots are used, longer payloads are cut and printed with a truncation marker and the original length
+         *
+         * @endif
+         * */
+        struct LogRecord {
+            static constexpr std::size_t PAYLOAD = 232;
+
+            static constexpr std::size_t MAX_PARTS = 16;
+
+            std::int64_t time;
+
+            // 原始长度与实际保存的长度，前者大于后者即为截断
+            std::uint32_t size;
+
+            std::uint16_t length;
+
+            LogLevel level;
+
+            RecordKind kind;
+
+            std::uint8_t parts;
+
+            NetDest dest;
+
+            std::array<char, PAYLOAD> payload;
+        };
+
+        /** @class LogRing
+         *
+         * @if zh
+         * @brief 单生产者单消费者无锁环形缓冲区，每个写日志的线程独占一个
+         * @details 写满（剩余槽位不足以放下整条记录）时丢弃新记录并计数，写入方从不阻塞
+         *
+         * @else
+         * @brief Single-producer single-consumer lock-free ring, one per logging thread
+         * @details When full (too few free slots for the whole record) new records are dropped and counted, the writer never blocks
+         *
+         * @endif
+         * */
+        class LogRing {
+        public:
+            static constexpr std::size_t CAPACITY = 512;
+
+            static_assert(LogRecord::MAX_PARTS * LogRecord::PAYLOAD <= UINT16_MAX, "Record length must fit in its length field");
+
+            bool push(LogLevel level, RecordKind kind, NetDest dest, const char* data, std::size_t size);
+
+            // 回调参数为首个槽位与拼接后的完整负载
+            template<typename F>
+            std::size_t drain(F&& f);
+
+            [[nodiscard]] bool empty() const;
+
+            std::atomic<std::uint64_t> dropped{0};
+
+        private:
+            static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two");
+
+            std::array<LogRecord, CAPACITY> slots;
+
+            // 跨槽位记录的拼接缓冲区，只由后台线程使用
+            std::string joined;
+
+            alignas(64) std::atomic<std::uint64_t> head{0};
+
+            alignas(64) std::atomic<std::uint64_t> tail{0};
+        };
+    }  // namespace detail
+
+    /** @class LogBackend
+     *
+     * @if zh
+     * @brief 异步日志后端
+     * @details
+     * - 各线程首次写日志时登记自己的环形缓冲区，此后写入无锁
+     * - 后台线程排空所有缓冲区，格式化后整批写出并只在批末刷新一次；无记录时在条件变量上休眠，
+     *   写入方只在其休眠时才加锁唤醒（eventcount），空闲时不再周期性醒来
+     * - 线程退出后其缓冲区在排空后回收；进程退出时析构函数排空所有缓冲区
+     *
+     * @else
+     * @brief Asynchronous logging backend
+     * @details
+     * - Each thread registers its ring on its first log call, writes are lock-free from then on
+     * - A background thread drains every ring, formats the records and writes them out in batches, flushing once per batch;
+     *   with nothing to write it parks on a condition variable and writers only lock to wake it while it is parked (an eventcount),
+     *   so it no longer wakes up periodically when idle
+     * - Rings of finished threads are reclaimed once drained; the destructor drains every ring at process exit
+     *
+     * @endif
+     * */
+    class LogBackend {
+    public:
+        static LogBackend& instance();
+
+        LogBackend(const LogBackend&) = delete;
+
+        LogBackend& operator=(const LogBackend&) = delete;
+
+        ~LogBackend();
+
+        detail::LogRing& ring();
+
+        // 写入当前线程的缓冲区，后台线程休眠时将其唤醒
+        bool write(LogLevel level, detail::RecordKind kind, NetDest dest, const char* data, std::size_t size);
+
+        // 阻塞至调用时已写入的记录全部输出
+        void flush();
+
+        [[nodiscard]] std::uint64_t dropped() const;
+
+    private:
+        LogBackend();
+
+        mutable std::mutex ringsMutex;
+
+        std::vector<std::shared_ptr<detail::LogRing>> rings;
+
+        std::atomic<std::uint64_t> retiredDrops{0};
+
+        std::atomic_bool stopFlag{false};
+
+        std::atomic<std::uint64_t> passes{0};
+
+        std::mutex parkMutex;
+
+        std::condition_variable wake;
+
+        std::atomic_bool parked{false};
+
+        std::thread worker;
+
+        void run();
+
+        void park();
+
+        void unpark();
+
+        [[nodiscard]] bool pending() const;
+
+        bool drainAll(std::string& out, std::string& err);
+    };
+
+    void flushLogs();
+
+    std::uint64_t droppedLogRecords();
+
+}  // namespace minecraft
+
+#include "logBackend.hpp"
+
+#endif  // LOGBACKEND_H
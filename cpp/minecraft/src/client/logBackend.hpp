@@ -0,0 +1,266 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file logBackend.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 19:05
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef LOGBACKEND_HPP
+#define LOGBACKEND_HPP
+#pragma once
+
+#include "../utils/utils.h"
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <iostream>
+
+namespace minecraft {
+
+    namespace detail {
+        inline bool LogRing::push(const LogLevel level, const RecordKind kind, const NetDest dest, const char* data, const std::size_t size) {
+            const auto t      = tail.load(std::memory_order_relaxed);
+            const auto length = std::min(size, LogRecord::MAX_PARTS * LogRecord::PAYLOAD);
+            const auto parts  = std::max<std::size_t>(1, (length + LogRecord::PAYLOAD - 1) / LogRecord::PAYLOAD);
+
+            // 整条记录放不下时整体丢弃，不写入半条
+            if (CAPACITY - (t - head.load(std::memory_order_acquire)) < parts) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+
+                return false;
+            }
+
+            auto& record  = slots[t & (CAPACITY - 1)];
+            record.time   = std::chrono::system_clock::now().time_since_epoch().count();
+            record.size   = static_cast<std::uint32_t>(size);
+            record.length = static_cast<std::uint16_t>(length);
+            record.level  = level;
+            record.kind   = kind;
+            record.parts  = static_cast<std::uint8_t>(parts);
+            record.dest   = dest;
+
+            for (std::size_t i = 0, offset = 0; i < parts; ++i, offset += LogRecord::PAYLOAD)
+                std::memcpy(slots[(t + i) & (CAPACITY - 1)].payload.data(), data + offset, std::min(LogRecord::PAYLOAD, length - offset));
+
+            tail.store(t + parts, std::memory_order_release);
+
+            return true;
+        }
+
+        template<typename F>
+        std::size_t LogRing::drain(F&& f) {
+            auto h       = head.load(std::memory_order_relaxed);
+            const auto t = tail.load(std::memory_order_acquire);
+
+            std::size_t count = 0;
+
+            for (; h != t; ++count) {
+                const auto& record = slots[h & (CAPACITY - 1)];
+
+                if (record.parts == 1)
+                    f(record, std::string_view(record.payload.data(), record.length));
+
+                else {
+                    joined.clear();
+
+                    for (std::size_t i = 0, offset = 0; i < record.parts; ++i, offset += LogRecord::PAYLOAD)
+                        joined.append(slots[(h + i) & (CAPACITY - 1)].payload.data(), std::min<std::size_t>(LogRecord::PAYLOAD, record.length - offset));
+
+                    f(record, std::string_view(joined));
+                }
+
+                h += record.parts;
+            }
+
+            head.store(t, std::memory_order_release);
+
+            return count;
+        }
+
+        inline bool LogRing::empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+        inline void formatRecord(const LogRecord& record, const std::string_view payload, std::string& out) {
+            out += '[';
+            out += enumToStr(record.level);
+            out += ']';
+
+            switch (record.kind) {
+                using enum RecordKind;
+                case GENERAL:
+                    out += " -- : ";
+                    out += payload;
+                    break;
+
+                case NETWORK_TEXT:
+                    out += record.dest == TO_SERVER ? " C -> S: " : " C <- S: ";
+                    out += payload;
+                    break;
+
+                case NETWORK_BYTES:
+                    out += record.dest == TO_SERVER ? " C -> S: " : " C <- S: ";
+
+                    for (const auto c : payload) std::format_to(std::back_inserter(out), "\\0x{:02x} ", static_cast<unsigned char>(c));
+
+                    break;
+            }
+
+            if (record.size > record.length) std::format_to(std::back_inserter(out), "... [truncated, {} of {} bytes shown]", record.length, record.size);
+
+            out += '\n';
+        }
+    }  // namespace detail
+
+    inline LogBackend& LogBackend::instance() {
+        static LogBackend backend;
+
+        return backend;
+    }
+
+    inline LogBackend::LogBackend()
+        : worker(&LogBackend::run, this) {}
+
+    inline LogBackend::~LogBackend() {
+        stopFlag = true;
+
+        unpark();
+
+        if (worker.joinable()) worker.join();
+    }
+
+    inline detail::LogRing& LogBackend::ring() {
+        // 缓冲区由线程与后端共同持有，线程退出后仍可被排空
+        thread_local std::shared_ptr<detail::LogRing> local = [this] {
+            auto created = std::make_shared<detail::LogRing>();
+
+            std::lock_guard lock(ringsMutex);
+            rings.push_back(created);
+
+            return created;
+        }();
+
+        return *local;
+    }
+
+    inline bool LogBackend::write(const LogLevel level, const detail::RecordKind kind, const NetDest dest, const char* data, const std::size_t size) {
+        const bool written = ring().push(level, kind, dest, data, size);
+
+        // 与park中的栅栏配对：要么后台线程看到本条记录，要么这里看到其已休眠
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (written && parked.load(std::memory_order_relaxed)) unpark();
+
+        return written;
+    }
+
+    inline void LogBackend::flush() {
+        // 等待后台线程完整地再排空两遍，保证调用前写入的记录已输出；后台线程可能正在休眠，每轮都唤醒
+        const auto target = passes.load(std::memory_order_acquire) + 2;
+
+        while (passes.load(std::memory_order_acquire) < target && worker.joinable()) {
+            unpark();
+
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    inline std::uint64_t LogBackend::dropped() const {
+        std::lock_guard lock(ringsMutex);
+
+        auto total = retiredDrops.load(std::memory_order_relaxed);
+
+        for (const auto& ring : rings) total += ring->dropped.load(std::memory_order_relaxed);
+
+        return total;
+    }
+
+    inline bool LogBackend::drainAll(std::string& out, std::string& err) {
+        std::size_t drained = 0;
+
+        std::lock_guard lock(ringsMutex);
+
+        for (const auto& ring : rings)
+            drained += ring->drain([&out, &err](const detail::LogRecord& record, const std::string_view payload) {
+                detail::formatRecord(record, payload, record.level == LogLevel::CRITICAL ? err : out);
+            });
+
+        // 所属线程已退出且已排空的缓冲区
+        std::erase_if(rings, [this](const std::shared_ptr<detail::LogRing>& ring) {
+            if (ring.use_count() > 1 || !ring->empty()) return false;
+
+            retiredDrops.fetch_add(ring->dropped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+            return true;
+        });
+
+        return drained > 0;
+    }
+
+    inline void LogBackend::run() {
+        std::string out, err;
+
+        while (true) {
+            const bool stopping = stopFlag.load(std::memory_order_acquire);
+            const bool drained  = drainAll(out, err);
+
+            if (!out.empty()) {
+                std::cout.write(out.data(), static_cast<std::streamsize>(out.size())).flush();
+                out.clear();
+            }
+
+            if (!err.empty()) {
+                std::cerr.write(err.data(), static_cast<std::streamsize>(err.size())).flush();
+                err.clear();
+            }
+
+            passes.fetch_add(1, std::memory_order_release);
+
+            if (stopping && !drained) return;
+
+            if (!drained) park();
+        }
+    }
+
+    inline bool LogBackend::pending() const {
+        std::lock_guard lock(ringsMutex);
+
+        return std::ranges::any_of(rings, [](const std::shared_ptr<detail::LogRing>& ring) { return !ring->empty(); });
+    }
+
+    inline void LogBackend::park() {
+        std::unique_lock lock(parkMutex);
+
+        parked.store(true, std::memory_order_relaxed);
+
+        // 先声明休眠再检查，与write中的栅栏配对，不会错过休眠前一刻写入的记录
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (!pending() && !stopFlag.load(std::memory_order_acquire)) wake.wait(lock, [this] { return !parked.load(std::memory_order_relaxed); });
+
+        parked.store(false, std::memory_order_relaxed);
+    }
+
+    inline void LogBackend::unpark() {
+        {
+            std::lock_guard lock(parkMutex);
+
+            parked.store(false, std::memory_order_relaxed);
+        }
+
+        wake.notify_one();
+    }
+
+    inline void flushLogs() { LogBackend::instance().flush(); }
+
+    inline std::uint64_t droppedLogRecords() { return LogBackend::instance().dropped(); }
+
+}  // namespace minecraft
+
+#endif  // LOGBACKEND_HPP
@@ -18,22 +18,100 @@
 #pragma once
 
 #include "../utils/fstr.h"
+#include "logBackend.h"
+#include <concepts>
 #include <string>
+#include <string_view>
 
 namespace minecraft {
-    enum class LogLevel { INFO, WARNING, CRITICAL };
 
-    enum NetDest { TO_SERVER, TO_CLIENT };
+    /** @class LogConfig
+     *
+     * @if zh
+     * @brief 运行时日志级别与分类过滤
+     * @details
+     * - 分类为（类别, 数据包ID），客户端以连接状态作为类别
+     * - 每个分类的生效阈值（全局级别与分类开关合并后）预先计算，判断是否输出只需一次加载与一次比较
+     * - 修改配置的线程之间互斥，读取无锁
+     *
+     * @else
+     * @brief Runtime log level and category filters
+     * @details
+     * - A category is (group, packet id), the client uses the connection state as the group
+     * - The effective threshold of every category (global level merged with the category switch) is precomputed,
+     *   so deciding whether to log is one load and one compare
+     * - Writers are serialized, readers are lock-free
+     *
+     * @endif
+     * */
+    class LogConfig {
+    public:
+        static constexpr std::size_t MAX_GROUPS = 8;
+
+        static constexpr std::size_t MAX_IDS = 256;
+
+        LogConfig();
+
+        void setLevel(LogLevel level);
+
+        [[nodiscard]] LogLevel level() const;
+
+        void enableGroup(std::size_t group, bool enabled);
+
+        void enablePacket(std::size_t group, int id, bool enabled);
+
+        template<LogLevel L>
+        [[nodiscard]] bool enabled() const;
+
+        template<LogLevel L>
+        [[nodiscard]] bool enabled(std::size_t group, int id) const;
+
+    private:
+        static constexpr std::uint8_t OFF = 0xFF;
+
+        std::mutex mutex;
+
+        std::atomic<std::uint8_t> threshold;
+
+        std::array<bool, MAX_GROUPS * MAX_IDS> disabled{};
+
+        std::array<std::atomic<std::uint8_t>, MAX_GROUPS * MAX_IDS> thresholds;
+
+        void refresh(std::size_t index);
+    };
+
+    inline LogConfig logConfig{};
+
+    // 惰性消息：只有确定输出时才调用以生成字符串
+    template<typename F>
+    concept lazy_message = std::invocable<F> && std::convertible_to<std::invoke_result_t<F>, std::string_view>;
 
     template<NetDest D, LogLevel L = LogLevel::INFO>
     void networkInfo(std::string message);
 
+    template<NetDest D, LogLevel L = LogLevel::INFO, lazy_message F>
+    void networkInfo(F&& message);
+
+    template<NetDest D, LogLevel L = LogLevel::INFO, lazy_message F>
+    void packetInfo(std::size_t group, int id, F&& message);
+
+    // 以原始字节记录，十六进制格式化在后台线程完成
+    template<NetDest D, LogLevel L = LogLevel::INFO>
+    void networkBytes(const char* data, std::size_t size);
+
+    // 同上，但按数据包分类的级别过滤
+    template<NetDest D, LogLevel L = LogLevel::INFO>
+    void networkBytes(std::size_t group, int id, const char* data, std::size_t size);
+
     template<FStrChar S, NetDest D, LogLevel L = LogLevel::INFO>
     void networkInfo();
 
     template<LogLevel L = LogLevel::INFO>
     void debugInfo(std::string message);
 
+    template<LogLevel L = LogLevel::INFO, lazy_message F>
+    void debugInfo(F&& message);
+
     template<FStrChar S, LogLevel L = LogLevel::INFO>
     void debugInfo();
 }  // namespace minecraft
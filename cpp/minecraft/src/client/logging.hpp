@@ -17,43 +17,115 @@
 #define LOGGING_HPP
 #pragma once
 
-#include "../utils/utils.h"
 #include <format>
-#include <iostream>
 
 namespace minecraft {
+    inline LogConfig::LogConfig()
+        : threshold(static_cast<std::uint8_t>(LogLevel::INFO)) {
+        for (auto& t : thresholds) t.store(static_cast<std::uint8_t>(LogLevel::INFO), std::memory_order_relaxed);
+    }
+
+    inline void LogConfig::setLevel(const LogLevel level) {
+        std::lock_guard lock(mutex);
+
+        threshold.store(static_cast<std::uint8_t>(level), std::memory_order_relaxed);
+
+        for (std::size_t i = 0; i < thresholds.size(); ++i) refresh(i);
+    }
+
+    inline LogLevel LogConfig::level() const { return static_cast<LogLevel>(threshold.load(std::memory_order_relaxed)); }
+
+    inline void LogConfig::enableGroup(const std::size_t group, const bool enabled) {
+        if (group >= MAX_GROUPS) return;
+
+        std::lock_guard lock(mutex);
+
+        for (std::size_t i = group * MAX_IDS; i < (group + 1) * MAX_IDS; ++i) {
+            disabled[i] = !enabled;
+            refresh(i);
+        }
+    }
+
+    inline void LogConfig::enablePacket(const std::size_t group, const int id, const bool enabled) {
+        if (group >= MAX_GROUPS || id < 0 || static_cast<std::size_t>(id) >= MAX_IDS) return;
+
+        std::lock_guard lock(mutex);
+
+        const auto index = group * MAX_IDS + static_cast<std::size_t>(id);
+
+        disabled[index] = !enabled;
+        refresh(index);
+    }
+
+    template<LogLevel L>
+    bool LogConfig::enabled() const {
+        return static_cast<std::uint8_t>(L) >= threshold.load(std::memory_order_relaxed);
+    }
+
+    template<LogLevel L>
+    bool LogConfig::enabled(const std::size_t group, const int id) const {
+        const auto index = group * MAX_IDS + static_cast<std::size_t>(id);
+
+        // 超出分类表的ID退回全局级别
+        const auto& cell = group < MAX_GROUPS && static_cast<std::size_t>(id) < MAX_IDS ? thresholds[index] : threshold;
+
+        return static_cast<std::uint8_t>(L) >= cell.load(std::memory_order_relaxed);
+    }
+
+    inline void LogConfig::refresh(const std::size_t index) {
+        thresholds[index].store(disabled[index] ? OFF : threshold.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
     namespace detail {
         template<LogLevel L>
-        void infoCore(std::string message) {
-            switch (L) {
-                using enum LogLevel;
-                case INFO:
-                case WARNING: std::cout << '[' << enumToStr(L) << ']' << message << std::endl; break;
-                case CRITICAL: std::cerr << '[' << enumToStr(L) << ']' << message << std::endl; break;
-            }
+        void infoCore(const RecordKind kind, const NetDest dest, const std::string_view message) {
+            LogBackend::instance().write(L, kind, dest, message.data(), message.size());
         }
     }  // namespace detail
 
     template<NetDest D, LogLevel L>
     void networkInfo(std::string message) {
-        auto dest = D == TO_SERVER ? "->" : "<-";
-        detail::infoCore<L>(std::format(" C {} S: {}", dest, message));
+        if (logConfig.enabled<L>()) detail::infoCore<L>(detail::RecordKind::NETWORK_TEXT, D, message);
+    }
+
+    template<NetDest D, LogLevel L, lazy_message F>
+    void networkInfo(F&& message) {
+        if (logConfig.enabled<L>()) detail::infoCore<L>(detail::RecordKind::NETWORK_TEXT, D, std::forward<F>(message)());
+    }
+
+    template<NetDest D, LogLevel L, lazy_message F>
+    void packetInfo(const std::size_t group, const int id, F&& message) {
+        if (logConfig.enabled<L>(group, id)) detail::infoCore<L>(detail::RecordKind::NETWORK_TEXT, D, std::forward<F>(message)());
+    }
+
+    template<NetDest D, LogLevel L>
+    void networkBytes(const char* data, const std::size_t size) {
+        if (logConfig.enabled<L>()) detail::infoCore<L>(detail::RecordKind::NETWORK_BYTES, D, {data, size});
+    }
+
+    template<NetDest D, LogLevel L>
+    void networkBytes(const std::size_t group, const int id, const char* data, const std::size_t size) {
+        if (logConfig.enabled<L>(group, id)) detail::infoCore<L>(detail::RecordKind::NETWORK_BYTES, D, {data, size});
     }
 
     template<FStrChar S, NetDest D, LogLevel L>
     void networkInfo() {
-        auto dest = D == TO_SERVER ? "->" : "<-";
-        detail::infoCore<L>(std::format(" C {} S: {}", dest, S.data.data()));
+        if (logConfig.enabled<L>()) detail::infoCore<L>(detail::RecordKind::NETWORK_TEXT, D, {S.data.data(), S.size});
     }
 
     template<LogLevel L>
     void debugInfo(std::string message) {
-        detail::infoCore<L>(std::format(" -- : {}", message));
+        if (logConfig.enabled<L>()) detail::infoCore<L>(detail::RecordKind::GENERAL, TO_CLIENT, message);
+    }
+
+    template<LogLevel L, lazy_message F>
+    void debugInfo(F&& message) {
+        if (logConfig.enabled<L>()) detail::infoCore<L>(detail::RecordKind::GENERAL, TO_CLIENT, std::forward<F>(message)());
     }
 
     template<FStrChar S, LogLevel L>
     void debugInfo() {
-        detail::infoCore<L>(std::format(" -- : {}", S.data.data()));
+        if (logConfig.enabled<L>()) detail::infoCore<L>(detail::RecordKind::GENERAL, TO_CLIENT, {S.data.data(), S.size});
     }
 }  // namespace minecraft
 
@@ -0,0 +1,205 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file metrics.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 22:05
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef METRICS_H
+#define METRICS_H
+#pragma once
+
+#include "../protocol/package/capture.h"
+#include "latency.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace minecraft::client {
+
+    /** @class Histogram
+     *
+     * @if zh
+     * @brief HDR风格的对数-线性直方图
+     * @details
+     * - 小于8的值各占一个桶，此后每个2的幂区间等分为8个子桶，相对误差不超过12.5%
+     * - 覆盖完整的64位范围，桶数固定为 @c BUCKETS，记录只需一次位运算与一次自增
+     *
+     * @else
+     * @brief HDR-style log-linear histogram
+     * @details
+     * - Values below 8 get a bucket each, every power-of-two range above is split into 8 sub-buckets, so the relative error is at most 12.5%
+     * - Covers the full 64-bit range with a fixed @c BUCKETS, recording is one bit operation and one increment
+     *
+     * @endif
+     * */
+    class Histogram {
+    public:
+        static constexpr int SUB_BITS = 3;
+
+        static constexpr std::size_t SUB_BUCKETS = 1 << SUB_BITS;
+
+        static constexpr std::size_t BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+        static constexpr std::size_t bucketOf(std::uint64_t value);
+
+        static constexpr std::uint64_t lowerBound(std::size_t bucket);
+
+        static constexpr std::uint64_t upperBound(std::size_t bucket);
+
+        void record(std::uint64_t value);
+
+        void merge(const Histogram& other);
+
+        [[nodiscard]] std::uint64_t percentile(double q) const;
+
+        [[nodiscard]] LatencySummary summary() const;
+
+        std::array<std::uint64_t, BUCKETS> buckets{};
+
+        std::uint64_t count = 0;
+
+        std::uint64_t sum = 0;
+
+        std::uint64_t max = 0;
+    };
+
+    /** @struct PacketCounters
+     *
+     * @if zh
+     * @brief 单个（方向，状态，数据包ID）的累计计数
+     * @details @c wireBytes 为含长度前缀的线上字节数，@c rawBytes 为解压后的数据包ID与字段字节数
+     *
+     * @else
+     * @brief Accumulated counters of one (direction, state, packet id)
+     * @details @c wireBytes are the bytes on the wire including the length prefix, @c rawBytes the uncompressed packet id and field bytes
+     *
+     * @endif
+     * */
+    struct PacketCounters {
+        std::uint64_t packets = 0;
+
+        std::uint64_t wireBytes = 0;
+
+        std::uint64_t rawBytes = 0;
+
+        std::uint64_t decodeNanos = 0;
+
+        std::uint64_t dispatchNanos = 0;
+    };
+
+    /** @struct PacketMetric
+     *
+     * @if zh
+     * @brief 快照中的一行，@c id 为-1表示超出跟踪范围的ID；客户端只统计已登记类型的入站ID
+     *
+     * @else
+     * @brief One row of a snapshot, an @c id of -1 stands for ids outside the tracked range; the client only counts inbound ids with a registered type
+     *
+     * @endif
+     * */
+    struct PacketMetric {
+        protocol::Direction direction;
+
+        protocol::State state;
+
+        int id;
+
+        PacketCounters counters;
+    };
+
+    enum class Stage { DECODE, DISPATCH, SEND_QUEUE };
+
+    /** @struct MetricsSnapshot
+     *
+     * @if zh
+     * @brief 合并所有线程分片后的指标快照
+     *
+     * @else
+     * @brief Metrics snapshot with every per-thread shard merged
+     *
+     * @endif
+     * */
+    struct MetricsSnapshot {
+        std::vector<PacketMetric> packets;
+
+        std::array<Histogram, 3> stages;
+
+        [[nodiscard]] const Histogram& stage(Stage s) const;
+
+        [[nodiscard]] std::string toPrometheus() const;
+    };
+
+    /** @class MetricsRegistry
+     *
+     * @if zh
+     * @brief 按数据包类型统计流量与各阶段耗时
+     * @details
+     * - 每个写入线程拥有独立分片，只由该线程写入（普通的加载+存储，无原子读改写），读取时合并
+     * - 分片在线程首次写入时创建并归注册表所有，线程退出后计数仍保留
+     * - 阶段直方图：@c DECODE 解码耗时，@c DISPATCH 接收线程内的回调耗时，@c SEND_QUEUE 数据在发送队列中的停留时间
+     * - 分片模式下工作线程内的回调耗时计入对应数据包的 @c dispatchNanos，但不进入直方图
+     *
+     * @else
+     * @brief Per-packet-type traffic and stage timing
+     * @details
+     * - Each writing thread owns a shard that only it writes (plain load + store, no atomic read-modify-write), shards are merged on read
+     * - A shard is created on a thread's first write and owned by the registry, its counts survive the thread
+     * - Stage histograms: @c DECODE decode time, @c DISPATCH callback time on the receive thread, @c SEND_QUEUE time spent in the send queue
+     * - In sharded mode callback time on the workers is added to the packet's @c dispatchNanos but not to the histogram
+     *
+     * @endif
+     * */
+    class MetricsRegistry {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t MAX_IDS = 256;
+
+        MetricsRegistry();
+
+        MetricsRegistry(const MetricsRegistry&) = delete;
+
+        MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+        ~MetricsRegistry();
+
+        void count(protocol::Direction direction, protocol::State state, int id, std::size_t wireBytes, std::size_t rawBytes);
+
+        void time(Stage stage, protocol::State state, int id, Clock::duration elapsed, bool histogram = true);
+
+        [[nodiscard]] MetricsSnapshot snapshot() const;
+
+        bool dump(const std::string& path) const;
+
+    private:
+        struct Shard;
+
+        std::uint64_t uid;
+
+        mutable std::mutex mutex;
+
+        std::vector<std::unique_ptr<Shard>> shards;
+
+        Shard& local();
+    };
+
+}  // namespace minecraft::client
+
+#include "metrics.hpp"
+
+#endif  // METRICS_H
@@ -0,0 +1,297 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file metrics.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 22:05
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef METRICS_HPP
+#define METRICS_HPP
+#pragma once
+
+#include "../utils/utils.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+
+namespace minecraft::client {
+
+    constexpr std::size_t Histogram::bucketOf(const std::uint64_t value) {
+        if (value < SUB_BUCKETS) return static_cast<std::size_t>(value);
+
+        const auto exponent = std::bit_width(value) - 1;
+        const auto sub      = (value >> (exponent - SUB_BITS)) & (SUB_BUCKETS - 1);
+
+        return static_cast<std::size_t>(exponent - SUB_BITS + 1) * SUB_BUCKETS + static_cast<std::size_t>(sub);
+    }
+
+    constexpr std::uint64_t Histogram::lowerBound(const std::size_t bucket) {
+        if (bucket < SUB_BUCKETS) return bucket;
+
+        const auto exponent = static_cast<int>(bucket / SUB_BUCKETS) + SUB_BITS - 1;
+
+        return (SUB_BUCKETS + bucket % SUB_BUCKETS) << (exponent - SUB_BITS);
+    }
+
+    constexpr std::uint64_t Histogram::upperBound(const std::size_t bucket) { return bucket + 1 < BUCKETS ? lowerBound(bucket + 1) - 1 : UINT64_MAX; }
+
+    static_assert(Histogram::bucketOf(UINT64_MAX) == Histogram::BUCKETS - 1);
+
+    inline void Histogram::record(const std::uint64_t value) {
+        buckets[bucketOf(value)]++;
+        count++;
+        sum += value;
+        max = std::max(max, value);
+    }
+
+    inline void Histogram::merge(const Histogram& other) {
+        for (std::size_t i = 0; i < BUCKETS; ++i) buckets[i] += other.buckets[i];
+
+        count += other.count;
+        sum += other.sum;
+        max = std::max(max, other.max);
+    }
+
+    inline std::uint64_t Histogram::percentile(const double q) const {
+        if (count == 0) return 0;
+
+        const auto target = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count))), 1);
+
+        std::uint64_t seen = 0;
+
+        for (std::size_t i = 0; i < BUCKETS; ++i)
+            if ((seen += buckets[i]) >= target) return std::min(upperBound(i), max);
+
+        return max;
+    }
+
+    inline LatencySummary Histogram::summary() const {
+        return {count, std::chrono::nanoseconds(percentile(0.5)), std::chrono::nanoseconds(percentile(0.9)), std::chrono::nanoseconds(percentile(0.99)), std::chrono::nanoseconds(max)};
+    }
+
+    namespace detail {
+        inline constexpr std::size_t METRIC_STATES = minecraft::detail::enumMax<protocol::State>();
+
+        inline constexpr std::size_t METRIC_SLOTS = MetricsRegistry::MAX_IDS + 1;
+
+        inline constexpr std::size_t METRIC_FIELDS = 5;
+
+        // 单写者计数：只有所属线程写入，无需原子读改写
+        inline void bump(std::atomic<std::uint64_t>& counter, const std::uint64_t value) { counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed); }
+
+        inline std::size_t metricSlot(const int id) { return id >= 0 && static_cast<std::size_t>(id) < MetricsRegistry::MAX_IDS ? static_cast<std::size_t>(id) : MetricsRegistry::MAX_IDS; }
+
+        inline std::size_t metricIndex(const protocol::Direction direction, const protocol::State state, const int id) {
+            return (static_cast<std::size_t>(direction) * METRIC_STATES + static_cast<std::size_t>(state)) * METRIC_SLOTS + metricSlot(id);
+        }
+
+        inline std::atomic<std::uint64_t> nextRegistryId = 1;
+    }  // namespace detail
+
+    struct MetricsRegistry::Shard {
+        struct Timing {
+            std::array<std::atomic<std::uint64_t>, Histogram::BUCKETS> buckets{};
+
+            std::atomic<std::uint64_t> count = 0;
+
+            std::atomic<std::uint64_t> sum = 0;
+
+            std::atomic<std::uint64_t> max = 0;
+        };
+
+        explicit Shard(const std::thread::id owner)
+            : owner(owner) {}
+
+        std::thread::id owner;
+
+        // 字段顺序与 PacketCounters 一致
+        std::array<std::array<std::atomic<std::uint64_t>, detail::METRIC_FIELDS>, 2 * detail::METRIC_STATES * detail::METRIC_SLOTS> cells{};
+
+        std::array<Timing, 3> stages{};
+    };
+
+    inline MetricsRegistry::MetricsRegistry()
+        : uid(detail::nextRegistryId.fetch_add(1, std::memory_order_relaxed)) {}
+
+    inline MetricsRegistry::~MetricsRegistry() = default;
+
+    inline MetricsRegistry::Shard& MetricsRegistry::local() {
+        thread_local struct {
+            std::uint64_t owner = 0;
+
+            Shard* shard = nullptr;
+        } cache;
+
+        // 注册表编号全局唯一，已销毁注册表的缓存永远不会命中
+        if (cache.owner == uid) return *cache.shard;
+
+        std::lock_guard lock(mutex);
+
+        const auto self = std::this_thread::get_id();
+        const auto it   = std::ranges::find_if(shards, [self](const auto& shard) { return shard->owner == self; });
+
+        cache.owner = uid;
+        cache.shard = it != shards.end() ? it->get() : shards.emplace_back(std::make_unique<Shard>(self)).get();
+
+        return *cache.shard;
+    }
+
+    inline void MetricsRegistry::count(const protocol::Direction direction, const protocol::State state, const int id, const std::size_t wireBytes, const std::size_t rawBytes) {
+        auto& cell = local().cells[detail::metricIndex(direction, state, id)];
+
+        detail::bump(cell[0], 1);
+        detail::bump(cell[1], wireBytes);
+        detail::bump(cell[2], rawBytes);
+    }
+
+    inline void MetricsRegistry::time(const Stage stage, const protocol::State state, const int id, const Clock::duration elapsed, const bool histogram) {
+        auto& shard = local();
+
+        const auto nanos = static_cast<std::uint64_t>(std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), 0));
+
+        if (stage != Stage::SEND_QUEUE) detail::bump(shard.cells[detail::metricIndex(protocol::Direction::INBOUND, state, id)][stage == Stage::DECODE ? 3 : 4], nanos);
+
+        if (!histogram) return;
+
+        auto& timing = shard.stages[static_cast<std::size_t>(stage)];
+
+        detail::bump(timing.buckets[Histogram::bucketOf(nanos)], 1);
+        detail::bump(timing.count, 1);
+        detail::bump(timing.sum, nanos);
+
+        if (nanos > timing.max.load(std::memory_order_relaxed)) timing.max.store(nanos, std::memory_order_relaxed);
+    }
+
+    inline MetricsSnapshot MetricsRegistry::snapshot() const {
+        MetricsSnapshot result;
+
+        std::vector<PacketCounters> totals(2 * detail::METRIC_STATES * detail::METRIC_SLOTS);
+
+        {
+            std::lock_guard lock(mutex);
+
+            for (const auto& shard : shards) {
+                for (std::size_t i = 0; i < totals.size(); ++i) {
+                    const auto& cell = shard->cells[i];
+
+                    totals[i].packets += cell[0].load(std::memory_order_relaxed);
+                    totals[i].wireBytes += cell[1].load(std::memory_order_relaxed);
+                    totals[i].rawBytes += cell[2].load(std::memory_order_relaxed);
+                    totals[i].decodeNanos += cell[3].load(std::memory_order_relaxed);
+                    totals[i].dispatchNanos += cell[4].load(std::memory_order_relaxed);
+                }
+
+                for (std::size_t s = 0; s < result.stages.size(); ++s) {
+                    const auto& timing = shard->stages[s];
+                    auto& merged       = result.stages[s];
+
+                    for (std::size_t b = 0; b < Histogram::BUCKETS; ++b) merged.buckets[b] += timing.buckets[b].load(std::memory_order_relaxed);
+
+                    merged.count += timing.count.load(std::memory_order_relaxed);
+                    merged.sum += timing.sum.load(std::memory_order_relaxed);
+                    merged.max = std::max(merged.max, timing.max.load(std::memory_order_relaxed));
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < totals.size(); ++i) {
+            const auto& counters = totals[i];
+
+            if (!counters.packets && !counters.decodeNanos && !counters.dispatchNanos) continue;
+
+            const auto slot  = i % detail::METRIC_SLOTS;
+            const auto state = i / detail::METRIC_SLOTS % detail::METRIC_STATES;
+            const auto dir   = i / detail::METRIC_SLOTS / detail::METRIC_STATES;
+
+            result.packets.push_back({static_cast<protocol::Direction>(dir), static_cast<protocol::State>(state), slot == MAX_IDS ? -1 : static_cast<int>(slot), counters});
+        }
+
+        return result;
+    }
+
+    inline bool MetricsRegistry::dump(const std::string& path) const {
+        const auto temp = path + ".tmp";
+
+        {
+            std::ofstream out(temp, std::ios::trunc);
+
+            if (!out) return false;
+
+            out << snapshot().toPrometheus();
+
+            if (!out.flush()) return false;
+        }
+
+        // 先写临时文件再改名，采集端不会读到写了一半的文件；filesystem::rename在各平台上都直接替换已有文件，目标文件始终存在
+        std::error_code error;
+
+        std::filesystem::rename(temp, path, error);
+
+        return !error;
+    }
+
+    inline const Histogram& MetricsSnapshot::stage(const Stage s) const { return stages[static_cast<std::size_t>(s)]; }
+
+    inline std::string MetricsSnapshot::toPrometheus() const {
+        std::string out;
+
+        const auto labels = [](const PacketMetric& m) {
+            return std::format(R"(direction="{}",state="{}",id="{}")", m.direction == protocol::Direction::OUTBOUND ? "outbound" : "inbound", enumToStr(m.state),
+                               m.id < 0 ? std::string("other") : std::format("0x{:02X}", m.id));
+        };
+
+        const auto counter = [&](const char* name, const char* help, const auto& value) {
+            out += std::format("# HELP {} {}\n# TYPE {} counter\n", name, help, name);
+
+            for (const auto& m : packets) out += std::format("{}{{{}}} {}\n", name, labels(m), value(m.counters));
+        };
+
+        counter("minecraft_packets_total", "Packets per direction, state and packet id", [](const PacketCounters& c) { return c.packets; });
+        counter("minecraft_wire_bytes_total", "Bytes on the wire including the length prefix", [](const PacketCounters& c) { return c.wireBytes; });
+        counter("minecraft_raw_bytes_total", "Uncompressed packet id and field bytes", [](const PacketCounters& c) { return c.rawBytes; });
+        counter("minecraft_decode_seconds_total", "Time spent decoding", [](const PacketCounters& c) { return static_cast<double>(c.decodeNanos) / 1e9; });
+        counter("minecraft_dispatch_seconds_total", "Time spent in callbacks", [](const PacketCounters& c) { return static_cast<double>(c.dispatchNanos) / 1e9; });
+
+        out += "# HELP minecraft_stage_duration_seconds Per-packet duration of each pipeline stage\n# TYPE minecraft_stage_duration_seconds histogram\n";
+
+        constexpr std::array names = {"decode", "dispatch", "send_queue"};
+
+        for (std::size_t s = 0; s < stages.size(); ++s) {
+            const auto& h = stages[s];
+
+            std::uint64_t cumulative = 0;
+            std::size_t bucket       = 0;
+
+            // 只输出1微秒到约17秒之间2的幂边界，细粒度桶仍保留在快照中
+            // le按“小于等于”计数，而2的幂落在其所在桶的下界，故取前一个桶的闭区间上界（即2的幂减1纳秒）作为le
+            for (int exponent = 10; exponent <= 34; ++exponent) {
+                const auto last = Histogram::bucketOf(std::uint64_t{1} << exponent) - 1;
+
+                for (; bucket <= last; ++bucket) cumulative += h.buckets[bucket];
+
+                out += std::format("minecraft_stage_duration_seconds_bucket{{stage=\"{}\",le=\"{}\"}} {}\n", names[s], static_cast<double>(Histogram::upperBound(last)) / 1e9, cumulative);
+            }
+
+            out += std::format("minecraft_stage_duration_seconds_bucket{{stage=\"{}\",le=\"+Inf\"}} {}\n", names[s], h.count);
+            out += std::format("minecraft_stage_duration_seconds_sum{{stage=\"{}\"}} {}\n", names[s], static_cast<double>(h.sum) / 1e9);
+            out += std::format("minecraft_stage_duration_seconds_count{{stage=\"{}\"}} {}\n", names[s], h.count);
+        }
+
+        return out;
+    }
+
+}  // namespace minecraft::client
+
+#endif  // METRICS_HPP
@@ -0,0 +1,125 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file timeline.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 23:30
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TIMELINE_H
+#define TIMELINE_H
+#pragma once
+
+#include "../protocol/package/definition.h"
+#include "latency.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+
+namespace minecraft::client {
+
+    /**
+     * @if zh
+     * @brief 接收帧经过的各阶段
+     * @details
+     * - @c FRAMING 套接字读取返回到帧拼接完成（同一次读取中排在前面的帧的处理时间也计入此处）
+     * - @c INFLATE 帧完成到解压完成，未压缩的帧为0
+     * - @c DECODE 解压完成到字段解码完成
+     * - @c QUEUE 解码完成到用户回调开始（协议内置回调与分片模式下的工作队列等待）
+     * - @c HANDLER 用户回调本身
+     *
+     * @else
+     * @brief Stages a received frame goes through
+     * @details
+     * - @c FRAMING socket read returned until the frame is complete (includes handling earlier frames of the same read)
+     * - @c INFLATE frame complete until decompression is done, 0 for uncompressed frames
+     * - @c DECODE decompression done until the fields are decoded
+     * - @c QUEUE decoded until user callbacks start (built-in protocol callbacks and the worker queue in sharded mode)
+     * - @c HANDLER the user callbacks themselves
+     *
+     * @endif
+     * */
+    enum class FrameStage { FRAMING, INFLATE, DECODE, QUEUE, HANDLER };
+
+    /** @struct FrameTimeline
+     *
+     * @if zh
+     * @brief 一个接收帧从套接字读取到回调结束的时间戳
+     *
+     * @else
+     * @brief Timestamps of one received frame, from the socket read to the end of its callbacks
+     *
+     * @endif
+     * */
+    struct FrameTimeline {
+        using Clock = std::chrono::steady_clock;
+
+        protocol::State state;
+
+        int id = -1;
+
+        Clock::time_point read;
+
+        Clock::time_point framed;
+
+        Clock::time_point inflated;
+
+        Clock::time_point decoded;
+
+        Clock::time_point handlerStart;
+
+        Clock::time_point handlerEnd;
+
+        [[nodiscard]] Clock::duration stage(FrameStage s) const;
+
+        [[nodiscard]] Clock::duration total() const;
+    };
+
+    /** @class TimelineTracker
+     *
+     * @if zh
+     * @brief 按连接聚合各阶段延迟，可选记录慢数据包
+     * @details 慢包阈值为0时关闭；任一阶段超过阈值时以WARNING级别输出该帧的完整阶段拆分
+     *
+     * @else
+     * @brief Aggregates per-stage latency of a connection, optionally logging slow packets
+     * @details A slow threshold of 0 disables the log; when any stage exceeds it the full stage breakdown of the frame is logged at WARNING
+     *
+     * @endif
+     * */
+    class TimelineTracker {
+    public:
+        static constexpr std::size_t STAGES = 5;
+
+        void record(const FrameTimeline& timeline);
+
+        void setSlowThreshold(std::chrono::nanoseconds threshold);
+
+        [[nodiscard]] LatencySummary stage(FrameStage s) const;
+
+        [[nodiscard]] LatencySummary total() const;
+
+        [[nodiscard]] std::uint64_t slowPackets() const;
+
+    private:
+        std::array<RollingWindow, STAGES> stages;
+
+        RollingWindow totals;
+
+        std::atomic<std::int64_t> slowThreshold = 0;
+
+        std::atomic<std::uint64_t> slow = 0;
+    };
+
+}  // namespace minecraft::client
+
+#include "timeline.hpp"
+
+#endif  // TIMELINE_H
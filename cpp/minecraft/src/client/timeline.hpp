@@ -0,0 +1,76 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file timeline.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 23:30
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TIMELINE_HPP
+#define TIMELINE_HPP
+#pragma once
+
+#include "../utils/utils.h"
+#include "logging.h"
+#include <algorithm>
+#include <format>
+
+namespace minecraft::client {
+
+    inline FrameTimeline::Clock::duration FrameTimeline::stage(const FrameStage s) const {
+        switch (s) {
+            case FrameStage::FRAMING: return framed - read;
+            case FrameStage::INFLATE: return inflated - framed;
+            case FrameStage::DECODE: return decoded - inflated;
+            case FrameStage::QUEUE: return handlerStart - decoded;
+            case FrameStage::HANDLER: return handlerEnd - handlerStart;
+        }
+
+        return {};
+    }
+
+    inline FrameTimeline::Clock::duration FrameTimeline::total() const { return handlerEnd - read; }
+
+    inline void TimelineTracker::record(const FrameTimeline& timeline) {
+        std::array<std::chrono::nanoseconds, STAGES> spent;
+
+        for (std::size_t i = 0; i < STAGES; ++i) {
+            spent[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(timeline.stage(static_cast<FrameStage>(i)));
+
+            stages[i].add(spent[i]);
+        }
+
+        totals.add(std::chrono::duration_cast<std::chrono::nanoseconds>(timeline.total()));
+
+        const auto threshold = slowThreshold.load(std::memory_order_relaxed);
+
+        if (threshold <= 0 || std::ranges::none_of(spent, [threshold](const auto d) { return d.count() > threshold; })) return;
+
+        slow.fetch_add(1, std::memory_order_relaxed);
+
+        debugInfo<LogLevel::WARNING>([&timeline, &spent] {
+            const auto ms = [](const std::chrono::nanoseconds d) { return static_cast<double>(d.count()) / 1e6; };
+
+            return std::format("Slow packet [{}] 0x{:02X}: framing {:.3f} ms, inflate {:.3f} ms, decode {:.3f} ms, queue {:.3f} ms, handler {:.3f} ms", enumToStr(timeline.state), timeline.id,
+                               ms(spent[0]), ms(spent[1]), ms(spent[2]), ms(spent[3]), ms(spent[4]));
+        });
+    }
+
+    inline void TimelineTracker::setSlowThreshold(const std::chrono::nanoseconds threshold) { slowThreshold.store(threshold.count(), std::memory_order_relaxed); }
+
+    inline LatencySummary TimelineTracker::stage(const FrameStage s) const { return stages[static_cast<std::size_t>(s)].summary(); }
+
+    inline LatencySummary TimelineTracker::total() const { return totals.summary(); }
+
+    inline std::uint64_t TimelineTracker::slowPackets() const { return slow.load(std::memory_order_relaxed); }
+
+}  // namespace minecraft::client
+
+#endif  // TIMELINE_HPP
@@ -0,0 +1,35 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file packets.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 04:10
+ * @brief Explicit instantiation definitions of the packet codecs declared extern by instantiation.h
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+
+#include "protocol/package/instantiation.h"
+#include <type_traits>
+
+namespace minecraft::protocol::detail {
+    template<is_package P, is_package... Qs>
+    constexpr bool listed(PacketList<Qs...>) {
+        return (std::is_same_v<P, Qs> || ...);
+    }
+
+    template<is_package... Ps, is_package... Qs>
+    constexpr bool samePackets(PacketList<Ps...>, PacketList<Qs...> list) {
+        return sizeof...(Ps) == sizeof...(Qs) && (listed<Ps>(list) && ...);
+    }
+
+    static_assert(samePackets(typename ConcatPacketList<AllPacketList<ClientPacketList>, AllPacketList<ServerPacketList>>::type{}, InstantiatedPackets{}),
+                  "MC_PROTOCOL_PACKET_TYPES must list every distinct packet of ClientPacketList and ServerPacketList exactly once");
+}  // namespace minecraft::protocol::detail
+
+MC_PROTOCOL_PACKET_TYPES(MC_PROTOCOL_INSTANTIATE_PACKET)
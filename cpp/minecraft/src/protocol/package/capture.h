@@ -0,0 +1,196 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file capture.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 21:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef CAPTURE_H
+#define CAPTURE_H
+#pragma once
+
+#include "definition.h"
+#include "frame.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace minecraft::protocol {
+
+    /**
+     * @if zh
+     * @brief 抓包记录的方向（相对本客户端）
+     *
+     * @else
+     * @brief Direction of a captured frame, relative to this client
+     *
+     * @endif
+     * */
+    enum class Direction : std::uint8_t { INBOUND, OUTBOUND };
+
+    /** @struct CaptureRecord
+     *
+     * @if zh
+     * @brief 一条抓包记录
+     * @details @c frame 为完整的线上帧，包含长度前缀，可直接交给 @c Package::deserialize
+     *
+     * @else
+     * @brief One captured frame
+     * @details @c frame is the complete wire frame including its length prefix, it can be handed to @c Package::deserialize directly
+     *
+     * @endif
+     * */
+    struct CaptureRecord {
+        std::chrono::system_clock::time_point time;
+
+        Direction direction;
+
+        State state;
+
+        bool compressed;
+
+        std::vector<std::byte> frame;
+    };
+
+    /** @class CaptureWriter
+     *
+     * @if zh
+     * @brief 二进制抓包写入器
+     * @details
+     * - 文件头：魔数 "MCCP"、1字节版本号、8字节小端的打开时刻（Unix纳秒）
+     * - 每条记录：1字节标志（bit0 发出，bit1 压缩，高4位为连接状态）、距上一条记录的微秒数（VarLong）、原始帧
+     * - 帧自带长度前缀，记录之间无需额外分隔；帧内容原样写入，不解压也不解码
+     * - 记录先追加到内存缓冲区，满 @c BUFFER_SIZE 或析构时才写入文件，收发线程可同时写入
+     *
+     * @else
+     * @brief Binary capture writer
+     * @details
+     * - File header: magic "MCCP", a 1-byte version and the opening time as 8-byte little-endian Unix nanoseconds
+     * - Each record: a flag byte (bit0 outbound, bit1 compressed, high nibble the connection state), the microseconds
+     *   since the previous record as a VarLong, then the raw frame
+     * - Frames carry their own length prefix, so records need no extra delimiter; frames are stored as-is, never inflated or decoded
+     * - Records are appended to an in-memory buffer that only hits the file when @c BUFFER_SIZE is reached or on destruction,
+     *   the receive and send threads may write concurrently
+     *
+     * @endif
+     * */
+    class CaptureWriter {
+    public:
+        static constexpr std::size_t BUFFER_SIZE = 64 * 1024;
+
+        explicit CaptureWriter(const std::string& path);
+
+        CaptureWriter(const CaptureWriter&) = delete;
+
+        CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+        ~CaptureWriter();
+
+        void write(Direction direction, State state, bool compressed, std::span<const std::byte> frame);
+
+        void flush();
+
+        [[nodiscard]] bool isOpen() const;
+
+        [[nodiscard]] std::uint64_t records() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::mutex mutex;
+
+        std::FILE* file;
+
+        std::vector<std::byte> buffer;
+
+        Clock::time_point last;
+
+        std::atomic<std::uint64_t> count = 0;
+
+        void flushLocked();
+    };
+
+    /** @class CaptureReader
+     *
+     * @if zh
+     * @brief 顺序读取 @c CaptureWriter 写出的抓包文件
+     * @details 文件末尾被截断的记录（进程异常退出时缓冲区未写完）被忽略
+     *
+     * @else
+     * @brief Reads a capture file written by @c CaptureWriter sequentially
+     * @details A truncated record at the end of the file (the buffer was not fully written when the process died) is ignored
+     *
+     * @endif
+     * */
+    class CaptureReader {
+    public:
+        explicit CaptureReader(const std::string& path);
+
+        bool next(CaptureRecord& record);
+
+        [[nodiscard]] std::chrono::system_clock::time_point opened() const;
+
+    private:
+        std::ifstream stream;
+
+        std::chrono::system_clock::time_point time;
+
+        bool readVarNum(std::uint64_t& value, std::vector<std::byte>* raw = nullptr);
+    };
+
+    /**
+     * @if zh
+     * @brief 用已有的数据包定义解码一条记录并格式化为一行文本
+     * @details 收到的帧按 @c ServerPacketList 解码，发出的帧按 @c ClientPacketList 解码；未登记或解码失败的帧退回 @c Package<> 的原始输出
+     *
+     * @else
+     * @brief Decode a record with the existing packet definitions and format it as one line
+     * @details Inbound frames are decoded with @c ServerPacketList, outbound ones with @c ClientPacketList; unlisted frames
+     * and frames that fail to decode fall back to the raw output of @c Package<>
+     *
+     * @endif
+     * */
+    std::string describeRecord(const CaptureRecord& record);
+
+    /**
+     * @if zh
+     * @brief 同 @c describeRecord ，但直接写入输出迭代器，便于复用缓冲区
+     *
+     * @else
+     * @brief Same as @c describeRecord but writes straight to an output iterator, so a buffer can be reused
+     *
+     * @endif
+     * */
+    template<typename OutputIt>
+    OutputIt describeRecordTo(OutputIt out, const CaptureRecord& record);
+
+    /**
+     * @if zh
+     * @brief 离线打印整个抓包文件，返回记录条数
+     *
+     * @else
+     * @brief Print a whole capture file offline, returns the number of records
+     *
+     * @endif
+     * */
+    std::size_t printCapture(const std::string& path, std::ostream& out);
+
+}  // namespace minecraft::protocol
+
+#include "capture.hpp"
+
+#endif  // CAPTURE_H
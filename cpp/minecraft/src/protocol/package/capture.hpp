@@ -0,0 +1,250 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file capture.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 21:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef CAPTURE_HPP
+#define CAPTURE_HPP
+#pragma once
+
+#include "../../utils/utils.h"
+#include <array>
+#include <format>
+#include <iterator>
+#include <stdexcept>
+
+namespace minecraft::protocol {
+
+    namespace detail {
+        inline constexpr std::array<char, 4> CAPTURE_MAGIC = {'M', 'C', 'C', 'P'};
+
+        inline constexpr std::uint8_t CAPTURE_VERSION = 1;
+
+        inline constexpr std::uint8_t CAPTURE_OUTBOUND = 0x01;
+
+        inline constexpr std::uint8_t CAPTURE_COMPRESSED = 0x02;
+
+        inline void appendVarNum(std::vector<std::byte>& out, std::uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<std::byte>(value & 0x7F) | CONTINUE_BIT<std::byte>);
+                value >>= 7;
+            }
+
+            out.push_back(static_cast<std::byte>(value));
+        }
+    }  // namespace detail
+
+    inline CaptureWriter::CaptureWriter(const std::string& path)
+        : file(std::fopen(path.c_str(), "wb"))
+        , last(Clock::now()) {
+        if (!file) return;
+
+        buffer.reserve(BUFFER_SIZE);
+
+        for (const auto c : detail::CAPTURE_MAGIC) buffer.push_back(static_cast<std::byte>(c));
+
+        buffer.push_back(static_cast<std::byte>(detail::CAPTURE_VERSION));
+
+        const auto opened = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+        for (int i = 0; i < 8; ++i) buffer.push_back(static_cast<std::byte>(opened >> (8 * i)));
+    }
+
+    inline CaptureWriter::~CaptureWriter() {
+        if (!file) return;
+
+        flush();
+
+        std::fclose(file);
+    }
+
+    inline void CaptureWriter::write(const Direction direction, const State state, const bool compressed, const std::span<const std::byte> frame) {
+        std::lock_guard lock(mutex);
+
+        if (!file) return;
+
+        // 时间戳在锁内取得，收发线程交错写入时仍单调递增
+        const auto now   = Clock::now();
+        const auto delta = std::chrono::duration_cast<std::chrono::microseconds>(now - last).count();
+
+        last = now;
+
+        auto flags = static_cast<std::uint8_t>(static_cast<std::uint8_t>(state) << 4);
+
+        if (direction == Direction::OUTBOUND) flags |= detail::CAPTURE_OUTBOUND;
+        if (compressed) flags |= detail::CAPTURE_COMPRESSED;
+
+        buffer.push_back(static_cast<std::byte>(flags));
+        detail::appendVarNum(buffer, static_cast<std::uint64_t>(delta));
+        buffer.insert(buffer.end(), frame.begin(), frame.end());
+
+        count.fetch_add(1, std::memory_order_relaxed);
+
+        if (buffer.size() >= BUFFER_SIZE) flushLocked();
+    }
+
+    inline void CaptureWriter::flush() {
+        std::lock_guard lock(mutex);
+
+        flushLocked();
+
+        if (file) std::fflush(file);
+    }
+
+    inline bool CaptureWriter::isOpen() const { return file != nullptr; }
+
+    inline std::uint64_t CaptureWriter::records() const { return count.load(std::memory_order_relaxed); }
+
+    inline void CaptureWriter::flushLocked() {
+        if (!file || buffer.empty()) return;
+
+        std::fwrite(buffer.data(), 1, buffer.size(), file);
+
+        buffer.clear();
+    }
+
+    inline CaptureReader::CaptureReader(const std::string& path)
+        : stream(path, std::ios::binary) {
+        std::array<char, 4> magic{};
+        char version = 0;
+        std::array<unsigned char, 8> opened{};
+
+        stream.read(magic.data(), magic.size());
+        stream.get(version);
+        stream.read(reinterpret_cast<char*>(opened.data()), opened.size());
+
+        if (!stream || magic != detail::CAPTURE_MAGIC) throw std::runtime_error("Not a capture file: " + path);
+
+        if (static_cast<std::uint8_t>(version) != detail::CAPTURE_VERSION) throw std::runtime_error(std::format("Unsupported capture version {}", static_cast<int>(version)));
+
+        std::uint64_t nanos = 0;
+
+        for (int i = 0; i < 8; ++i) nanos |= static_cast<std::uint64_t>(opened[i]) << (8 * i);
+
+        time = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanos)));
+    }
+
+    inline bool CaptureReader::next(CaptureRecord& record) {
+        char flags = 0;
+
+        if (!stream.get(flags)) return false;
+
+        std::uint64_t delta = 0, length = 0;
+
+        record.frame.clear();
+
+        // 长度前缀原样保留在帧内
+        if (!readVarNum(delta) || !readVarNum(length, &record.frame)) return false;
+
+        if (length > MAX_FRAME_LENGTH) throw std::runtime_error("Frame length out of range");
+
+        const auto state = static_cast<std::uint8_t>(flags) >> 4;
+
+        if (state >= minecraft::detail::enumMax<State>()) throw std::runtime_error("Corrupt capture record");
+
+        const auto prefix = record.frame.size();
+
+        record.frame.resize(prefix + length);
+
+        if (!stream.read(reinterpret_cast<char*>(record.frame.data() + prefix), static_cast<std::streamsize>(length))) return false;
+
+        time += std::chrono::microseconds(delta);
+
+        record.time       = time;
+        record.direction  = static_cast<std::uint8_t>(flags) & detail::CAPTURE_OUTBOUND ? Direction::OUTBOUND : Direction::INBOUND;
+        record.state      = static_cast<State>(state);
+        record.compressed = static_cast<std::uint8_t>(flags) & detail::CAPTURE_COMPRESSED;
+
+        return true;
+    }
+
+    inline std::chrono::system_clock::time_point CaptureReader::opened() const { return time; }
+
+    inline bool CaptureReader::readVarNum(std::uint64_t& value, std::vector<std::byte>* raw) {
+        value = 0;
+
+        for (int shift = 0; shift < 64; shift += 7) {
+            char c = 0;
+
+            if (!stream.get(c)) return false;
+
+            const auto byte = static_cast<std::byte>(c);
+
+            if (raw) raw->push_back(byte);
+
+            value |= static_cast<std::uint64_t>(byte & detail::SEGMENT_BITS<std::byte>) << shift;
+
+            if ((byte & detail::CONTINUE_BIT<std::byte>) == std::byte{0}) return true;
+        }
+
+        throw std::runtime_error("VarNum overflow");
+    }
+
+    inline std::string describeRecord(const CaptureRecord& record) {
+        std::string text;
+
+        describeRecordTo(std::back_inserter(text), record);
+
+        return text;
+    }
+
+    template<typename OutputIt>
+    OutputIt describeRecordTo(OutputIt out, const CaptureRecord& record) {
+        out = std::format_to(out, "[{:%T}] {} [{}] ", std::chrono::floor<std::chrono::microseconds>(record.time), record.direction == Direction::OUTBOUND ? "C -> S" : "C <- S",
+                             enumToStr(record.state));
+
+        const auto f = [&out]<is_package T>(const T& packet) { out = packet.formatTo(out); };
+
+        try {
+            const auto id = peekPacketId(record.frame, record.compressed);
+
+            if (record.direction == Direction::INBOUND)
+                detail::DispatchTable<ServerPacketList, decltype(f), AcceptAll>::dispatch(record.state, id, record.frame, record.compressed, f, AcceptAll{});
+            else
+                detail::DispatchTable<ClientPacketList, decltype(f), AcceptAll>::dispatch(record.state, id, record.frame, record.compressed, f, AcceptAll{});
+        } catch (const std::exception&) {
+            // 定义与实际数据不符时仍输出原始内容
+            try {
+                out = Package<>::deserialize(record.frame.data(), record.compressed).formatTo(out);
+            } catch (const std::exception& e) {
+                out = std::format_to(out, "<undecodable frame of {} bytes: {}>", record.frame.size(), e.what());
+            }
+        }
+
+        return out;
+    }
+
+    inline std::size_t printCapture(const std::string& path, std::ostream& out) {
+        CaptureReader reader(path);
+        CaptureRecord record;
+        std::string line;
+        std::size_t count = 0;
+
+        while (reader.next(record)) {
+            line.clear();
+
+            describeRecordTo(std::back_inserter(line), record);
+
+            line += '\n';
+            out << line;
+            count++;
+        }
+
+        out.flush();
+
+        return count;
+    }
+
+}  // namespace minecraft::protocol
+
+#endif  // CAPTURE_HPP
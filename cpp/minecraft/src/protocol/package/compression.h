@@ -0,0 +1,103 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file compression.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 11:02
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace minecraft::protocol {
+
+    /** @struct CompressionPolicy
+     *
+     * @if zh
+     * @brief 压缩模式下的自适应跳过策略
+     * @details
+     * - 超过阈值的数据包在压缩前先抽样估计字节熵
+     * - 预测的压缩收益低于 @c minSavingRatio 时，按“压缩模式但未压缩”（数据长度为0）发送
+     * @note 每个连接各持一份（见 @c client::Client::setCompressionPolicy），在发送线程读取，修改时应在启动连接前完成
+     *
+     * @else
+     * @brief Adaptive skip policy used in compressed mode
+     * @details
+     * - Packets above the threshold get a sampled byte-entropy estimate before deflating
+     * - When the predicted saving is below @c minSavingRatio they are sent uncompressed (Data Length = 0)
+     * @note Each connection holds its own copy (see @c client::Client::setCompressionPolicy), read on the sending thread, change it before the connection starts
+     *
+     * @endif
+     * */
+    struct CompressionPolicy {
+        bool enabled = true;
+
+        double minSavingRatio = 0.1;
+
+        std::size_t sampleSize = 512;
+    };
+
+    /** @struct CompressionStats
+     *
+     * @if zh
+     * @brief 压缩统计计数器
+     * @details
+     * - 节省的CPU时间由实际压缩的平均每字节耗时乘以被跳过的字节数估算
+     * - 每个连接各持一份，计数器为原子量，可在任意线程读取
+     *
+     * @else
+     * @brief Compression counters
+     * @details
+     * - Saved CPU time is estimated from the average per-byte deflate cost times the skipped bytes
+     * - Each connection holds its own, the counters are atomic and can be read from any thread
+     *
+     * @endif
+     * */
+    struct CompressionStats {
+        std::atomic<std::uint64_t> compressedPackets{0};
+
+        std::atomic<std::uint64_t> compressedBytes{0};
+
+        std::atomic<std::uint64_t> compressNanos{0};
+
+        std::atomic<std::uint64_t> skippedPackets{0};
+
+        std::atomic<std::uint64_t> skippedBytes{0};
+
+        std::atomic<std::uint64_t> estimateNanos{0};
+
+        [[nodiscard]] std::uint64_t estimatedSavedNanos() const;
+
+        void reset();
+    };
+
+    namespace detail {
+        double estimateEntropy(const std::vector<std::byte>& data, std::size_t sampleSize);
+
+        bool worthCompressing(const std::vector<std::byte>& data, const CompressionPolicy& policy, CompressionStats* stats);
+
+        std::vector<std::byte> compressTracked(const std::vector<std::byte>& data, CompressionStats* stats);
+
+        // 本线程最近一次完成解压的时刻，供接收端拆分解压与解码耗时
+        inline thread_local std::chrono::steady_clock::time_point inflateMark{};
+    }  // namespace detail
+
+}  // namespace minecraft::protocol
+
+#include "compression.hpp"
+
+#endif  // COMPRESSION_H
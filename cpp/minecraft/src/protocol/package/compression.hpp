@@ -0,0 +1,130 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file compression.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 11:02
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef COMPRESSION_HPP
+#define COMPRESSION_HPP
+#pragma once
+
+#include "../../utils/utils.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+
+namespace minecraft::protocol {
+
+    inline std::uint64_t CompressionStats::estimatedSavedNanos() const {
+        const auto bytes = compressedBytes.load(std::memory_order_relaxed);
+
+        if (bytes == 0) return 0;
+
+        const auto perByte = static_cast<double>(compressNanos.load(std::memory_order_relaxed)) / static_cast<double>(bytes);
+        const auto saved   = perByte * static_cast<double>(skippedBytes.load(std::memory_order_relaxed));
+        const auto spent   = static_cast<double>(estimateNanos.load(std::memory_order_relaxed));
+
+        return saved > spent ? static_cast<std::uint64_t>(saved - spent) : 0;
+    }
+
+    inline void CompressionStats::reset() {
+        compressedPackets = 0;
+        compressedBytes   = 0;
+        compressNanos     = 0;
+        skippedPackets    = 0;
+        skippedBytes      = 0;
+        estimateNanos     = 0;
+    }
+
+    namespace detail {
+        // 抽样块大小，连续块比逐字节跳跃更能保留局部重复
+        inline constexpr std::size_t ENTROPY_BLOCK = 32;
+
+        inline double estimateEntropy(const std::vector<std::byte>& data, std::size_t sampleSize) {
+            if (data.empty()) return 0.0;
+
+            std::array<std::uint32_t, 256> histogram{};
+            std::size_t total = 0;
+
+            if (data.size() <= std::max(sampleSize, ENTROPY_BLOCK)) {
+                for (const auto b : data) histogram[static_cast<unsigned char>(b)]++;
+
+                total = data.size();
+            }
+
+            else {
+                const auto blocks = std::max<std::size_t>(sampleSize / ENTROPY_BLOCK, 1);
+                const auto stride = (data.size() - ENTROPY_BLOCK) / blocks;
+
+                for (std::size_t i = 0; i < blocks; ++i)
+                    for (std::size_t j = 0, off = i * stride; j < ENTROPY_BLOCK; ++j) histogram[static_cast<unsigned char>(data[off + j])]++;
+
+                total = blocks * ENTROPY_BLOCK;
+            }
+
+            double entropy   = 0.0;
+            std::size_t bins = 0;
+
+            for (const auto count : histogram)
+                if (count) {
+                    const auto p = static_cast<double>(count) / static_cast<double>(total);
+
+                    entropy -= p * std::log2(p);
+                    bins++;
+                }
+
+            // Miller-Madow 修正：小样本会系统性低估熵
+            entropy += static_cast<double>(bins - 1) / (2.0 * static_cast<double>(total) * std::numbers::ln2);
+
+            return std::min(entropy, 8.0);
+        }
+
+        inline bool worthCompressing(const std::vector<std::byte>& data, const CompressionPolicy& policy, CompressionStats* stats) {
+            if (!policy.enabled) return true;
+
+            const auto start = std::chrono::steady_clock::now();
+
+            const auto saving = 1.0 - estimateEntropy(data, policy.sampleSize) / 8.0;
+
+            if (stats)
+                stats->estimateNanos.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+
+            if (saving >= policy.minSavingRatio) return true;
+
+            if (stats) {
+                stats->skippedPackets.fetch_add(1, std::memory_order_relaxed);
+                stats->skippedBytes.fetch_add(data.size(), std::memory_order_relaxed);
+            }
+
+            return false;
+        }
+
+        inline std::vector<std::byte> compressTracked(const std::vector<std::byte>& data, CompressionStats* stats) {
+            if (!stats) return compressData(data);
+
+            const auto start = std::chrono::steady_clock::now();
+
+            auto result = compressData(data);
+
+            stats->compressNanos.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+            stats->compressedBytes.fetch_add(data.size(), std::memory_order_relaxed);
+            stats->compressedPackets.fetch_add(1, std::memory_order_relaxed);
+
+            return result;
+        }
+    }  // namespace detail
+
+}  // namespace minecraft::protocol
+
+#endif  // COMPRESSION_HPP
@@ -21,14 +21,78 @@
 #include "../type/varNum.h"
 #include "definition.h"
 #include "package.h"
+#include <algorithm>
+#include <array>
+#include <tuple>
 
 namespace minecraft::protocol {
     enum class State { HANDSHAKE, STATUS, LOGIN, CONFIGURATION, PLAY };
 
+    /** @struct PacketList
+     *
+     * @if zh
+     * @brief 某一协议状态下的数据包类型列表
+     * @details 分发表、@c ClientPacketType 与 @c ServerPacketType 均由该列表在编译期生成，新增数据包只需加入对应列表
+     *
+     * @else
+     * @brief Type list of the packets of one protocol state
+     * @details Dispatch tables, @c ClientPacketType and @c ServerPacketType are generated from it at compile time,
+     * adding a packet only means adding its type to the list
+     *
+     * @endif
+     * */
+    template<is_package... Ps>
+    struct PacketList {
+        static constexpr std::size_t size = sizeof...(Ps);
+
+        static constexpr int maxId = std::max({-1, Ps::id...});
+    };
+
+    namespace detail {
+        template<typename L, typename... Ps>
+        struct AppendUnique {
+            using type = L;
+        };
+
+        template<is_package... Ls, is_package P, is_package... Ps>
+        struct AppendUnique<PacketList<Ls...>, P, Ps...> : AppendUnique<std::conditional_t<(std::is_same_v<P, Ls> || ...), PacketList<Ls...>, PacketList<Ls..., P>>, Ps...> {};
+
+        template<typename... Ls>
+        struct ConcatPacketList {
+            using type = PacketList<>;
+        };
+
+        template<is_package... Ps, typename... Ls>
+        struct ConcatPacketList<PacketList<Ps...>, Ls...> : AppendUnique<typename ConcatPacketList<Ls...>::type, Ps...> {};
+
+        template<template<State> typename L, typename Seq>
+        struct AllPacketListImpl;
+
+        template<template<State> typename L, std::size_t... Ss>
+        struct AllPacketListImpl<L, std::index_sequence<Ss...>> : ConcatPacketList<typename L<static_cast<State>(Ss)>::type...> {};
+
+        template<int I, typename L>
+        struct PacketById {};
+
+        // 在ID表中查找下标再按下标取类型，实例化次数与列表长度无关
+        template<int I, is_package... Ps>
+            requires((Ps::id == I) || ...)
+        struct PacketById<I, PacketList<Ps...>> {
+            static constexpr std::array<int, sizeof...(Ps)> ids{Ps::id...};
+
+            using type = std::tuple_element_t<static_cast<std::size_t>(std::ranges::find(ids, I) - ids.begin()), std::tuple<Ps...>>;
+        };
+    }  // namespace detail
+
     /** Clientbound packets [Client -> Server] */
 
+    template<State S>
+    struct ClientPacketList {
+        using type = PacketList<>;
+    };
+
     template<State S, int I>
-    struct ClientPacketType;
+    struct ClientPacketType : detail::PacketById<I, typename ClientPacketList<S>::type> {};
 
 #ifdef DEFINITION_H
     template<FStrChar V, is_field T, detail::is_nullable_fstr auto D = Null>
@@ -49,6 +113,8 @@ namespace minecraft::protocol {
 
             using PingPacketType = Package<1, FI<"Payload", UByte>>;
 
+            using Packets = PacketList<HandShakePacketType, PingPacketType>;
+
         }  // namespace handshake_step
 
         // Status Step
@@ -59,6 +125,8 @@ namespace minecraft::protocol {
 
             using PingPacketType = Package<1, FI<"Payload", Long>>;
 
+            using Packets = PacketList<RequestPacketType, PingPacketType>;
+
         }  // namespace status_step
 
         // Configuration Step
@@ -67,6 +135,8 @@ namespace minecraft::protocol {
 
             using FinishConfigurationPacketType = Package<2>;
 
+            using Packets = PacketList<FinishConfigurationPacketType>;
+
         }  // namespace configuration_step
 
         // Login Step
@@ -82,6 +152,8 @@ namespace minecraft::protocol {
 
             using LoginConfirmPacketType = Package<3>;
 
+            using Packets = PacketList<LoginStartPacketType, EncryptionResponsePacketType, LoginPluginRequestPacketType, LoginConfirmPacketType>;
+
         }  // namespace login_step
 
         namespace play_step {
@@ -90,24 +162,49 @@ namespace minecraft::protocol {
 
             using KeepAlivePacketType = Package<16, FI<"KeepAliveID", Long>>;
 
+            // 0x17
+            using SetPlayerPositionPacketType = Package<23, FI<"X", Double>, FI<"FeetY", Double>, FI<"Z", Double>, FI<"OnGround", Boolean>>;
+
+            using Packets = PacketList<TeleportConfirmPacketType, KeepAlivePacketType, SetPlayerPositionPacketType>;
+
         }
 
     }  // namespace client_bound
 
     template<>
-    struct ClientPacketType<State::HANDSHAKE, 0> {
-        using type = client_bound::handshake_step::HandShakePacketType;
+    struct ClientPacketList<State::HANDSHAKE> {
+        using type = client_bound::handshake_step::Packets;
+    };
+
+    template<>
+    struct ClientPacketList<State::STATUS> {
+        using type = client_bound::status_step::Packets;
+    };
+
+    template<>
+    struct ClientPacketList<State::LOGIN> {
+        using type = client_bound::login_step::Packets;
+    };
+
+    template<>
+    struct ClientPacketList<State::CONFIGURATION> {
+        using type = client_bound::configuration_step::Packets;
     };
 
     template<>
-    struct ClientPacketType<State::HANDSHAKE, 1> {
-        using type = client_bound::handshake_step::PingPacketType;
+    struct ClientPacketList<State::PLAY> {
+        using type = client_bound::play_step::Packets;
     };
 
     /** Serverbound packets [Server -> Client] */
 
+    template<State S>
+    struct ServerPacketList {
+        using type = PacketList<>;
+    };
+
     template<State S, int I>
-    struct ServerPacketType;
+    struct ServerPacketType : detail::PacketById<I, typename ServerPacketList<S>::type> {};
 
     namespace server_bound {
         namespace status_step {
@@ -116,6 +213,8 @@ namespace minecraft::protocol {
 
             using PongPacketType = Package<1, FI<"Payload", Long>>;
 
+            using Packets = PacketList<ResponsePacketType, PongPacketType>;
+
         }  // namespace status_step
 
         namespace login_step {
@@ -132,6 +231,8 @@ namespace minecraft::protocol {
 
             using PluginRequestPacketType = Package<4, FI<"MessageID", VarInt>, FI<"Channel", String>, FI<"Data", Array<>, "__rest__"_ns>>;
 
+            using Packets = PacketList<DisconnectPacketType, EncryptionRequestPacketType, LoginSuccessPacketType, CompressionPacketType, PluginRequestPacketType>;
+
         }  // namespace login_step
 
         namespace play_step {
@@ -147,11 +248,20 @@ namespace minecraft::protocol {
             // 0x1B
             using DisconnectPacketType = Package<27, FI<"Reason", String>>;
 
+            // 0x1F
+            using UnloadChunkPacketType = Package<31, FI<"ChunkZ", Int>, FI<"ChunkX", Int>>;
+
             using KeepAlivePacketType = Package<36, FI<"KeepAliveID", Long>>;
 
+            // 0x25 区块列直接解码为调色板区块段，见 ChunkColumn
+            using ChunkDataPacketType = Package<37, FI<"ChunkX", Int>, FI<"ChunkZ", Int>, FI<"Column", ChunkColumn, "__rest__"_ns>>;
+
             // 0x58
             using SetEntityVelocityPacketType = Package<38, FI<"EntityID", VarInt>, FI<"VelocityX", Short>, FI<"VelocityY", Short>, FI<"VelocityZ", Short>>;
 
+            // 0x28
+            using UpdateLightPacketType = Package<40, FI<"ChunkX", VarInt>, FI<"ChunkZ", VarInt>, FI<"Light", LightData, "__rest__"_ns>>;
+
             // 0x2B
             using LoginPacketType = Package<
                 41, FI<"EntityID", Int>, FI<"IsHardcore", Boolean>, FI<"DimensionNames", PrefixedArray<Identifier>>, FI<"MaxPlayers", VarInt>, FI<"ViewDistance", VarInt>,
@@ -169,12 +279,15 @@ namespace minecraft::protocol {
                 62, FI<"EntityID", VarInt>, FI<"UUID", UUID>, FI<"Type", VarInt>, FI<"X", Double>, FI<"Y", Double>, FI<"Z", Double>, FI<"Pitch", Angle>, FI<"Yaw", Angle>, FI<"HeadYaw", Angle>,
                 FI<"Data", VarInt>, FI<"VelocityX", Short>, FI<"VelocityY", Short>, FI<"VelocityZ", Short>>;
 
+            // 0x40
+            using RemoveEntitiesPacketType = Package<64, FI<"EntityIDs", PrefixedArray<VarInt>>>;
+
             // 0x5D
             // using SetPassengersPacketType = Package<86, FI<"EntityID", VarInt>, FI<"PassengerCount", VarInt>, FI<"PPassengers", Array<VarInt>, "PassengerCount"_ns>>;
             // using SetEntityMetadataPacketType = Package<86, FI<"EntityID", VarInt>, FI<"Metadata", CompoundArray<Byte, VarInt, >>>;
 
-            // 0x47
-            using UpdateSectionBlocksPacketType = Package<88, FI<"ChunkSectionPostion", Long>, FI<"BlocksArraySize", VarInt>, FI<"Blocks", Array<VarLong>, "BlocksArraySize"_ns>>;
+            // 0x47 方块列表直接解码为段内下标，见 SectionBlocks
+            using UpdateSectionBlocksPacketType = Package<88, FI<"ChunkSectionPostion", Long>, FI<"BlocksArraySize", VarInt>, FI<"Blocks", SectionBlocks, "BlocksArraySize"_ns>>;
 
             // 0x3E
             using SynchronizePlayerPositionPacketType =
@@ -183,39 +296,131 @@ namespace minecraft::protocol {
             // 0x73
             using UpdateRecipesPacketType = Package<102, FI<"NumRecipes", VarInt>, FI<"Recipe", Array<Identifier>, "NumRecipes"_ns>>;
 
+            using Packets = PacketList<
+                SpawnEntityPacketType, SpawnExperienceOrbPacketType, ChangeDifficultyPacketType, DisconnectPacketType, UnloadChunkPacketType, KeepAlivePacketType, ChunkDataPacketType,
+                SetEntityVelocityPacketType, UpdateLightPacketType, LoginPacketType, SpawnPlayerPacketType, SpawnEntity2PacketType, RemoveEntitiesPacketType,
+                UpdateSectionBlocksPacketType, SynchronizePlayerPositionPacketType, UpdateRecipesPacketType>;
+
         }  // namespace play_step
     }  // namespace server_bound
 
-    /* ------------------------ OTHER ------------------------ */
-
-    namespace detail {
-        template<typename F>
-        void parseKnownPacket(State state, const std::vector<std::byte>& data, bool compress, const F& f);
+    template<>
+    struct ServerPacketList<State::STATUS> {
+        using type = server_bound::status_step::Packets;
+    };
 
-        template<typename F>
-        void parseHandshakePacket(int, const std::vector<std::byte>&, bool compress, const F&);
+    template<>
+    struct ServerPacketList<State::LOGIN> {
+        using type = server_bound::login_step::Packets;
+    };
 
-        template<typename F>
-        void parseStatusPacket(int id, const std::vector<std::byte>& data, bool compress, const F& f);
+    template<>
+    struct ServerPacketList<State::PLAY> {
+        using type = server_bound::play_step::Packets;
+    };
 
-        template<typename F>
-        void parseLoginPacket(int id, const std::vector<std::byte>& data, bool compress, const F& f);
+    /* ------------------------ OTHER ------------------------ */
 
-        template<typename F>
-        void parseConfigurationPacket(int id, const std::vector<std::byte>& data, bool compress, const F& f);
+    /**
+     * @if zh
+     * @brief 所有协议状态数据包列表的去重并集
+     * @tparam L 状态到数据包列表的映射（@c ServerPacketList 或 @c ClientPacketList）
+     *
+     * @else
+     * @brief Deduplicated union of the packet lists of every protocol state
+     * @tparam L Mapping from state to packet list (@c ServerPacketList or @c ClientPacketList)
+     *
+     * @endif
+     * */
+    template<template<State> typename L>
+    using AllPacketList = typename detail::AllPacketListImpl<L, std::make_index_sequence<minecraft::detail::enumMax<State>()>>::type;
 
-        template<typename F>
-        void parsePlayPacket(int id, const std::vector<std::byte>& data, bool compress, const F& f);
+    namespace detail {
+        /** @struct DispatchTable
+         *
+         * @if zh
+         * @brief 按（状态，数据包ID）索引的稠密跳转表
+         * @details 由 @a L 给出的各状态数据包列表在编译期生成，未登记的ID落到 @c parseUnknownPacket
+         * @tparam L 状态到数据包列表的映射（@c ServerPacketList 或 @c ClientPacketList）
+         * @tparam F 回调类型
+         * @tparam P 解码前调用的过滤谓词，返回false时跳过该帧
+         *
+         * @else
+         * @brief Dense jump table indexed by (state, packet id)
+         * @details Generated at compile time from the per-state packet lists of @a L, unlisted ids fall back to @c parseUnknownPacket
+         * @tparam L Mapping from state to packet list (@c ServerPacketList or @c ClientPacketList)
+         * @tparam F Callback type
+         * @tparam P Filter predicate called before decoding, the frame is skipped when it returns false
+         *
+         * @endif
+         * */
+        template<template<State> typename L, typename F, typename P>
+        struct DispatchTable {
+            using Handler = void (*)(int, const std::vector<std::byte>&, bool, const F&, const P&);
+
+            static constexpr std::size_t states = minecraft::detail::enumMax<State>();
+
+            static constexpr std::size_t width = []<std::size_t... Ss>(std::index_sequence<Ss...>) {
+                return static_cast<std::size_t>(std::max({L<static_cast<State>(Ss)>::type::maxId...}) + 1);
+            }(std::make_index_sequence<states>{});
+
+            static void dispatch(State state, int id, const std::vector<std::byte>& data, bool compress, const F& f, const P& pred);
+
+        private:
+            template<is_package T>
+            static void decode(int id, const std::vector<std::byte>& data, bool compress, const F& f, const P& pred);
+
+            template<is_package... Ps>
+            static constexpr void fill(std::array<Handler, width>& row, PacketList<Ps...>);
+
+            static constexpr auto build();
+        };
+
+        template<typename F, typename P>
+        void parseKnownPacket(State state, const std::vector<std::byte>& data, bool compress, const F& f, const P& pred);
 
         template<typename F>
         void parseUnknownPacket(const std::vector<std::byte>& data, bool compress, const F& f);
     }  // namespace detail
 
+    /** @struct AcceptAll
+     *
+     * @if zh
+     * @brief 默认过滤谓词，解码所有帧
+     *
+     * @else
+     * @brief Default filter predicate, decodes every frame
+     *
+     * @endif
+     * */
+    struct AcceptAll {
+        template<is_package T>
+        constexpr bool operator()(std::type_identity<T>, int) const {
+            return true;
+        }
+    };
+
     template<typename F>
     void parsePacket(State state, const std::vector<std::byte>& data, bool compress, const F& f);
 
+    /**
+     * @if zh
+     * @brief 带订阅过滤的解析
+     * @details 先读取数据包ID，再以 @c pred(std::type_identity<T>{}, id) 询问是否需要该类型，返回false时不解压、不解码字段
+     *
+     * @else
+     * @brief Parse with a subscription filter
+     * @details The packet id is read first, then @c pred(std::type_identity<T>{}, id) decides whether the type is wanted;
+     * when it returns false the frame is neither inflated nor decoded
+     *
+     * @endif
+     * */
+    template<typename F, typename P>
+    void parsePacket(State state, const std::vector<std::byte>& data, bool compress, const F& f, const P& pred);
+
 }  // namespace minecraft::protocol
 
 #include "definition.hpp"
+#include "instantiation.h"
 
 #endif  // DEFINITION_H
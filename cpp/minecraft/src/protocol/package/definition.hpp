@@ -19,109 +19,66 @@
 
 #include "../type/varNum.h"
 #include "definition.h"
+#include "frame.h"
 
 namespace minecraft::protocol {
 
     namespace detail {
-        template<typename F>
-        void parseKnownPacket(const State state, const std::vector<std::byte>& data, bool compress, const F& f) {
-            auto dataPtr = data.data();
-            std::vector<std::byte> decompressedData;
+        template<typename F, typename P>
+        void parseKnownPacket(const State state, const std::vector<std::byte>& data, bool compress, const F& f, const P& pred) {
+            DispatchTable<ServerPacketList, F, P>::dispatch(state, peekPacketId(data, compress), data, compress, f, pred);
+        }
 
-            if (compress) {
-                auto [packetLen, packetLenShift] = parseVarInt<int>(dataPtr);
-                dataPtr += packetLenShift;
+        template<template<State> typename L, typename F, typename P>
+        void DispatchTable<L, F, P>::dispatch(const State state, const int id, const std::vector<std::byte>& data, bool compress, const F& f, const P& pred) {
+            static constexpr auto table = build();
 
-                auto [dataLen, dataLenShift] = parseVarInt<int>(dataPtr);
-                dataPtr += dataLenShift;
-                packetLen -= dataLenShift;
+            if (id < 0 || static_cast<std::size_t>(id) >= width) return decode<Package<>>(id, data, compress, f, pred);
 
-                const auto dataVec = std::vector(dataPtr, dataPtr + packetLen);
-                if (dataLen) {
-#ifdef DEBUG
-                    Debugger decompressDataDbg(&decompressData);
-                    decompressedData = decompressDataDbg(dataVec, dataLen);
-#else
-                    decompressedData = decompressData(dataVec, dataLen);
-#endif
+            table[static_cast<std::size_t>(state)][static_cast<std::size_t>(id)](id, data, compress, f, pred);
+        }
 
-                    dataPtr = decompressedData.data();
+        template<template<State> typename L, typename F, typename P>
+        template<is_package T>
+        void DispatchTable<L, F, P>::decode(const int id, const std::vector<std::byte>& data, bool compress, const F& f, const P& pred) {
+            if (!pred(std::type_identity<T>{}, id)) return;
 
-                    if (dataPtr == nullptr)
-                        throw std::runtime_error("Decompression failed");
+#ifdef DEBUG
+            // 调试构建中解码失败退回未知数据包；只包住解码，回调抛出的异常照常向上传播
+            if constexpr (!std::is_same_v<T, Package<>>) {
+                std::optional<T> packet;
+
+                try {
+                    packet.emplace(T::deserialize(data.data(), compress));
+                } catch (const std::exception& e) {
+                    traceError(e);
                 }
 
-            } else {
-                auto [dataLen, dataLenShift] = parseVarInt<int>(dataPtr);
-                dataPtr += dataLenShift;
-            }
+                if (!packet) return parseUnknownPacket(data, compress, f);
 
-            auto [id, idShift] = parseVarInt<int>(dataPtr);
-
-            switch (state) {
-                using enum State;
-                case HANDSHAKE: parseHandshakePacket<F>(id, data, compress, f); break;
-                case STATUS: parseStatusPacket<F>(id, data, compress, f); break;
-                case LOGIN: parseLoginPacket<F>(id, data, compress, f); break;
-                case CONFIGURATION: parseConfigurationPacket<F>(id, data, compress, f); break;
-                case PLAY: parsePlayPacket<F>(id, data, compress, f); break;
+                f(std::move(*packet));
+                return;
             }
-        }
+#endif
 
-        template<typename F>
-        void parseHandshakePacket(int, const std::vector<std::byte>& data, bool compress, const F& f) {
-            parseUnknownPacket(data, compress, f);
+            f(T::deserialize(data.data(), compress));
         }
 
-        template<typename F>
-        void parseStatusPacket(const int id, const std::vector<std::byte>& data, bool compress, const F& f) {
-            using namespace server_bound::status_step;
+        template<template<State> typename L, typename F, typename P>
+        template<is_package... Ps>
+        constexpr void DispatchTable<L, F, P>::fill(std::array<Handler, width>& row, PacketList<Ps...>) {
+            row.fill(&decode<Package<>>);
 
-            switch (id) {
-                case 0x00: f(ResponsePacketType::deserialize(data.data(), compress)); break;
-                case 0x01: f(PongPacketType::deserialize(data.data(), compress)); break;
-                default: parseUnknownPacket(data, compress, f);
-            }
+            ((row[Ps::id] == &decode<Package<>> ? void(row[Ps::id] = &decode<Ps>) : throw std::logic_error("Duplicate packet id in PacketList")), ...);
         }
 
-        template<typename F>
-        void parseLoginPacket(const int id, const std::vector<std::byte>& data, bool compress, const F& f) {
-            using namespace server_bound::login_step;
-
-            switch (id) {
-                case 0x00: f(DisconnectPacketType::deserialize(data.data(), compress)); break;
-                case 0x01: f(EncryptionRequestPacketType::deserialize(data.data(), compress)); break;
-                case 0x02: f(LoginSuccessPacketType::deserialize(data.data(), compress)); break;
-                case 0x03: f(CompressionPacketType::deserialize(data.data(), compress)); break;
-                case 0x04: f(PluginRequestPacketType::deserialize(data.data(), compress)); break;
-                default: parseUnknownPacket(data, compress, f);
-            }
-        }
+        template<template<State> typename L, typename F, typename P>
+        constexpr auto DispatchTable<L, F, P>::build() {
+            std::array<std::array<Handler, width>, states> table{};
 
-        template<typename F>
-        void parseConfigurationPacket(const int id, const std::vector<std::byte>& data, bool compress, const F& f) {
-        }
+            [&]<std::size_t... Ss>(std::index_sequence<Ss...>) { (fill(table[Ss], typename L<static_cast<State>(Ss)>::type{}), ...); }(std::make_index_sequence<states>{});
 
-        template<typename F>
-        void parsePlayPacket(const int id, const std::vector<std::byte>& data, bool compress, const F& f) {
-            using namespace server_bound::play_step;
-
-            switch (id) {
-                case 0x00: f(SpawnEntityPacketType::deserialize(data.data(), compress)); break;
-                case 0x01: f(SpawnExperienceOrbPacketType::deserialize(data.data(), compress)); break;
-                case 0x0B: f(ChangeDifficultyPacketType::deserialize(data.data(), compress)); break;
-                case 0x1B: f(DisconnectPacketType::deserialize(data.data(), compress)); break;
-                case 0x24: f(KeepAlivePacketType::deserialize(data.data(), compress)); break;
-                case 0x26: f(SetEntityVelocityPacketType::deserialize(data.data(), compress)); break;
-                case 0x29: f(LoginPacketType::deserialize(data.data(), compress)); break;
-                case 0x3C: f(SpawnPlayerPacketType::deserialize(data.data(), compress)); break;
-                case 0x3E: f(SpawnEntity2PacketType::deserialize(data.data(), compress)); break;
-                // case 0x56: f(SetPassengersPacketType::deserialize(data.data(), compress)); break;
-                case 0x58: f(UpdateSectionBlocksPacketType::deserialize(data.data(), compress)); break;
-                case 0x62: f(SynchronizePlayerPositionPacketType::deserialize(data.data(), compress)); break;
-                case 0x66: f(UpdateRecipesPacketType::deserialize(data.data(), compress)); break;
-                default: parseUnknownPacket(data, compress, f);
-            }
+            return table;
         }
 
         template<typename F>
@@ -133,14 +90,14 @@ namespace minecraft::protocol {
 
     template<typename F>
     void parsePacket(const State state, const std::vector<std::byte>& data, bool compress, const F& f) {
-#ifdef DEBUG
-        Debugger parseKnownPacketDbg(&detail::parseKnownPacket<F>, [&](const auto& e) {
-            detail::parseUnknownPacket(data, compress, f);
-        });
-        parseKnownPacketDbg(state, data, compress, f);
-#else
-        detail::parseKnownPacket<F>(state, data, compress, f);
-#endif
+        parsePacket(state, data, compress, f, AcceptAll{});
+    }
+
+    template<typename F, typename P>
+    void parsePacket(const State state, const std::vector<std::byte>& data, bool compress, const F& f, const P& pred) {
+        TraceSpan span("parsePacket", static_cast<std::int64_t>(state));
+
+        detail::parseKnownPacket<F, P>(state, data, compress, f, pred);
     }
 
 }  // namespace minecraft::protocol
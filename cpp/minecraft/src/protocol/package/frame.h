@@ -0,0 +1,134 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file frame.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 14:30
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef FRAME_H
+#define FRAME_H
+#pragma once
+
+#include "../type/varNum.h"
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace minecraft::protocol {
+
+    /**
+     * @if zh
+     * @brief 协议允许的最大帧长度（3字节VarInt可表示的最大值）
+     *
+     * @else
+     * @brief Largest frame length allowed by the protocol (maximum value of a 3-byte VarInt)
+     *
+     * @endif
+     * */
+    inline constexpr int MAX_FRAME_LENGTH = 2097151;
+
+    /** @class FrameReader
+     *
+     * @if zh
+     * @brief TCP字节流分帧器
+     * @details
+     * - 将任意切分的接收数据按外层“数据包长度”VarInt拼接为完整帧
+     * - 输出的帧包含长度前缀，可直接交给 @c Package::deserialize
+     * - 内部缓冲区与输出帧均复用，预热后不再分配
+     *
+     * @else
+     * @brief Framer for the TCP byte stream
+     * @details
+     * - Reassembles arbitrarily split input into complete frames using the outer "Packet Length" VarInt
+     * - Emitted frames keep the length prefix so they can be handed to @c Package::deserialize directly
+     * - Both the internal buffer and the output frame are reused, no allocation after warm-up
+     *
+     * @endif
+     * */
+    class FrameReader {
+    public:
+        void feed(const std::byte* data, std::size_t size);
+
+        bool next(std::vector<std::byte>& frame);
+
+        [[nodiscard]] std::size_t buffered() const;
+
+    private:
+        std::vector<std::byte> buffer;
+
+        std::size_t offset = 0;
+    };
+
+    namespace detail {
+        std::optional<std::pair<int, int>> tryParseVarInt(const std::byte* data, std::size_t size);
+    }  // namespace detail
+
+    /**
+     * @if zh
+     * @brief 读取帧中的数据包ID而不解码字段
+     * @details 压缩帧只解压ID所在的前几个字节
+     *
+     * @else
+     * @brief Read the packet id of a frame without decoding any field
+     * @details For compressed frames only the few bytes holding the id are inflated
+     *
+     * @endif
+     * */
+    int peekPacketId(const std::vector<std::byte>& frame, bool compress);
+
+    /**
+     * @if zh
+     * @brief 读取帧中数据包ID与字段解压后的总字节数，不解压
+     * @details 压缩帧取外层的“数据长度”字段，低于阈值未压缩的帧取剩余长度
+     *
+     * @else
+     * @brief Uncompressed size of the packet id and fields of a frame, without inflating
+     * @details Compressed frames report their outer "Data Length" field, frames sent below the threshold report the remaining length
+     *
+     * @endif
+     * */
+    std::size_t uncompressedSize(const std::vector<std::byte>& frame, bool compress);
+
+    /**
+     * @if zh
+     * @brief 数据包字段区预读窗口的大小
+     * @details 压缩帧只解压这么多字节用于预过滤，超出窗口的字段视为无法判断
+     *
+     * @else
+     * @brief Size of the window used to peek at the field bytes of a packet
+     * @details Compressed frames only inflate this many bytes for prefiltering, fields past the window are treated as undecidable
+     *
+     * @endif
+     * */
+    inline constexpr std::size_t PEEK_WINDOW = 256;
+
+    /**
+     * @if zh
+     * @brief 取得帧中数据包ID之后的原始字段字节
+     * @details 未压缩帧直接引用帧内存；压缩帧解压最多 @c PEEK_WINDOW 字节到 @p scratch 并引用之，结果可能被截断
+     *
+     * @else
+     * @brief Get the raw field bytes following the packet id of a frame
+     * @details Uncompressed frames are referenced in place; compressed frames inflate at most @c PEEK_WINDOW bytes into
+     * @p scratch and reference that, so the result may be truncated
+     *
+     * @endif
+     * */
+    std::span<const std::byte> peekPacketBody(const std::vector<std::byte>& frame, bool compress, std::array<std::byte, PEEK_WINDOW>& scratch);
+
+}  // namespace minecraft::protocol
+
+#include "frame.hpp"
+
+#endif  // FRAME_H
@@ -0,0 +1,140 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file frame.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 14:30
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef FRAME_HPP
+#define FRAME_HPP
+#pragma once
+
+#include "../../utils/utils.h"
+#include "../type/str.h"
+#include <array>
+#include <stdexcept>
+
+namespace minecraft::protocol {
+
+    namespace detail {
+        inline std::optional<std::pair<int, int>> tryParseVarInt(const std::byte* data, const std::size_t size) {
+            std::uint32_t value = 0;
+
+            for (std::size_t i = 0; i < size && i < 5; ++i) {
+                value |= static_cast<std::uint32_t>(data[i] & SEGMENT_BITS<std::byte>) << (7 * i);
+
+                if ((data[i] & CONTINUE_BIT<std::byte>) == std::byte{0}) return std::pair{static_cast<int>(value), static_cast<int>(i + 1)};
+            }
+
+            if (size >= 5) throw std::runtime_error("VarInt is too long");
+
+            return std::nullopt;
+        }
+    }  // namespace detail
+
+    inline void FrameReader::feed(const std::byte* data, const std::size_t size) {
+        // 已消费部分超过一半时整体前移，避免缓冲区无限增长
+        if (offset > 0 && offset * 2 >= buffer.size()) {
+            buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+            offset = 0;
+        }
+
+        buffer.insert(buffer.end(), data, data + size);
+    }
+
+    inline bool FrameReader::next(std::vector<std::byte>& frame) {
+        const auto available = buffer.size() - offset;
+
+        const auto header = detail::tryParseVarInt(buffer.data() + offset, available);
+
+        if (!header) return false;
+
+        const auto [length, shift] = *header;
+
+        if (length < 0 || length > MAX_FRAME_LENGTH) throw std::runtime_error("Frame length out of range");
+
+        const auto total = static_cast<std::size_t>(shift) + static_cast<std::size_t>(length);
+
+        if (available < total) return false;
+
+        frame.assign(buffer.begin() + static_cast<std::ptrdiff_t>(offset), buffer.begin() + static_cast<std::ptrdiff_t>(offset + total));
+        offset += total;
+
+        if (offset == buffer.size()) {
+            buffer.clear();
+            offset = 0;
+        }
+
+        return true;
+    }
+
+    inline std::size_t FrameReader::buffered() const { return buffer.size() - offset; }
+
+    inline int peekPacketId(const std::vector<std::byte>& frame, const bool compress) {
+        auto dataPtr = frame.data();
+
+        auto [packetLen, packetLenShift] = parseVarInt<int>(dataPtr);
+        dataPtr += packetLenShift;
+
+        if (!compress) return parseVarInt<int>(dataPtr).first;
+
+        auto [dataLen, dataLenShift] = parseVarInt<int>(dataPtr);
+        dataPtr += dataLenShift;
+        packetLen -= dataLenShift;
+
+        if (dataLen == 0) return parseVarInt<int>(dataPtr).first;
+
+        // ID最多5字节，只解压这一段
+        std::array<std::byte, 5> head{};
+
+        inflatePrefix(dataPtr, static_cast<std::size_t>(packetLen), head.data(), std::min<std::size_t>(head.size(), static_cast<std::size_t>(dataLen)));
+
+        return parseVarInt<int>(head.data()).first;
+    }
+
+    inline std::size_t uncompressedSize(const std::vector<std::byte>& frame, const bool compress) {
+        const auto [packetLen, packetLenShift] = parseVarInt<int>(frame.data());
+
+        if (!compress) return static_cast<std::size_t>(packetLen);
+
+        const auto [dataLen, dataLenShift] = parseVarInt<int>(frame.data() + packetLenShift);
+
+        return static_cast<std::size_t>(dataLen == 0 ? packetLen - dataLenShift : dataLen);
+    }
+
+    inline std::span<const std::byte> peekPacketBody(const std::vector<std::byte>& frame, const bool compress, std::array<std::byte, PEEK_WINDOW>& scratch) {
+        auto dataPtr = frame.data();
+        auto end     = frame.data() + frame.size();
+
+        dataPtr += parseVarInt<int>(dataPtr).second;
+
+        if (compress) {
+            auto [dataLen, dataLenShift] = parseVarInt<int>(dataPtr);
+            dataPtr += dataLenShift;
+
+            if (dataLen != 0) {
+                const auto inflated = inflatePrefix(dataPtr, static_cast<std::size_t>(end - dataPtr), scratch.data(), std::min<std::size_t>(scratch.size(), static_cast<std::size_t>(dataLen)));
+
+                dataPtr = scratch.data();
+                end     = scratch.data() + inflated;
+            }
+        }
+
+        const auto id = detail::tryParseVarInt(dataPtr, static_cast<std::size_t>(end - dataPtr));
+
+        if (!id) return {};
+
+        return {dataPtr + id->second, end};
+    }
+
+}  // namespace minecraft::protocol
+
+#endif  // FRAME_HPP
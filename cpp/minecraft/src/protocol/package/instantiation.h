@@ -0,0 +1,115 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file instantiation.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 04:10
+ * @brief Explicit instantiation of the packet set, so translation units including client.h stop re-instantiating every codec
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef INSTANTIATION_H
+#define INSTANTIATION_H
+#pragma once
+
+#include "definition.h"
+
+/**
+ * @if zh
+ * @brief 所有数据包列表中互不相同的数据包类型
+ * @details
+ * - 同一类型只能出现一次（显式实例化定义不可重复），例如服务端的 @c PongPacketType 与客户端状态阶段的 @c PingPacketType 是同一类型，只列出后者
+ * - packets.cpp 以静态断言检查本列表与两个方向全部数据包列表的并集一致，新增数据包时遗漏会编译失败
+ *
+ * @else
+ * @brief Distinct packet types of every packet list
+ * @details
+ * - A type may appear only once (explicit instantiation definitions cannot repeat), e.g. the server's @c PongPacketType is the same type as
+ *   the client's status @c PingPacketType, so only the latter is listed
+ * - packets.cpp statically asserts that this list equals the union of every packet list of both directions, forgetting a new packet fails the build
+ *
+ * @endif
+ * */
+#define MC_PROTOCOL_PACKET_TYPES(X)                                                                                                                                                                    \
+    X(minecraft::protocol::client_bound::handshake_step::HandShakePacketType)                                                                                                                          \
+    X(minecraft::protocol::client_bound::handshake_step::PingPacketType)                                                                                                                               \
+    X(minecraft::protocol::client_bound::status_step::RequestPacketType)                                                                                                                               \
+    X(minecraft::protocol::client_bound::status_step::PingPacketType)                                                                                                                                  \
+    X(minecraft::protocol::client_bound::configuration_step::FinishConfigurationPacketType)                                                                                                            \
+    X(minecraft::protocol::client_bound::login_step::LoginStartPacketType)                                                                                                                             \
+    X(minecraft::protocol::client_bound::login_step::EncryptionResponsePacketType)                                                                                                                     \
+    X(minecraft::protocol::client_bound::login_step::LoginPluginRequestPacketType)                                                                                                                     \
+    X(minecraft::protocol::client_bound::login_step::LoginConfirmPacketType)                                                                                                                           \
+    X(minecraft::protocol::client_bound::play_step::TeleportConfirmPacketType)                                                                                                                         \
+    X(minecraft::protocol::client_bound::play_step::KeepAlivePacketType)                                                                                                                               \
+    X(minecraft::protocol::client_bound::play_step::SetPlayerPositionPacketType)                                                                                                                       \
+    X(minecraft::protocol::server_bound::status_step::ResponsePacketType)                                                                                                                              \
+    X(minecraft::protocol::server_bound::login_step::DisconnectPacketType)                                                                                                                             \
+    X(minecraft::protocol::server_bound::login_step::EncryptionRequestPacketType)                                                                                                                      \
+    X(minecraft::protocol::server_bound::login_step::LoginSuccessPacketType)                                                                                                                           \
+    X(minecraft::protocol::server_bound::login_step::CompressionPacketType)                                                                                                                            \
+    X(minecraft::protocol::server_bound::login_step::PluginRequestPacketType)                                                                                                                          \
+    X(minecraft::protocol::server_bound::play_step::SpawnEntityPacketType)                                                                                                                             \
+    X(minecraft::protocol::server_bound::play_step::SpawnExperienceOrbPacketType)                                                                                                                      \
+    X(minecraft::protocol::server_bound::play_step::ChangeDifficultyPacketType)                                                                                                                        \
+    X(minecraft::protocol::server_bound::play_step::DisconnectPacketType)                                                                                                                              \
+    X(minecraft::protocol::server_bound::play_step::UnloadChunkPacketType)                                                                                                                             \
+    X(minecraft::protocol::server_bound::play_step::KeepAlivePacketType)                                                                                                                               \
+    X(minecraft::protocol::server_bound::play_step::ChunkDataPacketType)                                                                                                                               \
+    X(minecraft::protocol::server_bound::play_step::SetEntityVelocityPacketType)                                                                                                                       \
+    X(minecraft::protocol::server_bound::play_step::UpdateLightPacketType)                                                                                                                             \
+    X(minecraft::protocol::server_bound::play_step::LoginPacketType)                                                                                                                                   \
+    X(minecraft::protocol::server_bound::play_step::SpawnPlayerPacketType)                                                                                                                             \
+    X(minecraft::protocol::server_bound::play_step::SpawnEntity2PacketType)                                                                                                                            \
+    X(minecraft::protocol::server_bound::play_step::RemoveEntitiesPacketType)                                                                                                                          \
+    X(minecraft::protocol::server_bound::play_step::UpdateSectionBlocksPacketType)                                                                                                                     \
+    X(minecraft::protocol::server_bound::play_step::SynchronizePlayerPositionPacketType)                                                                                                               \
+    X(minecraft::protocol::server_bound::play_step::UpdateRecipesPacketType)
+
+/**
+ * @if zh
+ * @brief 一个数据包类型中被显式实例化的成员
+ * @details 只包含返回类型确定的非内联成员：返回 @c auto 的 @c serialize / @c deserialize 很薄，由它们调用的编解码实现才是实例化的主要开销
+ *
+ * @else
+ * @brief Members of one packet type that are explicitly instantiated
+ * @details Only non-inline members with a spelled-out return type: @c serialize / @c deserialize return @c auto and are thin,
+ * the codec implementations they call are where the instantiation cost lies
+ *
+ * @endif
+ * */
+#define MC_PROTOCOL_PACKET_MEMBERS(PREFIX, T)                                                                                                                                                          \
+    PREFIX template std::vector<std::byte> T::compressSerializeImpl(int, const minecraft::protocol::CompressionPolicy&, minecraft::protocol::CompressionStats*) const;                                 \
+    PREFIX template std::vector<std::byte> T::uncompressSerializeImpl() const;                                                                                                                         \
+    PREFIX template T T::compressDeserializeImpl(const std::byte*);                                                                                                                                    \
+    PREFIX template T T::uncompressDeserializeImpl(const std::byte*);                                                                                                                                  \
+    PREFIX template std::string T::toString() const;                                                                                                                                                   \
+    PREFIX template std::string T::toHexString() const;
+
+#define MC_PROTOCOL_EXTERN_PACKET(T) MC_PROTOCOL_PACKET_MEMBERS(extern, T)
+
+#define MC_PROTOCOL_INSTANTIATE_PACKET(T) MC_PROTOCOL_PACKET_MEMBERS(, T)
+
+#define MC_PROTOCOL_LIST_PACKET(T) , T
+
+namespace minecraft::protocol::detail {
+    // 宏展开出的列表以逗号开头，用一个占位类型吸收
+    template<typename, is_package... Ps>
+    struct SkipFirst {
+        using type = PacketList<Ps...>;
+    };
+
+    using InstantiatedPackets = SkipFirst<void MC_PROTOCOL_PACKET_TYPES(MC_PROTOCOL_LIST_PACKET)>::type;
+}  // namespace minecraft::protocol::detail
+
+// 定义了MC_PROTOCOL_EXTERN_PACKETS时由链接的packets.cpp提供实例，包含者只做声明
+#ifdef MC_PROTOCOL_EXTERN_PACKETS
+MC_PROTOCOL_PACKET_TYPES(MC_PROTOCOL_EXTERN_PACKET)
+#endif
+
+#endif  // INSTANTIATION_H
@@ -0,0 +1,110 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file layout.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 16:35
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef LAYOUT_H
+#define LAYOUT_H
+#pragma once
+
+#include "frame.h"
+#include "package.h"
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace minecraft::protocol {
+
+    namespace detail {
+        template<typename T>
+        struct RawWidth : std::integral_constant<std::size_t, 0> {};
+
+        template<is_integer_field T>
+        struct RawWidth<T> : std::integral_constant<std::size_t, sizeof(typename T::type)> {};
+
+        template<>
+        struct RawWidth<Boolean> : std::integral_constant<std::size_t, 1> {};
+
+        template<>
+        struct RawWidth<Angle> : std::integral_constant<std::size_t, 1> {};
+
+        template<>
+        struct RawWidth<Float> : std::integral_constant<std::size_t, 4> {};
+
+        template<>
+        struct RawWidth<Double> : std::integral_constant<std::size_t, 8> {};
+
+        template<>
+        struct RawWidth<Position> : std::integral_constant<std::size_t, 8> {};
+
+        template<>
+        struct RawWidth<UUID> : std::integral_constant<std::size_t, 16> {};
+
+        // 可在原始字节上跳过的字段：定长、VarNum以及VarInt长度前缀的字符串
+        template<typename T>
+        concept is_raw_skippable = RawWidth<T>::value > 0 || is_var_num_field<T> || is_string_field<T> || is_identifier_field<T>;
+
+        // 可在原始字节上读出为整数的字段
+        template<typename T>
+        concept is_raw_readable = is_integer_field<T> || is_var_num_field<T> || is_boolean_field<T> || is_angle_field<T>;
+
+        template<is_raw_skippable T>
+        bool skipRaw(const std::byte*& data, const std::byte* end);
+
+        template<is_raw_readable T>
+        std::optional<std::int64_t> readRaw(const std::byte* data, const std::byte* end);
+    }  // namespace detail
+
+    /** @struct FieldLayout
+     *
+     * @if zh
+     * @brief 数据包中某字段在原始字节上的位置
+     * @details
+     * - 目标字段之前的字段全部可跳过且目标字段为整数类字段时 @c readable 为true
+     * - @c read 按字段顺序跳过前面的字段后只解码目标字段，字节不足时返回空
+     *
+     * @else
+     * @brief Position of a field of a packet within the raw bytes
+     * @details
+     * - @c readable is true when every preceding field can be skipped and the target field is integer-like
+     * - @c read skips the preceding fields in order and decodes only the target one, it returns empty when the bytes run out
+     *
+     * @endif
+     * */
+    template<FStrChar V, typename T>
+    struct FieldLayout {
+        static constexpr bool readable = false;
+    };
+
+    template<FStrChar V, int I, is_field_item... Ts>
+    struct FieldLayout<V, Package<I, Ts...>> {
+    private:
+        using Types = std::tuple<typename Ts::type...>;
+
+        static constexpr int index = indexOfName_v<V, Ts...>;
+
+        static constexpr bool prefixSkippable();
+
+        static constexpr bool targetReadable();
+
+    public:
+        static constexpr bool readable = prefixSkippable() && targetReadable();
+
+        static std::optional<std::int64_t> read(std::span<const std::byte> body);
+    };
+
+}  // namespace minecraft::protocol
+
+#include "layout.hpp"
+
+#endif  // LAYOUT_H
@@ -0,0 +1,110 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file layout.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 16:35
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef LAYOUT_HPP
+#define LAYOUT_HPP
+#pragma once
+
+namespace minecraft::protocol {
+
+    namespace detail {
+        template<is_var_num_field T>
+        std::size_t rawVarNumWidth(const std::byte* data, const std::byte* end) {
+            constexpr std::size_t maxWidth = (sizeof(typename T::type) * 8 + 6) / 7;
+
+            for (std::size_t i = 0; i < maxWidth && data + i < end; ++i)
+                if ((data[i] & CONTINUE_BIT<std::byte>) == std::byte{0}) return i + 1;
+
+            return 0;
+        }
+
+        template<is_raw_skippable T>
+        bool skipRaw(const std::byte*& data, const std::byte* end) {
+            if constexpr (RawWidth<T>::value > 0) {
+                if (static_cast<std::size_t>(end - data) < RawWidth<T>::value) return false;
+
+                data += RawWidth<T>::value;
+            }
+
+            else if constexpr (is_var_num_field<T>) {
+                const auto width = rawVarNumWidth<T>(data, end);
+
+                if (width == 0) return false;
+
+                data += width;
+            }
+
+            else {
+                const auto length = tryParseVarInt(data, static_cast<std::size_t>(end - data));
+
+                if (!length || length->first < 0 || end - data - length->second < length->first) return false;
+
+                data += length->second + length->first;
+            }
+
+            return true;
+        }
+
+        template<is_raw_readable T>
+        std::optional<std::int64_t> readRaw(const std::byte* data, const std::byte* end) {
+            if constexpr (is_var_num_field<T>) {
+                if (rawVarNumWidth<T>(data, end) == 0) return std::nullopt;
+            }
+
+            else if (static_cast<std::size_t>(end - data) < RawWidth<T>::value)
+                return std::nullopt;
+
+            return static_cast<std::int64_t>(T::decode(data).value());
+        }
+    }  // namespace detail
+
+    template<FStrChar V, int I, is_field_item... Ts>
+    constexpr bool FieldLayout<V, Package<I, Ts...>>::prefixSkippable() {
+        if constexpr (index < 0)
+            return false;
+        else
+            return []<std::size_t... K>(std::index_sequence<K...>) {
+                return (detail::is_raw_skippable<std::tuple_element_t<K, Types>> && ...);
+            }(std::make_index_sequence<static_cast<std::size_t>(index)>{});
+    }
+
+    template<FStrChar V, int I, is_field_item... Ts>
+    constexpr bool FieldLayout<V, Package<I, Ts...>>::targetReadable() {
+        if constexpr (index < 0)
+            return false;
+        else
+            return detail::is_raw_readable<std::tuple_element_t<index, Types>>;
+    }
+
+    template<FStrChar V, int I, is_field_item... Ts>
+    std::optional<std::int64_t> FieldLayout<V, Package<I, Ts...>>::read(std::span<const std::byte> body) {
+        static_assert(readable, "Field cannot be read from raw bytes");
+
+        auto data       = body.data();
+        const auto* end = body.data() + body.size();
+
+        // 逐个跳过前置字段，字段偏移在编译期展开为定长步进与VarNum扫描
+        const bool reached = [&]<std::size_t... K>(std::index_sequence<K...>) {
+            return (detail::skipRaw<std::tuple_element_t<K, Types>>(data, end) && ...);
+        }(std::make_index_sequence<static_cast<std::size_t>(index)>{});
+
+        if (!reached) return std::nullopt;
+
+        return detail::readRaw<std::tuple_element_t<index, Types>>(data, end);
+    }
+
+}  // namespace minecraft::protocol
+
+#endif  // LAYOUT_HPP
@@ -21,6 +21,7 @@
 #include "../../utils/nullable.h"
 #include "../type/angle.h"
 #include "../type/boolean.h"
+#include "../type/chunk.h"
 #include "../type/compoundArray.h"
 #include "../type/double.h"
 #include "../type/float.h"
@@ -33,6 +34,8 @@
 #include "../type/prefixedOption.h"
 #include "../type/str.h"
 #include "../type/varNum.h"
+#include "compression.h"
+#include <array>
 #include <optional>
 
 namespace minecraft::protocol {
@@ -53,7 +56,8 @@ namespace minecraft::protocol {
         template<typename T>
         concept is_builtin_field =
             is_boolean_field<T> || is_integer_field<T> || is_uuid_field<T> || is_string_field<T> || is_var_num_field<T> || is_array_field<T> || is_float_field<T> || is_double_field<T>
-            || is_angle_field<T> || is_position_field<T> || is_prefixed_array_field<T> || is_identifier_field<T> || is_option_field<T> || is_prefixed_option_field<T> || is_compound_array_field<T>;
+            || is_angle_field<T> || is_position_field<T> || is_prefixed_array_field<T> || is_identifier_field<T> || is_option_field<T> || is_prefixed_option_field<T> || is_compound_array_field<T>
+            || is_chunk_field<T>;
 
         template<typename T>
         concept is_custom_field = requires {
@@ -96,21 +100,22 @@ namespace minecraft::protocol {
     concept is_field_item = is_field_item_v<T>;
 
     namespace detail {
-        template<FStrChar V, std::size_t I, is_field_item T, is_field_item... Ts>
-        struct IndexOfNameImpl {
-            static constexpr int value = V == T::name ? I : IndexOfNameImpl<V, I + 1, Ts...>::value;
-        };
+        // 折叠表达式一次比较所有字段名，不再为每个位置递归实例化一个类模板
+        template<FStrChar V, is_field_item... Ts>
+        constexpr int indexOfNameImpl() {
+            constexpr std::array<bool, sizeof...(Ts)> matches{(V == Ts::name)...};
 
-        template<FStrChar V, std::size_t I, is_field_item T>
-        struct IndexOfNameImpl<V, I, T> {
-            static constexpr int value = V == T::name ? I : -1;
-        };
+            for (std::size_t i = 0; i < matches.size(); i++)
+                if (matches[i]) return static_cast<int>(i);
+
+            return -1;
+        }
 
     }  // namespace detail
 
     template<FStrChar V, is_field_item... Ts>
     struct indexOfName {
-        static constexpr int value = sizeof...(Ts) == 0 ? -1 : detail::IndexOfNameImpl<V, 0, Ts...>::value;
+        static constexpr int value = detail::indexOfNameImpl<V, Ts...>();
     };
 
     template<FStrChar V, is_field_item... Ts>
@@ -165,7 +170,7 @@ namespace minecraft::protocol {
 
         detail::FieldMap<Ts...> fieldMap_;
 
-        std::vector<std::byte> compressSerializeImpl(int threshold) const;
+        std::vector<std::byte> compressSerializeImpl(int threshold, const CompressionPolicy& policy, CompressionStats* stats) const;
 
         std::vector<std::byte> uncompressSerializeImpl() const;
 
@@ -199,13 +204,47 @@ namespace minecraft::protocol {
         template<FStrChar V>
         auto get() const;
 
-        auto serialize(bool compressed = false, int threshold = 0) const;
+        /**
+         * @if zh
+         * @brief 按引用取字段，避免 @c get 对大字段（如区块数据）的复制
+         *
+         * @else
+         * @brief Get a field by reference, avoiding the copy @c get makes of large fields (such as chunk data)
+         *
+         * @endif
+         * */
+        template<FStrChar V>
+        const auto& field() const;
+
+        template<FStrChar V>
+        static constexpr bool hasField();
+
+        /**
+         * @if zh
+         * @brief 序列化为帧
+         * @param policy 压缩模式下的跳过策略
+         * @param stats 压缩统计，为空时不计数；由连接各自持有，不同连接的统计互不混合
+         *
+         * @else
+         * @brief Serialize into a frame
+         * @param policy Skip policy used in compressed mode
+         * @param stats Compression counters, nothing is counted when null; owned per connection so connections do not mix
+         *
+         * @endif
+         * */
+        auto serialize(bool compressed = false, int threshold = 0, const CompressionPolicy& policy = {}, CompressionStats* stats = nullptr) const;
 
         static auto deserialize(const std::byte* data, bool compressed = false);
 
         [[nodiscard]] std::string toString() const;
 
         [[nodiscard]] std::string toHexString() const;
+
+        template<typename OutputIt>
+        OutputIt formatTo(OutputIt out) const;
+
+        template<typename OutputIt>
+        OutputIt formatHexTo(OutputIt out) const;
     };
 
     // Unknown package
@@ -238,6 +277,12 @@ namespace minecraft::protocol {
         [[nodiscard]] std::string toString() const;
 
         [[nodiscard]] std::string toHexString() const;
+
+        template<typename OutputIt>
+        OutputIt formatTo(OutputIt out) const;
+
+        template<typename OutputIt>
+        OutputIt formatHexTo(OutputIt out) const;
     };
 
     Package(int, std::vector<std::byte>&&, std::size_t) -> Package<>;
@@ -257,6 +302,47 @@ namespace minecraft::protocol {
 }  // namespace minecraft::protocol
 
 namespace std {
+    /**
+     * @if zh
+     * @brief 字段类型与数据包的格式化器
+     * @details "{}" 输出可读表示，"{:x}" 输出十六进制表示，均直接写入格式化上下文
+     *
+     * @else
+     * @brief Formatter for field types and packets
+     * @details "{}" writes the human-readable form and "{:x}" the hexadecimal form, both straight into the format context
+     *
+     * @endif
+     * */
+    template<typename T>
+        requires minecraft::protocol::is_field<T> || minecraft::protocol::is_package<T>
+    struct formatter<T, char> {
+        bool hex = false;
+
+        constexpr auto parse(format_parse_context& ctx) {
+            auto it = ctx.begin();
+
+            if (it != ctx.end() && *it == 'x') {
+                hex = true;
+                ++it;
+            }
+
+            if (it != ctx.end() && *it != '}') throw format_error("invalid format spec for a protocol type");
+
+            return it;
+        }
+
+        template<typename Context>
+        auto format(const T& value, Context& ctx) const {
+            if (!hex) return minecraft::detail::formatValueTo(ctx.out(), value);
+
+            if constexpr (requires { value.formatHexTo(ctx.out()); })
+                return value.formatHexTo(ctx.out());
+
+            else
+                return minecraft::hexTo(ctx.out(), value.encode());
+        }
+    };
+
     template<int I, minecraft::protocol::is_field_item... Ts>
     struct tuple_size<minecraft::protocol::Package<I, Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)> {};
 
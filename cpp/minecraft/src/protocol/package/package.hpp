@@ -19,11 +19,12 @@
 
 #include "package.h"
 #include <iostream>
-#include <sstream>
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <span>
 
-#ifdef DEBUG
-    #include "../../utils/debugger.h"
-#endif
+#include "../../utils/tracer.h"
 
 /**
  * @if zh
@@ -72,7 +73,8 @@ namespace minecraft::protocol {
 
         template<typename T, typename F>
         constexpr decltype(auto) forEach(T&& tuple, F&& f) {
-            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            // 以引用返回，按值返回会复制整个字段元组（含各字段的编码缓存）
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) -> decltype(auto) {
                 (f(std::get<Is>(tuple)), ...);
                 return std::forward<T>(tuple);
             }(std::make_index_sequence<std::tuple_size_v<std::remove_reference_t<T>>>{});
@@ -156,16 +158,18 @@ namespace minecraft::protocol {
         data += dataLenShift;
         packetLen -= dataLenShift;
 
-        std::vector<std::byte> dataVec{data, data + packetLen};
+        std::vector<std::byte> dataVec;
         if (dataLen) {  // 判断是否启用压缩
-#ifdef DEBUG
-            Debugger decompressDataDbg(&decompressData);
-            dataVec = decompressDataDbg(dataVec, dataLen);
-#else
-            dataVec = decompressData(dataVec, dataLen);
-#endif
+            TraceSpan span("decompressData", dataLen);
+
+            dataVec = decompressData(data, static_cast<std::size_t>(packetLen), static_cast<std::size_t>(dataLen));
+
+            detail::inflateMark = std::chrono::steady_clock::now();
         }
 
+        else
+            dataVec.assign(data, data + packetLen);
+
         // 解析数据包ID
         auto [id, idShift] = parseVarInt<int>(dataVec.data());
 
@@ -204,27 +208,34 @@ namespace minecraft::protocol {
     inline auto Package<>::deserialize(const std::byte* data, bool compressed) { return compressed ? compressDeserializeImpl(data) : uncompressDeserializeImpl(data); }
 
     inline std::string Package<>::toString() const {
-        std::stringstream ss;
+        std::string result;
 
-        ss << "{ id: " << id_ << ", data: ";
+        result.reserve(size_ + 24);
 
-        for (std::size_t i{0}; i < size_; ++i)
-            if (const auto c = static_cast<unsigned char>(data_[i]); std::isprint(c))
-                ss << c;
-            else
-                ss << (i == 0 ? "" : " ") << "\\0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(data_[i]);
+        formatTo(std::back_inserter(result));
 
-        ss << " }";
-
-        return ss.str();
+        return result;
     }
 
     inline std::string Package<>::toHexString() const { return minecraft::toHexString(data_); }
 
+    template<typename OutputIt>
+    OutputIt Package<>::formatTo(OutputIt out) const {
+        out = std::format_to(out, "{{ id: {}, data: ", id_);
+        out = minecraft::escapeTo(out, std::span(data_).first(std::min(size_, data_.size())));
+
+        return std::ranges::copy(std::string_view(" }"), out).out;
+    }
+
+    template<typename OutputIt>
+    OutputIt Package<>::formatHexTo(OutputIt out) const {
+        return minecraft::hexTo(out, data_);
+    }
+
     // Fixed package
 
     template<int I, is_field_item... Ts>
-    std::vector<std::byte> Package<I, Ts...>::compressSerializeImpl(int threshold) const {
+    std::vector<std::byte> Package<I, Ts...>::compressSerializeImpl(int threshold, const CompressionPolicy& policy, CompressionStats* stats) const {
         std::vector<std::byte> data;
 
         auto idBytes = VarInt(I).encode();
@@ -239,13 +250,15 @@ namespace minecraft::protocol {
         std::vector<std::byte> cData;
         std::size_t cSize = 0;
 
-        // 大于阈值压缩
-        if (data.size() > threshold) {
-            cData = compressData(data);
-            cSize = cData.size();
+        // 大于阈值且抽样熵预测有收益时压缩
+        if (data.size() > threshold && detail::worthCompressing(data, policy, stats)) {
+            cData = detail::compressTracked(data, stats);
+
+            // 数据长度字段为压缩前的长度，接收方据此分配解压缓冲区
+            cSize = data.size();
         }
 
-        // 小于阈值不压缩
+        // 小于阈值或高熵数据不压缩
         else {
             cData = std::move(data);
             cSize = 0;
@@ -291,17 +304,17 @@ namespace minecraft::protocol {
         data += dataLenShift;
         packetLen -= dataLenShift;
 
-        std::vector<std::byte> dataVec{data, data + packetLen};
-        if (dataLen) {  // 判断是否启用压缩
-#ifdef DEBUG
-            Debugger decompressDataDbg(&decompressData);
-            dataVec = decompressDataDbg(dataVec, dataLen);
-#else
-            dataVec = decompressData(dataVec, dataLen);
-#endif
-        }
+        std::vector<std::byte> inflated;
+
+        // 低于阈值未压缩的数据原地解析，不复制
+        if (dataLen) {
+            TraceSpan span("decompressData", dataLen);
 
-        data = dataVec.data();
+            inflated = decompressData(data, static_cast<std::size_t>(packetLen), static_cast<std::size_t>(dataLen));
+            data     = inflated.data();
+
+            detail::inflateMark = std::chrono::steady_clock::now();
+        }
 
         // 解析数据包ID
         auto [id, idShift] = parseVarInt<int>(data);
@@ -309,6 +322,9 @@ namespace minecraft::protocol {
 
         if (id != I) throw std::runtime_error("PackageImpl ID mismatch after decompression.");
 
+        // 字段区长度，未压缩时数据长度字段为0，取帧内剩余长度
+        const auto bodyLen = static_cast<std::size_t>((dataLen ? dataLen : packetLen) - idShift);
+
         std::tuple<typename Ts::type...> fields{};
 
         std::size_t offset = 0;
@@ -321,7 +337,7 @@ namespace minecraft::protocol {
                 std::get<idx>(fields) = T::decode(data + offset);
 
             else if constexpr (*D == "__rest__")
-                std::get<idx>(fields) = T::decode(data + offset, dataLen - offset);
+                std::get<idx>(fields) = T::decode(data + offset, bodyLen - offset);
 
             else {
                 constexpr auto depIdx = indexOfName_v<*D, Ts...>;
@@ -330,14 +346,18 @@ namespace minecraft::protocol {
 
                 auto dep = std::get<static_cast<std::size_t>(depIdx)>(fields);
 
-                std::get<idx>(fields) = T::decode(data + offset, dep);
+                // 数量来自网络的字段可额外接收剩余字节数，据此做越界检查
+                if constexpr (requires { T::decode(data, dep, bodyLen); })
+                    std::get<idx>(fields) = T::decode(data + offset, dep, bodyLen - offset);
+                else
+                    std::get<idx>(fields) = T::decode(data + offset, dep);
             }
 
             offset += std::get<idx>(fields).size();
         });
 
-        // if (offset != dataVec.size() - idShift)
-        //     std::cerr << "Warning: [Package::deserialize] Package data mismatch after decompression. Expected " << dataVec.size() - idShift << " bytes, Actual: " << offset << " bytes." << std::endl;
+        // if (offset != bodyLen)
+        //     std::cerr << "Warning: [Package::deserialize] Package data mismatch after decompression. Expected " << bodyLen << " bytes, Actual: " << offset << " bytes." << std::endl;
 
         return Package(fields);
     }
@@ -374,7 +394,10 @@ namespace minecraft::protocol {
 
                 auto dep = std::get<static_cast<std::size_t>(depIdx)>(fields);
 
-                std::get<idx>(fields) = T::decode(data + offset, dep);
+                if constexpr (requires { T::decode(data, dep, std::size_t{}); })
+                    std::get<idx>(fields) = T::decode(data + offset, dep, static_cast<std::size_t>(len) - offset);
+                else
+                    std::get<idx>(fields) = T::decode(data + offset, dep);
             }
 
             offset += std::get<idx>(fields).size();
@@ -426,8 +449,24 @@ namespace minecraft::protocol {
     }
 
     template<int I, is_field_item... Ts>
-    auto Package<I, Ts...>::serialize(const bool compressed, const int threshold) const {
-        if (data_.empty()) data_ = compressed ? compressSerializeImpl(threshold) : uncompressSerializeImpl();
+    template<FStrChar V>
+    const auto& Package<I, Ts...>::field() const {
+        constexpr auto idx = indexOfName_v<V, Ts...>;
+
+        static_assert(idx != -1, "Field not found.");
+
+        return std::get<idx>(fields_);
+    }
+
+    template<int I, is_field_item... Ts>
+    template<FStrChar V>
+    constexpr bool Package<I, Ts...>::hasField() {
+        return indexOfName_v<V, Ts...> != -1;
+    }
+
+    template<int I, is_field_item... Ts>
+    auto Package<I, Ts...>::serialize(const bool compressed, const int threshold, const CompressionPolicy& policy, CompressionStats* stats) const {
+        if (data_.empty()) data_ = compressed ? compressSerializeImpl(threshold, policy, stats) : uncompressSerializeImpl();
 
         return data_;
     }
@@ -439,17 +478,11 @@ namespace minecraft::protocol {
 
     template<int I, is_field_item... Ts>
     std::string Package<I, Ts...>::toString() const {
-        std::stringstream ss;
+        std::string result;
 
-        ss << "{ id: " << id << ", ";
-
-        [&ss, this]<std::size_t... Is>(std::index_sequence<Is...>) {
-            (..., (ss << std::string_view(std::get<Is>(names).data.data(), std::get<Is>(names).size) << ": " << std::get<Is>(fields_).toString() << (Is < size - 1 ? ", " : "")));
-        }(std::make_index_sequence<size>{});
+        formatTo(std::back_inserter(result));
 
-        ss << " }";
-
-        return ss.str();
+        return result;
     }
 
     template<int I, is_field_item... Ts>
@@ -457,6 +490,30 @@ namespace minecraft::protocol {
         return minecraft::toHexString(data_);
     }
 
+    template<int I, is_field_item... Ts>
+    template<typename OutputIt>
+    OutputIt Package<I, Ts...>::formatTo(OutputIt out) const {
+        out = std::format_to(out, "{{ id: {}, ", id);
+
+        [&out, this]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (..., [&] {
+                if (Is != 0) out = std::ranges::copy(std::string_view(", "), out).out;
+
+                out = std::ranges::copy(std::string_view(std::get<Is>(names).data.data(), std::get<Is>(names).size), out).out;
+                out = std::ranges::copy(std::string_view(": "), out).out;
+                out = minecraft::detail::formatValueTo(out, std::get<Is>(fields_));
+            }());
+        }(std::make_index_sequence<size>{});
+
+        return std::ranges::copy(std::string_view(" }"), out).out;
+    }
+
+    template<int I, is_field_item... Ts>
+    template<typename OutputIt>
+    OutputIt Package<I, Ts...>::formatHexTo(OutputIt out) const {
+        return minecraft::hexTo(out, data_);
+    }
+
     // Unkown package
 
 
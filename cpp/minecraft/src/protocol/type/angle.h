@@ -277,6 +277,38 @@ namespace minecraft::protocol {
          */
         [[nodiscard]] std::string toHexString() const;
 
+        /**
+         * @if zh
+         * @brief 将可读表示写入输出迭代器，不构造临时字符串
+         * @details 格式与 @c toString 相同，如 "90° (64 steps)"
+         * @param out 输出迭代器
+         * @return 写入结束后的迭代器
+         *
+         * @else
+         * @brief Write the human-readable representation to an output iterator without building a temporary string
+         * @details Same format as @c toString, e.g. "90° (64 steps)"
+         * @param out Output iterator
+         * @return Iterator past the written characters
+         *
+         * @endif
+         */
+        template<typename OutputIt>
+        OutputIt formatTo(OutputIt out) const;
+
+        /**
+         * @if zh
+         * @brief 将十六进制表示写入输出迭代器
+         * @details 完整序列化数据，每字节形如"\\0xab"
+         *
+         * @else
+         * @brief Write the hexadecimal representation to an output iterator
+         * @details The complete serialized data, each byte as "\\0xab"
+         *
+         * @endif
+         */
+        template<typename OutputIt>
+        OutputIt formatHexTo(OutputIt out) const;
+
         /**
          * @if zh
          * @brief 转换为浮点角度值
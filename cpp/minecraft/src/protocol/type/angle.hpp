@@ -53,11 +53,25 @@ namespace minecraft::protocol {
     inline auto Angle::decode(const std::byte* data) { return Angle(static_cast<uint8_t>(data[0])); }
 
     inline std::string Angle::toString() const {
-        return std::format("{}° ({} steps)", toDegrees(), static_cast<int>(value_));
+        std::string result;
+
+        formatTo(std::back_inserter(result));
+
+        return result;
     }
 
     inline std::string Angle::toHexString() const { return minecraft::toHexString(encode()); }
 
+    template<typename OutputIt>
+    OutputIt Angle::formatTo(OutputIt out) const {
+        return std::format_to(out, "{}° ({} steps)", toDegrees(), static_cast<int>(value_));
+    }
+
+    template<typename OutputIt>
+    OutputIt Angle::formatHexTo(OutputIt out) const {
+        return minecraft::hexTo(out, encode());
+    }
+
     inline float Angle::toDegrees() const { return value_ * DEGREES_PER_STEP; }
 
     inline float Angle::toRadians() const { return toDegrees() * std::numbers::pi_v<float> / 180.0f; }
@@ -207,6 +207,38 @@ namespace minecraft::protocol {
          * @endif
          */
         [[nodiscard]] std::string toHexString() const;
+
+        /**
+         * @if zh
+         * @brief 将可读表示写入输出迭代器，不构造临时字符串
+         * @details "true"或"false"
+         * @param out 输出迭代器
+         * @return 写入结束后的迭代器
+         *
+         * @else
+         * @brief Write the human-readable representation to an output iterator without building a temporary string
+         * @details "true" or "false"
+         * @param out Output iterator
+         * @return Iterator past the written characters
+         *
+         * @endif
+         */
+        template<typename OutputIt>
+        OutputIt formatTo(OutputIt out) const;
+
+        /**
+         * @if zh
+         * @brief 将十六进制表示写入输出迭代器
+         * @details "0x00"或"0x01"
+         *
+         * @else
+         * @brief Write the hexadecimal representation to an output iterator
+         * @details "0x00" or "0x01"
+         *
+         * @endif
+         */
+        template<typename OutputIt>
+        OutputIt formatHexTo(OutputIt out) const;
     };
 
     /** @concept is_boolean_field
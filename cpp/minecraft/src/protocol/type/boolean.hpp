@@ -17,7 +17,9 @@
 #define BOOLEAN_HPP
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <string_view>
 
 namespace minecraft::protocol {
     inline Boolean::Boolean(const bool value)
@@ -39,6 +41,16 @@ namespace minecraft::protocol {
 
     inline std::string Boolean::toHexString() const { return value_ ? "0x01" : "0x00"; }
 
+    template<typename OutputIt>
+    OutputIt Boolean::formatTo(OutputIt out) const {
+        return std::ranges::copy(std::string_view(value_ ? "true" : "false"), out).out;
+    }
+
+    template<typename OutputIt>
+    OutputIt Boolean::formatHexTo(OutputIt out) const {
+        return std::ranges::copy(std::string_view(value_ ? "0x01" : "0x00"), out).out;
+    }
+
 }  // namespace minecraft::protocol
 
 #endif  // BOOLEAN_HPP
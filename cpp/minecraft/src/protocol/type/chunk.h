@@ -0,0 +1,506 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file chunk.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 05:10
+ * @brief Chunk column and light data fields, decoded into paletted sections that keep the packed wire form
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef CHUNK_H
+#define CHUNK_H
+#pragma once
+
+#include "varNum.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace minecraft::protocol {
+
+    namespace detail {
+        /** @struct ChunkReader
+         *
+         * @if zh
+         * @brief 带边界检查的区块数据读取游标
+         * @details 区块数据包含大量长度字段，越界或长度不合理时抛出 @c std::runtime_error，而不是读出缓冲区
+         *
+         * @else
+         * @brief Bounds-checked read cursor over chunk data
+         * @details Chunk data carries many length fields, an overrun or an implausible length throws @c std::runtime_error instead of reading past the buffer
+         *
+         * @endif
+         * */
+        struct ChunkReader {
+            const std::byte* pos;
+
+            const std::byte* end;
+
+            [[nodiscard]] std::size_t remaining() const;
+
+            void need(std::size_t n) const;
+
+            std::uint8_t u8();
+
+            std::int16_t i16();
+
+            std::uint16_t u16();
+
+            std::int32_t i32();
+
+            std::uint64_t u64();
+
+            std::int32_t varInt();
+
+            // 读取VarInt长度并检查不超过 @p limit
+            std::size_t length(std::size_t limit);
+
+            std::span<const std::byte> bytes(std::size_t n);
+
+            // 跳过网络NBT（1.20.2起根标签无名称）
+            void skipNbt();
+
+        private:
+            void skipNbtPayload(std::uint8_t tag, int depth);
+        };
+
+        void putVarInt(std::vector<std::byte>& out, std::int32_t value);
+
+        void putU64(std::vector<std::byte>& out, std::uint64_t value);
+
+        /** @struct PaletteIndex
+         *
+         * @if zh
+         * @brief 调色板ID到下标的开放寻址表，批量写入时在栈上建立
+         * @details 间接调色板至多256项（加上触发转为直接模式的一项），512个槽使负载不超过一半
+         *
+         * @else
+         * @brief Open-addressing table from palette id to index, built on the stack for a batched write
+         * @details An indirect palette has at most 256 entries (plus the one that triggers the switch to direct mode), 512 slots keep the load at most half
+         *
+         * @endif
+         * */
+        struct PaletteIndex {
+            static constexpr std::size_t SLOTS = 512;
+
+            explicit PaletteIndex(std::span<const std::int32_t> palette);
+
+            // 不存在时返回-1
+            [[nodiscard]] std::int32_t find(std::int32_t id) const;
+
+            void insert(std::int32_t id, std::int32_t index);
+
+        private:
+            std::array<std::int32_t, SLOTS> ids;
+
+            std::array<std::int16_t, SLOTS> indices;
+
+            [[nodiscard]] std::size_t slot(std::int32_t id) const;
+        };
+
+        using UnpackFn = void (*)(const std::uint64_t*, std::size_t, std::int32_t*);
+
+        template<unsigned Bits>
+        void unpackWords(const std::uint64_t* words, std::size_t entries, std::int32_t* out);
+    }  // namespace detail
+
+    /** @class PalettedContainer
+     *
+     * @if zh
+     * @brief 区块段中的调色板容器（方块状态或生物群系），保持网络上的压缩形式
+     * @details
+     * - 单值：每项位数为0，调色板只有一个值，不保存数据数组
+     * - 间接：数据数组保存调色板下标
+     * - 直接：调色板为空，数据数组直接保存全局ID
+     * - 自1.16起条目不跨越long，每个long容纳 64 / bits 个条目
+     * - 逐项读取用 @c get ，整段读取用 @c unpack ，后者按位宽选择展开的解包函数，便于编译器向量化
+     *
+     * @else
+     * @brief Paletted container of a chunk section (block states or biomes), kept in its packed wire form
+     * @details
+     * - Single value: zero bits per entry, a one-entry palette and no data array
+     * - Indirect: the data array holds palette indices
+     * - Direct: the palette is empty and the data array holds global ids
+     * - Since 1.16 entries never straddle longs, each long holds 64 / bits entries
+     * - @c get reads one entry, @c unpack a whole container through an unpacker unrolled for the bit width so the compiler can vectorize it
+     *
+     * @endif
+     * */
+    class PalettedContainer {
+    public:
+        static constexpr std::size_t BLOCKS = 4096;
+
+        static constexpr std::size_t BIOMES = 64;
+
+        // 批量写入时下标占的低位数
+        static constexpr unsigned INDEX_BITS = 12;
+
+        explicit PalettedContainer(std::size_t entries = BLOCKS, std::int32_t value = 0);
+
+        static PalettedContainer read(detail::ChunkReader& reader, std::size_t entries);
+
+        void write(std::vector<std::byte>& out) const;
+
+        [[nodiscard]] std::int32_t get(std::size_t index) const;
+
+        /**
+         * @if zh
+         * @brief 将全部条目解包为ID
+         * @param out 至少容纳 @c entries() 个元素
+         *
+         * @else
+         * @brief Unpack every entry into ids
+         * @param out Holds at least @c entries() elements
+         *
+         * @endif
+         * */
+        void unpack(std::span<std::int32_t> out) const;
+
+        /**
+         * @if zh
+         * @brief 批量写入条目
+         * @details 先补齐调色板并求出整批所需的位宽，至多重新打包一次，再原地写入；调色板超出间接模式的上限时转为直接模式
+         * @param changes 每项为 id << INDEX_BITS | 下标，按顺序写入，同一下标以后者为准
+         * @return 非零条目数的变化（对方块状态即非空气方块数的变化）
+         *
+         * @else
+         * @brief Write entries in a batch
+         * @details The palette is extended and the bit width the whole batch needs is worked out first, so the data is repacked at most once,
+         * then entries are written in place; a palette outgrowing the indirect limit switches to direct mode
+         * @param changes Each is id << INDEX_BITS | index, applied in order so the last write to an index wins
+         * @return Change in the number of non-zero entries (for block states, the change in non-air blocks)
+         *
+         * @endif
+         * */
+        std::int32_t set(std::span<const std::uint64_t> changes);
+
+        [[nodiscard]] std::size_t entries() const;
+
+        [[nodiscard]] int bits() const;
+
+        [[nodiscard]] bool direct() const;
+
+        [[nodiscard]] const std::vector<std::int32_t>& palette() const;
+
+        [[nodiscard]] const std::vector<std::uint64_t>& data() const;
+
+        [[nodiscard]] std::size_t memoryUsage() const;
+
+        bool operator==(const PalettedContainer&) const = default;
+
+    private:
+        std::uint16_t entries_;
+
+        std::uint8_t bits_ = 0;
+
+        std::uint8_t perLong_ = 0;
+
+        std::vector<std::int32_t> palette_;
+
+        std::vector<std::uint64_t> data_;
+
+        static std::size_t wordsFor(std::size_t entries, unsigned bits);
+
+        void repack(unsigned bits, bool toDirect);
+    };
+
+    /** @struct BlockChange
+     *
+     * @if zh
+     * @brief Update Section Blocks中的一个方块变化，坐标为段内坐标
+     *
+     * @else
+     * @brief One block change of Update Section Blocks, in section-local coordinates
+     *
+     * @endif
+     * */
+    struct BlockChange {
+        std::int32_t state = 0;
+
+        std::uint8_t x = 0;
+
+        std::uint8_t y = 0;
+
+        std::uint8_t z = 0;
+    };
+
+    /** @struct SectionBlocks
+     *
+     * @if zh
+     * @brief Update Section Blocks的方块列表，取代逐个装箱的 @c Array<VarLong>
+     * @details
+     * - 网络上每项是VarLong：state << 12 | x << 8 | z << 4 | y
+     * - 解码时直接转换为 state << 12 | (y << 8 | z << 4 | x)，即 @c PalettedContainer::set 接受的形式，写入区块段时不再经过中间数组
+     * - 变化列表本身保留：解码发生在分发之前，同一数据包还要交给用户回调、调试输出与抓包解码，区块存储只是接收方之一，无法在解码时直接写入；
+     *   列表为一次分配的连续数组，@c ChunkSection::set 原样使用，不再转换
+     * - 解码按帧内剩余字节做越界检查，数量字段超出实际数据时抛出异常
+     *
+     * @else
+     * @brief Block list of Update Section Blocks, replacing the individually boxed @c Array<VarLong>
+     * @details
+     * - On the wire each entry is a VarLong: state << 12 | x << 8 | z << 4 | y
+     * - Decoding converts it straight to state << 12 | (y << 8 | z << 4 | x), the form @c PalettedContainer::set takes,
+     *   so writing into a section needs no intermediate array
+     * - The change list itself is kept: decoding happens before dispatch and the same packet also goes to user callbacks, debug output and
+     *   capture decoding, the chunk store is only one receiver and cannot be written during decoding; the list is one contiguous allocation
+     *   that @c ChunkSection::set consumes as-is
+     * - Decoding is bounds checked against the bytes left in the frame, a count that exceeds the data throws
+     *
+     * @endif
+     * */
+    struct SectionBlocks {
+    private:
+        std::vector<std::uint64_t> changes_;
+
+        std::size_t size_ = 0;
+
+    public:
+        using type = SectionBlocks;
+
+        using encodeType = std::vector<std::byte>;
+
+        SectionBlocks() = default;
+
+        explicit SectionBlocks(std::span<const BlockChange> changes);
+
+        [[nodiscard]] std::size_t size() const;
+
+        [[nodiscard]] const SectionBlocks& value() const;
+
+        [[nodiscard]] encodeType encode() const;
+
+        static auto decode(const std::byte* data, const VarInt& count, std::size_t available);
+
+        [[nodiscard]] std::size_t count() const;
+
+        [[nodiscard]] BlockChange operator[](std::size_t i) const;
+
+        [[nodiscard]] std::span<const std::uint64_t> changes() const;
+
+        [[nodiscard]] std::string toString() const;
+
+        [[nodiscard]] std::string toHexString() const;
+
+        template<typename OutputIt>
+        OutputIt formatTo(OutputIt out) const;
+
+        template<typename OutputIt>
+        OutputIt formatHexTo(OutputIt out) const;
+
+        bool operator==(const SectionBlocks& other) const;
+    };
+
+    /** @struct ChunkSection
+     *
+     * @if zh
+     * @brief 16x16x16的区块段：非空气方块数、方块状态容器与4x4x4的生物群系容器
+     * @details 段内坐标均为0到15，方块下标为 (y * 16 + z) * 16 + x
+     *
+     * @else
+     * @brief A 16x16x16 chunk section: non-air block count, block state container and 4x4x4 biome container
+     * @details Local coordinates are 0 to 15, the block index is (y * 16 + z) * 16 + x
+     *
+     * @endif
+     * */
+    struct ChunkSection {
+        std::int16_t blockCount = 0;
+
+        PalettedContainer blocks{PalettedContainer::BLOCKS};
+
+        PalettedContainer biomes{PalettedContainer::BIOMES};
+
+        [[nodiscard]] std::int32_t blockAt(int x, int y, int z) const;
+
+        [[nodiscard]] std::int32_t biomeAt(int x, int y, int z) const;
+
+        // 写入方块变化并更新非空气方块数
+        void set(const SectionBlocks& changes);
+
+        [[nodiscard]] std::size_t memoryUsage() const;
+
+        bool operator==(const ChunkSection&) const = default;
+    };
+
+    /** @struct LightData
+     *
+     * @if zh
+     * @brief 区块列的光照数据（Chunk Data与Update Light共用的结构）
+     * @details
+     * - 光照段比区块段多两个（世界上下各一个），下标0为最低的光照段
+     * - 未发送的段为空，掩码中"空"位表示该段明确为全0
+     * - 每个光照数组2048字节，每个方块4位
+     *
+     * @else
+     * @brief Light data of a chunk column (the structure shared by Chunk Data and Update Light)
+     * @details
+     * - There are two more light sections than chunk sections (one below and one above the world), index 0 is the lowest
+     * - Sections that were not sent are empty, the "empty" mask bits mark sections that are explicitly all zero
+     * - Each light array is 2048 bytes, four bits per block
+     *
+     * @endif
+     * */
+    struct LightData {
+    private:
+        std::vector<std::vector<std::byte>> sky_;
+
+        std::vector<std::vector<std::byte>> block_;
+
+        std::vector<std::uint64_t> emptySky_;
+
+        std::vector<std::uint64_t> emptyBlock_;
+
+        std::size_t size_ = 0;
+
+        static void readArrays(detail::ChunkReader& reader, const std::vector<std::uint64_t>& mask, std::vector<std::vector<std::byte>>& arrays);
+
+        static void writeMask(std::vector<std::byte>& out, const std::vector<std::vector<std::byte>>& arrays);
+
+        static void mergeArrays(std::vector<std::vector<std::byte>>& arrays, std::vector<std::uint64_t>& empty, const std::vector<std::vector<std::byte>>& other,
+                                const std::vector<std::uint64_t>& otherEmpty);
+
+    public:
+        static constexpr std::size_t ARRAY_SIZE = 2048;
+
+        using type = LightData;
+
+        using encodeType = std::vector<std::byte>;
+
+        LightData() = default;
+
+        [[nodiscard]] std::size_t size() const;
+
+        [[nodiscard]] const LightData& value() const;
+
+        [[nodiscard]] encodeType encode() const;
+
+        void write(std::vector<std::byte>& out) const;
+
+        static auto decode(const std::byte* data, std::size_t size);
+
+        static LightData read(detail::ChunkReader& reader);
+
+        [[nodiscard]] std::size_t sections() const;
+
+        [[nodiscard]] std::span<const std::byte> skyLight(std::size_t section) const;
+
+        [[nodiscard]] std::span<const std::byte> blockLight(std::size_t section) const;
+
+        void setSkyLight(std::size_t section, std::span<const std::byte> light);
+
+        void setBlockLight(std::size_t section, std::span<const std::byte> light);
+
+        /**
+         * @if zh
+         * @brief 合并一次光照更新：更新中带数据的段被替换，标记为空的段被清空，其余保持不变
+         *
+         * @else
+         * @brief Merge a light update: sections carrying data are replaced, sections marked empty are cleared, the rest is kept
+         *
+         * @endif
+         * */
+        void merge(const LightData& update);
+
+        [[nodiscard]] std::size_t memoryUsage() const;
+
+        [[nodiscard]] std::string toString() const;
+
+        [[nodiscard]] std::string toHexString() const;
+
+        template<typename OutputIt>
+        OutputIt formatTo(OutputIt out) const;
+
+        template<typename OutputIt>
+        OutputIt formatHexTo(OutputIt out) const;
+
+        bool operator==(const LightData& other) const;
+    };
+
+    /** @struct ChunkColumn
+     *
+     * @if zh
+     * @brief Chunk Data数据包中区块坐标之后的全部内容
+     * @details
+     * - 区块段直接从帧中解析为 @c PalettedContainer ，不经过中间字节数组
+     * - 高度图与方块实体保留原始字节，不在热路径上解析NBT
+     * - 解码结果由 @c std::shared_ptr 持有，取字段或交给 @c world::ChunkStore 时不复制；交给存储后该字段与存储共享数据
+     *
+     * @else
+     * @brief Everything after the chunk coordinates in a Chunk Data packet
+     * @details
+     * - Sections are parsed from the frame straight into @c PalettedContainer, with no intermediate byte array
+     * - Heightmaps and block entities are kept as raw bytes, no NBT is parsed on the hot path
+     * - The decoded column is held by a @c std::shared_ptr, getting the field or handing it to @c world::ChunkStore does not copy it;
+     *   once handed over the field shares its data with the store
+     *
+     * @endif
+     * */
+    struct ChunkColumn {
+        struct Data {
+            // 网络NBT原始字节
+            std::vector<std::byte> heightmaps;
+
+            std::vector<ChunkSection> sections;
+
+            std::int32_t blockEntityCount = 0;
+
+            // 方块实体条目的原始字节，不含数量前缀
+            std::vector<std::byte> blockEntities;
+
+            LightData light;
+
+            [[nodiscard]] std::size_t memoryUsage() const;
+
+            bool operator==(const Data&) const = default;
+        };
+
+    private:
+        std::shared_ptr<Data> data_;
+
+        std::size_t size_ = 0;
+
+    public:
+        using type = std::shared_ptr<Data>;
+
+        using encodeType = std::vector<std::byte>;
+
+        ChunkColumn();
+
+        explicit ChunkColumn(std::shared_ptr<Data> data);
+
+        [[nodiscard]] std::size_t size() const;
+
+        [[nodiscard]] type value() const;
+
+        [[nodiscard]] encodeType encode() const;
+
+        static auto decode(const std::byte* data, std::size_t size);
+
+        [[nodiscard]] std::string toString() const;
+
+        [[nodiscard]] std::string toHexString() const;
+
+        template<typename OutputIt>
+        OutputIt formatTo(OutputIt out) const;
+
+        template<typename OutputIt>
+        OutputIt formatHexTo(OutputIt out) const;
+    };
+
+    template<typename T>
+    concept is_chunk_field = std::is_same_v<T, ChunkColumn> || std::is_same_v<T, LightData> || std::is_same_v<T, SectionBlocks>;
+
+}  // namespace minecraft::protocol
+
+#include "chunk.hpp"
+
+#endif  // CHUNK_H
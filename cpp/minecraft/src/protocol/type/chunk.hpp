@@ -0,0 +1,937 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file chunk.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 05:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef CHUNK_HPP
+#define CHUNK_HPP
+#pragma once
+
+#include "../../utils/utils.h"
+#include "chunk.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace minecraft::protocol {
+
+    namespace detail {
+        // 单个调色板或数据数组允许的最大长度，超出视为数据损坏
+        inline constexpr std::size_t MAX_CHUNK_ARRAY = 1 << 20;
+
+        // 光照掩码最多的long数，对应4096个光照段，远超任何维度的高度
+        inline constexpr std::size_t MAX_LIGHT_MASK = 64;
+
+        inline constexpr int MAX_NBT_DEPTH = 512;
+
+        inline std::size_t ChunkReader::remaining() const { return static_cast<std::size_t>(end - pos); }
+
+        inline void ChunkReader::need(const std::size_t n) const {
+            if (remaining() < n) throw std::runtime_error("Truncated chunk data");
+        }
+
+        inline std::uint8_t ChunkReader::u8() {
+            need(1);
+
+            return static_cast<std::uint8_t>(*pos++);
+        }
+
+        inline std::uint16_t ChunkReader::u16() {
+            need(2);
+
+            const auto value = static_cast<std::uint16_t>(static_cast<unsigned>(pos[0]) << 8 | static_cast<unsigned>(pos[1]));
+            pos += 2;
+
+            return value;
+        }
+
+        inline std::int16_t ChunkReader::i16() { return static_cast<std::int16_t>(u16()); }
+
+        inline std::int32_t ChunkReader::i32() {
+            need(4);
+
+            std::uint32_t value = 0;
+
+            for (int i = 0; i < 4; i++) value = value << 8 | static_cast<std::uint32_t>(pos[i]);
+
+            pos += 4;
+
+            return static_cast<std::int32_t>(value);
+        }
+
+        inline std::uint64_t ChunkReader::u64() {
+            need(8);
+
+            std::uint64_t value = 0;
+
+            for (int i = 0; i < 8; i++) value = value << 8 | static_cast<std::uint64_t>(pos[i]);
+
+            pos += 8;
+
+            return value;
+        }
+
+        inline std::int32_t ChunkReader::varInt() {
+            std::uint32_t value = 0;
+
+            for (int shift = 0; shift < 35; shift += 7) {
+                const auto b = u8();
+
+                value |= static_cast<std::uint32_t>(b & 0x7F) << shift;
+
+                if (!(b & 0x80)) return static_cast<std::int32_t>(value);
+            }
+
+            throw std::runtime_error("VarInt too long in chunk data");
+        }
+
+        inline std::size_t ChunkReader::length(const std::size_t limit) {
+            const auto value = varInt();
+
+            if (value < 0 || static_cast<std::size_t>(value) > limit) throw std::runtime_error(std::format("Invalid length {} in chunk data", value));
+
+            return static_cast<std::size_t>(value);
+        }
+
+        inline std::span<const std::byte> ChunkReader::bytes(const std::size_t n) {
+            need(n);
+
+            const std::span result{pos, n};
+            pos += n;
+
+            return result;
+        }
+
+        inline void ChunkReader::skipNbt() {
+            // TAG_End作为根表示空NBT
+            if (const auto tag = u8(); tag != 0) skipNbtPayload(tag, 0);
+        }
+
+        inline void ChunkReader::skipNbtPayload(const std::uint8_t tag, const int depth) {
+            if (depth > MAX_NBT_DEPTH) throw std::runtime_error("NBT nested too deep");
+
+            const auto count = [this](const std::size_t width) {
+                const auto n = i32();
+
+                if (n < 0) throw std::runtime_error("Negative NBT array length");
+
+                return static_cast<std::size_t>(n) * width;
+            };
+
+            switch (tag) {
+                case 1: bytes(1); break;
+                case 2: bytes(2); break;
+                case 3:
+                case 5: bytes(4); break;
+                case 4:
+                case 6: bytes(8); break;
+                case 7: bytes(count(1)); break;
+                case 8: bytes(u16()); break;
+                case 9: {
+                    const auto element = u8();
+                    const auto n       = i32();
+
+                    for (std::int32_t i = 0; i < n; i++) skipNbtPayload(element, depth + 1);
+
+                    break;
+                }
+                case 10:
+                    for (auto child = u8(); child != 0; child = u8()) {
+                        bytes(u16());
+                        skipNbtPayload(child, depth + 1);
+                    }
+                    break;
+                case 11: bytes(count(4)); break;
+                case 12: bytes(count(8)); break;
+                default: throw std::runtime_error(std::format("Unknown NBT tag {}", tag));
+            }
+        }
+
+        inline void putVarInt(std::vector<std::byte>& out, const std::int32_t value) {
+            auto v = static_cast<std::uint32_t>(value);
+
+            do {
+                const auto b = static_cast<std::byte>(v & 0x7F);
+
+                v >>= 7;
+
+                out.push_back(v ? b | std::byte{0x80} : b);
+            } while (v);
+        }
+
+        inline void putU64(std::vector<std::byte>& out, const std::uint64_t value) {
+            for (int shift = 56; shift >= 0; shift -= 8) out.push_back(static_cast<std::byte>(value >> shift & 0xFF));
+        }
+
+        template<unsigned Bits>
+        void unpackWords(const std::uint64_t* words, const std::size_t entries, std::int32_t* out) {
+            constexpr unsigned per       = 64 / Bits;
+            constexpr std::uint64_t mask = (std::uint64_t{1} << Bits) - 1;
+
+            const auto full = entries / per;
+
+            // 内层循环次数与移位量均为常量，展开后每个long的解包是一组独立的移位与掩码
+            for (std::size_t w = 0; w < full; w++, out += per) {
+                const auto word = words[w];
+
+                for (unsigned j = 0; j < per; j++) out[j] = static_cast<std::int32_t>(word >> j * Bits & mask);
+            }
+
+            for (std::size_t j = 0; j < entries % per; j++) out[j] = static_cast<std::int32_t>(words[full] >> j * Bits & mask);
+        }
+
+        inline PaletteIndex::PaletteIndex(const std::span<const std::int32_t> palette) {
+            indices.fill(-1);
+
+            // 重复的ID保留第一个下标
+            for (std::size_t i = 0; i < palette.size(); i++)
+                if (find(palette[i]) < 0) insert(palette[i], static_cast<std::int32_t>(i));
+        }
+
+        inline std::size_t PaletteIndex::slot(const std::int32_t id) const {
+            // 乘法散列取高位，线性探测
+            auto h = static_cast<std::size_t>(static_cast<std::uint32_t>(id) * 0x9E3779B1u >> 23);
+
+            while (indices[h] >= 0 && ids[h] != id) h = (h + 1) & (SLOTS - 1);
+
+            return h;
+        }
+
+        inline std::int32_t PaletteIndex::find(const std::int32_t id) const { return indices[slot(id)]; }
+
+        inline void PaletteIndex::insert(const std::int32_t id, const std::int32_t index) {
+            const auto h = slot(id);
+
+            ids[h]     = id;
+            indices[h] = static_cast<std::int16_t>(index);
+        }
+
+        // 位宽1到32各一个展开的解包函数
+        inline constexpr auto UNPACKERS = []<std::size_t... Is>(std::index_sequence<Is...>) {
+            return std::array<UnpackFn, sizeof...(Is)>{&unpackWords<static_cast<unsigned>(Is + 1)>...};
+        }(std::make_index_sequence<32>{});
+    }  // namespace detail
+
+    // PalettedContainer
+
+    inline PalettedContainer::PalettedContainer(const std::size_t entries, const std::int32_t value)
+        : entries_(static_cast<std::uint16_t>(entries))
+        , palette_{value} {}
+
+    inline std::size_t PalettedContainer::wordsFor(const std::size_t entries, const unsigned bits) {
+        const auto per = 64 / bits;
+
+        return (entries + per - 1) / per;
+    }
+
+    inline PalettedContainer PalettedContainer::read(detail::ChunkReader& reader, const std::size_t entries) {
+        PalettedContainer result(entries);
+
+        auto bits = static_cast<unsigned>(reader.u8());
+
+        const auto blocks   = entries == BLOCKS;
+        const auto indirect = bits != 0 && bits <= (blocks ? 8u : 3u);
+
+        if (bits > 32) throw std::runtime_error(std::format("Invalid bits per entry {}", bits));
+
+        // 方块状态的间接调色板至少4位
+        if (blocks && indirect) bits = std::max(bits, 4u);
+
+        if (bits == 0)
+            result.palette_[0] = reader.varInt();
+
+        else if (indirect) {
+            const auto n = reader.length(std::size_t{1} << bits);
+
+            result.palette_.resize(n);
+
+            for (auto& id : result.palette_) id = reader.varInt();
+        }
+
+        else
+            result.palette_.clear();
+
+        const auto words = reader.length(detail::MAX_CHUNK_ARRAY);
+
+        // 单值容器的数据数组应为空，仍按长度跳过以兼容填充
+        if (bits == 0) {
+            reader.bytes(words * 8);
+
+            return result;
+        }
+
+        if (words != wordsFor(entries, bits)) throw std::runtime_error(std::format("Data array of {} longs does not fit {} entries of {} bits", words, entries, bits));
+
+        result.bits_    = static_cast<std::uint8_t>(bits);
+        result.perLong_ = static_cast<std::uint8_t>(64 / bits);
+
+        const auto raw = reader.bytes(words * 8);
+
+        result.data_.resize(words);
+
+        // 网络字节序为大端
+        for (std::size_t i = 0; i < words; i++) {
+            std::uint64_t value;
+
+            std::memcpy(&value, raw.data() + i * 8, 8);
+
+            result.data_[i] = std::endian::native == std::endian::little ? std::byteswap(value) : value;
+        }
+
+        return result;
+    }
+
+    inline void PalettedContainer::write(std::vector<std::byte>& out) const {
+        out.push_back(static_cast<std::byte>(bits_));
+
+        if (bits_ == 0)
+            detail::putVarInt(out, palette_[0]);
+
+        else if (!palette_.empty()) {
+            detail::putVarInt(out, static_cast<std::int32_t>(palette_.size()));
+
+            for (const auto id : palette_) detail::putVarInt(out, id);
+        }
+
+        detail::putVarInt(out, static_cast<std::int32_t>(data_.size()));
+
+        for (const auto word : data_) detail::putU64(out, word);
+    }
+
+    inline std::int32_t PalettedContainer::get(const std::size_t index) const {
+        if (bits_ == 0) return palette_[0];
+
+        const auto v = static_cast<std::size_t>(data_[index / perLong_] >> index % perLong_ * bits_ & ((std::uint64_t{1} << bits_) - 1));
+
+        if (palette_.empty()) return static_cast<std::int32_t>(v);
+
+        return v < palette_.size() ? palette_[v] : 0;
+    }
+
+    inline void PalettedContainer::unpack(const std::span<std::int32_t> out) const {
+        if (out.size() < entries_) throw std::out_of_range("Unpack buffer too small");
+
+        if (bits_ == 0) {
+            std::fill_n(out.begin(), entries_, palette_[0]);
+
+            return;
+        }
+
+        detail::UNPACKERS[bits_ - 1](data_.data(), entries_, out.data());
+
+        if (palette_.empty()) return;
+
+        // 越界的调色板下标按0处理，写成选择而不是分支，保持循环可向量化
+        const auto* palette = palette_.data();
+        const auto n        = palette_.size();
+
+        for (std::size_t i = 0; i < entries_; i++) {
+            const auto v = static_cast<std::size_t>(out[i]);
+
+            out[i] = v < n ? palette[v] : 0;
+        }
+    }
+
+    inline void PalettedContainer::repack(const unsigned bits, const bool toDirect) {
+        const auto per = 64 / bits;
+
+        // 单值容器转为间接模式时所有条目都是下标0，全0的数据数组即可
+        if (bits_ == 0 && !toDirect) {
+            data_.assign(wordsFor(entries_, bits), 0);
+
+            bits_    = static_cast<std::uint8_t>(bits);
+            perLong_ = static_cast<std::uint8_t>(per);
+
+            return;
+        }
+
+        std::array<std::int32_t, BLOCKS> values;
+
+        // 转为直接模式时取ID，否则保留调色板下标
+        if (toDirect)
+            unpack({values.data(), entries_});
+
+        else
+            detail::UNPACKERS[bits_ - 1](data_.data(), entries_, values.data());
+
+        data_.assign(wordsFor(entries_, bits), 0);
+
+        // 按long逐个拼装，避免每个条目一次除法
+        for (std::size_t w = 0, i = 0; w < data_.size(); w++)
+            for (unsigned j = 0; j < per && i < entries_; j++, i++) data_[w] |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(values[i])) << j * bits;
+
+        bits_    = static_cast<std::uint8_t>(bits);
+        perLong_ = static_cast<std::uint8_t>(per);
+
+        if (toDirect) palette_.clear();
+    }
+
+    inline std::int32_t PalettedContainer::set(const std::span<const std::uint64_t> changes) {
+        constexpr auto indexMask = (std::uint64_t{1} << INDEX_BITS) - 1;
+
+        const auto blocks = entries_ == BLOCKS;
+        const auto idOf   = [](const std::uint64_t change) { return static_cast<std::int32_t>(change >> INDEX_BITS); };
+
+        auto bits     = static_cast<unsigned>(bits_);
+        auto toDirect = direct();
+
+        // 直接模式不查调色板，表保持为空
+        detail::PaletteIndex lookup(toDirect ? std::span<const std::int32_t>{} : std::span<const std::int32_t>{palette_});
+
+        // 第一遍：补齐调色板，求出整批所需的位宽；超出间接模式上限后不必再查找
+        if (!toDirect) {
+            const auto limit = std::size_t{1} << (blocks ? 8 : 3);
+
+            for (const auto change : changes)
+                if (const auto id = idOf(change); lookup.find(id) < 0) {
+                    lookup.insert(id, static_cast<std::int32_t>(palette_.size()));
+                    palette_.push_back(id);
+
+                    if (palette_.size() > limit) {
+                        toDirect = true;
+                        break;
+                    }
+                }
+
+            if (!toDirect && palette_.size() > 1) bits = std::max({bits, blocks ? 4u : 1u, static_cast<unsigned>(std::bit_width(palette_.size() - 1))});
+        }
+
+        if (toDirect) {
+            std::uint32_t maxId = 0;
+
+            for (const auto id : palette_) maxId = std::max(maxId, static_cast<std::uint32_t>(id));
+            for (const auto change : changes) maxId = std::max(maxId, static_cast<std::uint32_t>(idOf(change)));
+
+            // 直接模式的位宽须超过间接模式上限，重新编码后读取方才能区分两种模式
+            bits = std::max({direct() ? bits : 0u, blocks ? 9u : 4u, static_cast<unsigned>(std::bit_width(maxId))});
+        }
+
+        if (bits != bits_ || toDirect != direct()) repack(bits, toDirect);
+
+        // 调色板只有一个值且没有新ID，所有写入都不改变内容
+        if (bits_ == 0) return 0;
+
+        // 第二遍：原地写入
+        const auto mask = (std::uint64_t{1} << bits_) - 1;
+
+        std::int32_t delta = 0;
+
+        // 连续的相同ID（如爆炸清空为空气）只查一次表
+        std::optional<std::int32_t> lastId;
+        std::uint64_t lastCode = 0;
+
+        for (const auto change : changes) {
+            const auto index = static_cast<std::size_t>(change & indexMask);
+
+            if (index >= entries_) continue;
+
+            const auto id = idOf(change);
+
+            if (id != lastId) {
+                lastId   = id;
+                lastCode = palette_.empty() ? static_cast<std::uint32_t>(id) : static_cast<std::uint32_t>(lookup.find(id));
+            }
+
+            auto& word       = data_[index / perLong_];
+            const auto shift = index % perLong_ * bits_;
+            const auto old   = word >> shift & mask;
+            const auto oldId = palette_.empty() ? static_cast<std::int32_t>(old) : old < palette_.size() ? palette_[old] : 0;
+
+            delta += (id != 0) - (oldId != 0);
+            word = word & ~(mask << shift) | lastCode << shift;
+        }
+
+        return delta;
+    }
+
+    inline std::size_t PalettedContainer::entries() const { return entries_; }
+
+    inline int PalettedContainer::bits() const { return bits_; }
+
+    inline bool PalettedContainer::direct() const { return bits_ != 0 && palette_.empty(); }
+
+    inline const std::vector<std::int32_t>& PalettedContainer::palette() const { return palette_; }
+
+    inline const std::vector<std::uint64_t>& PalettedContainer::data() const { return data_; }
+
+    inline std::size_t PalettedContainer::memoryUsage() const {
+        return sizeof(PalettedContainer) + palette_.capacity() * sizeof(std::int32_t) + data_.capacity() * sizeof(std::uint64_t);
+    }
+
+    // SectionBlocks
+
+    inline SectionBlocks::SectionBlocks(const std::span<const BlockChange> changes) {
+        changes_.reserve(changes.size());
+
+        for (const auto& c : changes)
+            changes_.push_back(static_cast<std::uint64_t>(static_cast<std::uint32_t>(c.state)) << PalettedContainer::INDEX_BITS | (c.y & 15) << 8 | (c.z & 15) << 4 | (c.x & 15));
+
+        size_ = encode().size();
+    }
+
+    inline std::size_t SectionBlocks::size() const { return size_; }
+
+    inline const SectionBlocks& SectionBlocks::value() const { return *this; }
+
+    inline SectionBlocks::encodeType SectionBlocks::encode() const {
+        encodeType result;
+
+        result.reserve(changes_.size() * 3);
+
+        for (const auto change : changes_) {
+            // 段内下标 y << 8 | z << 4 | x 还原为网络上的 x << 8 | z << 4 | y
+            auto v = change >> PalettedContainer::INDEX_BITS << 12 | (change & 0xF) << 8 | (change & 0xF0) | (change >> 8 & 0xF);
+
+            do {
+                const auto b = static_cast<std::byte>(v & 0x7F);
+
+                v >>= 7;
+
+                result.push_back(v ? b | std::byte{0x80} : b);
+            } while (v);
+        }
+
+        return result;
+    }
+
+    inline auto SectionBlocks::decode(const std::byte* data, const VarInt& count, const std::size_t available) {
+        SectionBlocks result;
+
+        const auto start = data;
+        const auto end   = data + available;
+        const auto n     = static_cast<std::size_t>(std::max(count.value(), 0));
+
+        // 数量来自网络，每项至少一个字节，超出剩余字节数的数量必然越界
+        if (n > available) throw std::runtime_error("Section blocks count exceeds the packet");
+
+        result.changes_.reserve(n);
+
+        for (std::size_t i = 0; i < n; i++) {
+            std::uint64_t v = 0;
+
+            for (int shift = 0;; shift += 7) {
+                if (shift >= 70) throw std::runtime_error("VarLong too long in section blocks");
+
+                if (data == end) throw std::runtime_error("Section blocks overrun the packet");
+
+                const auto b = static_cast<std::uint8_t>(*data++);
+
+                v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+
+                if (!(b & 0x80)) break;
+            }
+
+            // 网络上的 x << 8 | z << 4 | y 转为段内下标 y << 8 | z << 4 | x
+            result.changes_.push_back(v >> 12 << PalettedContainer::INDEX_BITS | (v & 0xF) << 8 | (v & 0xF0) | (v >> 8 & 0xF));
+        }
+
+        result.size_ = static_cast<std::size_t>(data - start);
+
+        return result;
+    }
+
+    inline std::size_t SectionBlocks::count() const { return changes_.size(); }
+
+    inline BlockChange SectionBlocks::operator[](const std::size_t i) const {
+        const auto change = changes_[i];
+
+        return {static_cast<std::int32_t>(change >> PalettedContainer::INDEX_BITS), static_cast<std::uint8_t>(change & 0xF), static_cast<std::uint8_t>(change >> 8 & 0xF),
+                static_cast<std::uint8_t>(change >> 4 & 0xF)};
+    }
+
+    inline std::span<const std::uint64_t> SectionBlocks::changes() const { return changes_; }
+
+    inline std::string SectionBlocks::toString() const {
+        std::string result;
+
+        formatTo(std::back_inserter(result));
+
+        return result;
+    }
+
+    inline std::string SectionBlocks::toHexString() const { return minecraft::toHexString(encode()); }
+
+    template<typename OutputIt>
+    OutputIt SectionBlocks::formatTo(OutputIt out) const {
+        *out++ = '[';
+
+        for (std::size_t i = 0; i < changes_.size(); i++) {
+            const auto c = (*this)[i];
+
+            out = std::format_to(out, "{}{} @ ({}, {}, {})", i ? ", " : "", c.state, c.x, c.y, c.z);
+        }
+
+        *out++ = ']';
+
+        return out;
+    }
+
+    template<typename OutputIt>
+    OutputIt SectionBlocks::formatHexTo(OutputIt out) const {
+        return minecraft::hexTo(out, encode());
+    }
+
+    inline bool SectionBlocks::operator==(const SectionBlocks& other) const { return changes_ == other.changes_; }
+
+    // ChunkSection
+
+    inline std::int32_t ChunkSection::blockAt(const int x, const int y, const int z) const {
+        return blocks.get(static_cast<std::size_t>((y & 15) << 8 | (z & 15) << 4 | (x & 15)));
+    }
+
+    inline std::int32_t ChunkSection::biomeAt(const int x, const int y, const int z) const {
+        return biomes.get(static_cast<std::size_t>((y & 15) >> 2 << 4 | (z & 15) >> 2 << 2 | (x & 15) >> 2));
+    }
+
+    inline void ChunkSection::set(const SectionBlocks& changes) { blockCount = static_cast<std::int16_t>(blockCount + blocks.set(changes.changes())); }
+
+    inline std::size_t ChunkSection::memoryUsage() const { return blocks.memoryUsage() + biomes.memoryUsage() + sizeof(blockCount); }
+
+    // LightData
+
+    inline void LightData::readArrays(detail::ChunkReader& reader, const std::vector<std::uint64_t>& mask, std::vector<std::vector<std::byte>>& arrays) {
+        const auto count = reader.length(mask.size() * 64);
+
+        arrays.assign(mask.size() * 64, {});
+
+        std::size_t section = 0;
+
+        for (std::size_t i = 0; i < count; i++) {
+            // 数组按掩码中置位的段从低到高排列
+            while (section < arrays.size() && !(mask[section / 64] >> section % 64 & 1)) section++;
+
+            if (section == arrays.size()) throw std::runtime_error("More light arrays than mask bits");
+
+            if (reader.length(ARRAY_SIZE) != ARRAY_SIZE) throw std::runtime_error("Light array is not 2048 bytes");
+
+            const auto light = reader.bytes(ARRAY_SIZE);
+
+            arrays[section++].assign(light.begin(), light.end());
+        }
+
+        // 去掉末尾未发送的段
+        while (!arrays.empty() && arrays.back().empty()) arrays.pop_back();
+    }
+
+    inline void LightData::writeMask(std::vector<std::byte>& out, const std::vector<std::vector<std::byte>>& arrays) {
+        std::vector<std::uint64_t> mask((arrays.size() + 63) / 64);
+
+        for (std::size_t i = 0; i < arrays.size(); i++)
+            if (!arrays[i].empty()) mask[i / 64] |= std::uint64_t{1} << i % 64;
+
+        while (!mask.empty() && mask.back() == 0) mask.pop_back();
+
+        detail::putVarInt(out, static_cast<std::int32_t>(mask.size()));
+
+        for (const auto word : mask) detail::putU64(out, word);
+    }
+
+    inline void LightData::mergeArrays(std::vector<std::vector<std::byte>>& arrays, std::vector<std::uint64_t>& empty, const std::vector<std::vector<std::byte>>& other,
+                                       const std::vector<std::uint64_t>& otherEmpty) {
+        const auto bit = [](const std::vector<std::uint64_t>& mask, const std::size_t i) { return i / 64 < mask.size() && mask[i / 64] >> i % 64 & 1; };
+
+        const auto set = [](std::vector<std::uint64_t>& mask, const std::size_t i, const bool value) {
+            if (i / 64 >= mask.size()) {
+                if (!value) return;
+
+                mask.resize(i / 64 + 1);
+            }
+
+            mask[i / 64] = value ? mask[i / 64] | std::uint64_t{1} << i % 64 : mask[i / 64] & ~(std::uint64_t{1} << i % 64);
+        };
+
+        const auto sections = std::max(other.size(), otherEmpty.size() * 64);
+
+        for (std::size_t i = 0; i < sections; i++) {
+            if (i < other.size() && !other[i].empty()) {
+                if (i >= arrays.size()) arrays.resize(i + 1);
+
+                arrays[i] = other[i];
+                set(empty, i, false);
+            }
+
+            else if (bit(otherEmpty, i)) {
+                if (i < arrays.size()) arrays[i].clear();
+
+                set(empty, i, true);
+            }
+        }
+
+        while (!arrays.empty() && arrays.back().empty()) arrays.pop_back();
+
+        while (!empty.empty() && empty.back() == 0) empty.pop_back();
+    }
+
+    inline std::size_t LightData::size() const { return size_; }
+
+    inline const LightData& LightData::value() const { return *this; }
+
+    inline void LightData::write(std::vector<std::byte>& out) const {
+        // 掩码依次为：天空光、方块光、空天空光、空方块光，随后是两组光照数组
+        writeMask(out, sky_);
+        writeMask(out, block_);
+
+        for (const auto* empty : {&emptySky_, &emptyBlock_}) {
+            detail::putVarInt(out, static_cast<std::int32_t>(empty->size()));
+
+            for (const auto word : *empty) detail::putU64(out, word);
+        }
+
+        for (const auto* arrays : {&sky_, &block_}) {
+            detail::putVarInt(out, static_cast<std::int32_t>(std::ranges::count_if(*arrays, [](const auto& a) { return !a.empty(); })));
+
+            for (const auto& light : *arrays) {
+                if (light.empty()) continue;
+
+                detail::putVarInt(out, static_cast<std::int32_t>(light.size()));
+                out.insert(out.end(), light.begin(), light.end());
+            }
+        }
+    }
+
+    inline LightData::encodeType LightData::encode() const {
+        encodeType result;
+
+        write(result);
+
+        return result;
+    }
+
+    inline LightData LightData::read(detail::ChunkReader& reader) {
+        LightData result;
+
+        const auto start = reader.pos;
+
+        const auto bitSet = [&reader] {
+            std::vector<std::uint64_t> words(reader.length(detail::MAX_LIGHT_MASK));
+
+            for (auto& word : words) word = reader.u64();
+
+            return words;
+        };
+
+        const auto skyMask   = bitSet();
+        const auto blockMask = bitSet();
+
+        result.emptySky_   = bitSet();
+        result.emptyBlock_ = bitSet();
+
+        readArrays(reader, skyMask, result.sky_);
+        readArrays(reader, blockMask, result.block_);
+
+        result.size_ = static_cast<std::size_t>(reader.pos - start);
+
+        return result;
+    }
+
+    inline auto LightData::decode(const std::byte* data, const std::size_t size) {
+        detail::ChunkReader reader{data, data + size};
+
+        return read(reader);
+    }
+
+    inline std::size_t LightData::sections() const { return std::max(sky_.size(), block_.size()); }
+
+    inline std::span<const std::byte> LightData::skyLight(const std::size_t section) const {
+        if (section >= sky_.size()) return {};
+
+        return sky_[section];
+    }
+
+    inline std::span<const std::byte> LightData::blockLight(const std::size_t section) const {
+        if (section >= block_.size()) return {};
+
+        return block_[section];
+    }
+
+    inline void LightData::setSkyLight(const std::size_t section, const std::span<const std::byte> light) {
+        if (light.size() != ARRAY_SIZE) throw std::invalid_argument("Light array is not 2048 bytes");
+
+        if (section >= sky_.size()) sky_.resize(section + 1);
+
+        sky_[section].assign(light.begin(), light.end());
+    }
+
+    inline void LightData::setBlockLight(const std::size_t section, const std::span<const std::byte> light) {
+        if (light.size() != ARRAY_SIZE) throw std::invalid_argument("Light array is not 2048 bytes");
+
+        if (section >= block_.size()) block_.resize(section + 1);
+
+        block_[section].assign(light.begin(), light.end());
+    }
+
+    inline void LightData::merge(const LightData& update) {
+        mergeArrays(sky_, emptySky_, update.sky_, update.emptySky_);
+        mergeArrays(block_, emptyBlock_, update.block_, update.emptyBlock_);
+    }
+
+    inline std::size_t LightData::memoryUsage() const {
+        std::size_t result = sizeof(LightData) + (emptySky_.capacity() + emptyBlock_.capacity()) * sizeof(std::uint64_t);
+
+        for (const auto* arrays : {&sky_, &block_}) {
+            result += arrays->capacity() * sizeof(std::vector<std::byte>);
+
+            for (const auto& light : *arrays) result += light.capacity();
+        }
+
+        return result;
+    }
+
+    inline std::string LightData::toString() const {
+        std::string result;
+
+        formatTo(std::back_inserter(result));
+
+        return result;
+    }
+
+    inline std::string LightData::toHexString() const { return minecraft::toHexString(encode()); }
+
+    template<typename OutputIt>
+    OutputIt LightData::formatTo(OutputIt out) const {
+        const auto present = [](const auto& arrays) { return std::ranges::count_if(arrays, [](const auto& a) { return !a.empty(); }); };
+
+        return std::format_to(out, "LightData(sky {}, block {})", present(sky_), present(block_));
+    }
+
+    template<typename OutputIt>
+    OutputIt LightData::formatHexTo(OutputIt out) const {
+        return minecraft::hexTo(out, encode());
+    }
+
+    inline bool LightData::operator==(const LightData& other) const {
+        return sky_ == other.sky_ && block_ == other.block_ && emptySky_ == other.emptySky_ && emptyBlock_ == other.emptyBlock_;
+    }
+
+    // ChunkColumn
+
+    inline std::size_t ChunkColumn::Data::memoryUsage() const {
+        std::size_t result = sizeof(Data) + heightmaps.capacity() + blockEntities.capacity() + light.memoryUsage();
+
+        for (const auto& section : sections) result += section.memoryUsage();
+
+        return result;
+    }
+
+    inline ChunkColumn::ChunkColumn()
+        : data_(std::make_shared<Data>()) {}
+
+    inline ChunkColumn::ChunkColumn(std::shared_ptr<Data> data)
+        : data_(std::move(data)) {}
+
+    inline std::size_t ChunkColumn::size() const { return size_; }
+
+    inline ChunkColumn::type ChunkColumn::value() const { return data_; }
+
+    inline ChunkColumn::encodeType ChunkColumn::encode() const {
+        encodeType result = data_->heightmaps;
+
+        std::vector<std::byte> sections;
+
+        for (const auto& section : data_->sections) {
+            sections.push_back(static_cast<std::byte>(static_cast<std::uint16_t>(section.blockCount) >> 8));
+            sections.push_back(static_cast<std::byte>(section.blockCount & 0xFF));
+
+            section.blocks.write(sections);
+            section.biomes.write(sections);
+        }
+
+        detail::putVarInt(result, static_cast<std::int32_t>(sections.size()));
+        result.insert(result.end(), sections.begin(), sections.end());
+
+        detail::putVarInt(result, data_->blockEntityCount);
+        result.insert(result.end(), data_->blockEntities.begin(), data_->blockEntities.end());
+
+        data_->light.write(result);
+
+        return result;
+    }
+
+    inline auto ChunkColumn::decode(const std::byte* data, const std::size_t size) {
+        detail::ChunkReader reader{data, data + size};
+
+        auto column = std::make_shared<Data>();
+
+        const auto heightmaps = reader.pos;
+        reader.skipNbt();
+        column->heightmaps.assign(heightmaps, reader.pos);
+
+        // 区块段依次排列直到数据区结束，段数由世界高度决定
+        const auto sections = reader.bytes(reader.length(reader.remaining()));
+
+        detail::ChunkReader sectionReader{sections.data(), sections.data() + sections.size()};
+
+        column->sections.reserve(24);
+
+        while (sectionReader.remaining() > 0) {
+            auto& section = column->sections.emplace_back();
+
+            section.blockCount = sectionReader.i16();
+            section.blocks     = PalettedContainer::read(sectionReader, PalettedContainer::BLOCKS);
+            section.biomes     = PalettedContainer::read(sectionReader, PalettedContainer::BIOMES);
+        }
+
+        column->blockEntityCount = static_cast<std::int32_t>(reader.length(reader.remaining()));
+
+        const auto blockEntities = reader.pos;
+
+        for (std::int32_t i = 0; i < column->blockEntityCount; i++) {
+            // 打包的XZ、Y、类型，随后是NBT
+            reader.bytes(3);
+            reader.varInt();
+            reader.skipNbt();
+        }
+
+        column->blockEntities.assign(blockEntities, reader.pos);
+
+        column->light = LightData::read(reader);
+
+        ChunkColumn result(std::move(column));
+
+        result.size_ = static_cast<std::size_t>(reader.pos - data);
+
+        return result;
+    }
+
+    inline std::string ChunkColumn::toString() const {
+        std::string result;
+
+        formatTo(std::back_inserter(result));
+
+        return result;
+    }
+
+    inline std::string ChunkColumn::toHexString() const { return minecraft::toHexString(encode()); }
+
+    template<typename OutputIt>
+    OutputIt ChunkColumn::formatTo(OutputIt out) const {
+        out = std::format_to(out, "ChunkColumn({} sections, {} block entities, ", data_->sections.size(), data_->blockEntityCount);
+        out = data_->light.formatTo(out);
+        *out++ = ')';
+
+        return out;
+    }
+
+    template<typename OutputIt>
+    OutputIt ChunkColumn::formatHexTo(OutputIt out) const {
+        return minecraft::hexTo(out, encode());
+    }
+
+}  // namespace minecraft::protocol
+
+#endif  // CHUNK_HPP
@@ -18,7 +18,8 @@
 #pragma once
 
 #include "../../utils/utils.h"
-#include <sstream>
+#include <algorithm>
+#include <iterator>
 
 namespace minecraft::protocol {
 
@@ -85,30 +86,43 @@ namespace minecraft::protocol {
 
     template<typename... Ts>
     std::string CompoundArray<Ts...>::toString() const {
-        std::stringstream ss;
+        std::string result;
 
-        ss << "[";
+        formatTo(std::back_inserter(result));
+
+        return result;
+    }
+
+    template<typename... Ts>
+    std::string CompoundArray<Ts...>::toHexString() const {
+        return minecraft::toHexString(encode());
+    }
+
+    template<typename... Ts>
+    template<typename OutputIt>
+    OutputIt CompoundArray<Ts...>::formatTo(OutputIt out) const {
+        *out++ = '[';
 
         [&, this]<std::size_t... Is>(std::index_sequence<Is...>) {
             (..., [&] {
-                if (Is != 0) ss << ", ";
+                if (Is != 0) out = std::ranges::copy(std::string_view(", "), out).out;
 
-                if constexpr (requires { std::get<Is>(value_).toString(); })
-                    ss << std::get<Is>(value_).toString();
-
-                else
-                    ss << std::get<Is>(value_);
+                out = minecraft::detail::formatValueTo(out, std::get<Is>(value_));
             }());
         }(std::make_index_sequence<sizeof...(Ts)>{});
 
-        ss << "]";
+        *out++ = ']';
 
-        return ss.str();
+        return out;
     }
 
     template<typename... Ts>
-    std::string CompoundArray<Ts...>::toHexString() const {
-        return minecraft::toHexString(encode());
+    template<typename OutputIt>
+    OutputIt CompoundArray<Ts...>::formatHexTo(OutputIt out) const {
+        // 首次调用时填充编码缓存，之后直接读取缓存
+        if (!cached) encode();
+
+        return minecraft::hexTo(out, data);
     }
 
 
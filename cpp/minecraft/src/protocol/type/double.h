@@ -235,6 +235,38 @@ namespace minecraft::protocol {
          * @endif
          */
         [[nodiscard]] std::string toHexString() const;
+
+        /**
+         * @if zh
+         * @brief 将可读表示写入输出迭代器，不构造临时字符串
+         * @details 保留六位小数，与 @c std::to_string 一致
+         * @param out 输出迭代器
+         * @return 写入结束后的迭代器
+         *
+         * @else
+         * @brief Write the human-readable representation to an output iterator without building a temporary string
+         * @details Six decimal places, consistent with @c std::to_string
+         * @param out Output iterator
+         * @return Iterator past the written characters
+         *
+         * @endif
+         */
+        template<typename OutputIt>
+        OutputIt formatTo(OutputIt out) const;
+
+        /**
+         * @if zh
+         * @brief 将十六进制表示写入输出迭代器
+         * @details 完整序列化数据，每字节形如"\\0xab"
+         *
+         * @else
+         * @brief Write the hexadecimal representation to an output iterator
+         * @details The complete serialized data, each byte as "\\0xab"
+         *
+         * @endif
+         */
+        template<typename OutputIt>
+        OutputIt formatHexTo(OutputIt out) const;
     };
 
     /** @concept is_double_field
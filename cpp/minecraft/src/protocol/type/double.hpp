@@ -19,6 +19,7 @@
 
 #include "../../utils/utils.h"
 #include <bit>
+#include <format>
 
 namespace minecraft::protocol {
     inline Double::Double(double value)
@@ -57,10 +58,26 @@ namespace minecraft::protocol {
         return value;
     }
 
-    inline std::string Double::toString() const { return std::to_string(value_); }
+    inline std::string Double::toString() const {
+        std::string result;
+
+        formatTo(std::back_inserter(result));
+
+        return result;
+    }
 
     inline std::string Double::toHexString() const { return minecraft::toHexString(encode()); }
 
+    template<typename OutputIt>
+    OutputIt Double::formatTo(OutputIt out) const {
+        return std::format_to(out, "{:f}", value_);
+    }
+
+    template<typename OutputIt>
+    OutputIt Double::formatHexTo(OutputIt out) const {
+        return minecraft::hexTo(out, encode());
+    }
+
 
 }  // namespace minecraft::protocol
 
@@ -19,6 +19,7 @@
 
 #include "../../utils/utils.h"
 #include <bit>
+#include <format>
 
 namespace minecraft::protocol {
     inline Float::Float(float value)
@@ -57,10 +58,26 @@ namespace minecraft::protocol {
         return result;
     }
 
-    inline std::string Float::toString() const { return std::to_string(value_); }
+    inline std::string Float::toString() const {
+        std::string result;
+
+        formatTo(std::back_inserter(result));
+
+        return result;
+    }
 
     inline std::string Float::toHexString() const { return minecraft::toHexString(encode()); }
 
+    template<typename OutputIt>
+    OutputIt Float::formatTo(OutputIt out) const {
+        return std::format_to(out, "{:f}", value_);
+    }
+
+    template<typename OutputIt>
+    OutputIt Float::formatHexTo(OutputIt out) const {
+        return minecraft::hexTo(out, encode());
+    }
+
 }  // namespace minecraft::protocol
 
 #endif  // FLOAT_HPP
@@ -282,6 +282,38 @@ namespace minecraft::protocol {
              * @endif
              */
             [[nodiscard]] std::string toHexString() const;
+
+            /**
+             * @if zh
+             * @brief 将可读表示写入输出迭代器，不构造临时字符串
+             * @details 十进制整数值
+             * @param out 输出迭代器
+             * @return 写入结束后的迭代器
+             *
+             * @else
+             * @brief Write the human-readable representation to an output iterator without building a temporary string
+             * @details Decimal integer value
+             * @param out Output iterator
+             * @return Iterator past the written characters
+             *
+             * @endif
+             */
+            template<typename OutputIt>
+            OutputIt formatTo(OutputIt out) const;
+
+            /**
+             * @if zh
+             * @brief 将十六进制表示写入输出迭代器
+             * @details 二进制位串，与 @c toHexString 一致
+             *
+             * @else
+             * @brief Write the hexadecimal representation to an output iterator
+             * @details Binary bit string, consistent with @c toHexString
+             *
+             * @endif
+             */
+            template<typename OutputIt>
+            OutputIt formatHexTo(OutputIt out) const;
         };
 
     }  // namespace detail
@@ -19,6 +19,7 @@
 
 #include <bit>
 #include <bitset>
+#include <format>
 #include <stdexcept>
 
 namespace minecraft::protocol::detail {
@@ -90,6 +91,22 @@ namespace minecraft::protocol::detail {
         return std::bitset<size_ * 8>(value_).to_string();
     }
 
+    template<typename T>
+    template<typename OutputIt>
+    OutputIt Integer<T>::formatTo(OutputIt out) const {
+        return std::format_to(out, "{}", value_);
+    }
+
+    template<typename T>
+    template<typename OutputIt>
+    OutputIt Integer<T>::formatHexTo(OutputIt out) const {
+        const auto bits = static_cast<std::make_unsigned_t<T>>(value_);
+
+        for (std::size_t i = size_ * 8; i-- > 0;) *out++ = bits >> i & 1 ? '1' : '0';
+
+        return out;
+    }
+
 }  // namespace minecraft::protocol::detail
 
 
@@ -238,6 +238,38 @@ namespace minecraft::protocol {
          * @endif
          */
         [[nodiscard]] std::string toHexString() const;
+
+        /**
+         * @if zh
+         * @brief 将可读表示写入输出迭代器，不构造临时字符串
+         * @details 内部值，无值时为"null"
+         * @param out 输出迭代器
+         * @return 写入结束后的迭代器
+         *
+         * @else
+         * @brief Write the human-readable representation to an output iterator without building a temporary string
+         * @details The contained value, "null" when empty
+         * @param out Output iterator
+         * @return Iterator past the written characters
+         *
+         * @endif
+         */
+        template<typename OutputIt>
+        OutputIt formatTo(OutputIt out) const;
+
+        /**
+         * @if zh
+         * @brief 将十六进制表示写入输出迭代器
+         * @details 无值时不写入任何内容
+         *
+         * @else
+         * @brief Write the hexadecimal representation to an output iterator
+         * @details Nothing is written when empty
+         *
+         * @endif
+         */
+        template<typename OutputIt>
+        OutputIt formatHexTo(OutputIt out) const;
     };
 
     /**
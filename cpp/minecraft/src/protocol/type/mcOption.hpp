@@ -29,7 +29,7 @@ namespace minecraft::protocol {
     Option<T>::Option(const std::optional<T>& value)
         : value_(value) {
         if ((size_ = value.has_value())) {
-            if constexpr (requires { T::size(); })
+            if constexpr (requires(const T& t) { t.size(); })
                 size_ = value.value().size();
 
             else
@@ -51,10 +51,11 @@ namespace minecraft::protocol {
     typename Option<T>::encodeType Option<T>::encode() const {
         if (!cached) {
             if (value_.has_value()) {
-                if constexpr (requires { T::encode(); })
-                    data = value_.value().encode();
+                if constexpr (requires(const T& t) { t.encode(); }) {
+                    const auto bytes = value_.value().encode();
 
-                else
+                    data.assign(bytes.begin(), bytes.end());
+                } else
                     data.push_back(static_cast<std::byte>(*value_));
             }
 
@@ -79,18 +80,11 @@ namespace minecraft::protocol {
 
     template<typename T>
     std::string Option<T>::toString() const {
-        if (value_.has_value()) {
-            if constexpr (requires (T t) { t.toString(); })
-                return value_.value().toString();
+        std::string result;
 
-            else if constexpr (requires { std::to_string(*value_); })
-                return std::to_string(value_.value());
+        formatTo(std::back_inserter(result));
 
-            else
-                return std::to_string(static_cast<std::byte>(*value_));
-        }
-
-        return "null";
+        return result;
     }
 
     template<typename T>
@@ -100,6 +94,24 @@ namespace minecraft::protocol {
         return "";
     }
 
+    template<typename T>
+    template<typename OutputIt>
+    OutputIt Option<T>::formatTo(OutputIt out) const {
+        if (value_.has_value()) return minecraft::detail::formatValueTo(out, *value_);
+
+        return std::ranges::copy(std::string_view("null"), out).out;
+    }
+
+    template<typename T>
+    template<typename OutputIt>
+    OutputIt Option<T>::formatHexTo(OutputIt out) const {
+        if (!value_.has_value()) return out;
+
+        if (!cached) encode();
+
+        return minecraft::hexTo(out, data);
+    }
+
 }  // namespace minecraft::protocol
 
 #endif  // MCOPTION_HPP
@@ -18,7 +18,8 @@
 #pragma once
 
 #include "../../utils/utils.h"
-#include <sstream>
+#include <algorithm>
+#include <iterator>
 
 namespace minecraft::protocol {
 
@@ -41,8 +42,8 @@ namespace minecraft::protocol {
     typename Array<T>::encodeType Array<T>::encode() const {
         if (!cached) {
             for (const auto& elem : value_)
-                if constexpr (requires { elem.serialize(); })
-                    data.insert_range(data.end(), elem.serialize());
+                if constexpr (requires { elem.encode(); })
+                    data.insert_range(data.end(), elem.encode());
                 else
                     data.push_back(static_cast<std::byte>(elem));
 
@@ -54,7 +55,29 @@ namespace minecraft::protocol {
 
     template<typename T>
     auto Array<T>::decode(const std::byte* data, const VarInt& sizeField) {
-        return decode(data, sizeField.value());
+        // 依赖字段给出的是元素个数，只有字节数组时才等于字节数
+        if constexpr (requires { T::decode(data); }) {
+            const auto start = data;
+
+            type result;
+
+            for (int i = 0; i < sizeField.value(); i++) {
+                auto elem = T::decode(data);
+
+                data += elem.size();
+
+                result.push_back(std::move(elem));
+            }
+
+            Array array(result);
+
+            array.size_ = static_cast<std::size_t>(data - start);
+
+            return array;
+        }
+
+        else
+            return decode(data, static_cast<std::size_t>(sizeField.value()));
     }
 
     template<typename T>
@@ -80,31 +103,40 @@ namespace minecraft::protocol {
 
     template<typename T>
     std::string Array<T>::toString() const {
-        std::stringstream ss;
+        std::string result;
 
-        ss << "[";
+        formatTo(std::back_inserter(result));
 
-        for (std::size_t i{0}; const auto& elem : value_) {
-            if (i > 0) ss << ", ";
+        return result;
+    }
 
-            if constexpr (requires { elem.toString(); })
-                ss << elem.toString();
-            else if constexpr (requires { std::to_string(elem); })
-                ss << std::to_string(elem);
-            else
-                ss << static_cast<char>(elem);
+    template<typename T>
+    std::string Array<T>::toHexString() const {
+        return minecraft::toHexString(encode());
+    }
 
-            i++;
+    template<typename T>
+    template<typename OutputIt>
+    OutputIt Array<T>::formatTo(OutputIt out) const {
+        *out++ = '[';
+
+        for (std::size_t i{0}; const auto& elem : value_) {
+            if (i++ > 0) out = std::ranges::copy(std::string_view(", "), out).out;
+
+            out = minecraft::detail::formatValueTo(out, elem);
         }
 
-        ss << "]";
+        *out++ = ']';
 
-        return ss.str();
+        return out;
     }
 
     template<typename T>
-    std::string Array<T>::toHexString() const {
-        return minecraft::toHexString(encode());
+    template<typename OutputIt>
+    OutputIt Array<T>::formatHexTo(OutputIt out) const {
+        if (!cached) encode();
+
+        return minecraft::hexTo(out, data);
     }
 
 
@@ -69,6 +69,18 @@ namespace minecraft::protocol {
          * @endif
          */
         std::string uuidToString(const std::array<std::byte, 16>& uuidBytes);
+
+        /**
+         * @if zh
+         * @brief 将UUID按8-4-4-4-12格式写入输出迭代器
+         *
+         * @else
+         * @brief Write a UUID in the 8-4-4-4-12 form to an output iterator
+         *
+         * @endif
+         */
+        template<typename OutputIt>
+        OutputIt uuidTo(OutputIt out, const std::array<std::byte, 16>& uuidBytes);
     }  // namespace detail
 
     /** @struct UUID
@@ -269,6 +281,38 @@ namespace minecraft::protocol {
          * @endif
          */
         [[nodiscard]] std::string toHexString() const;
+
+        /**
+         * @if zh
+         * @brief 将可读表示写入输出迭代器，不构造临时字符串
+         * @details 标准的8-4-4-4-12形式
+         * @param out 输出迭代器
+         * @return 写入结束后的迭代器
+         *
+         * @else
+         * @brief Write the human-readable representation to an output iterator without building a temporary string
+         * @details The standard 8-4-4-4-12 form
+         * @param out Output iterator
+         * @return Iterator past the written characters
+         *
+         * @endif
+         */
+        template<typename OutputIt>
+        OutputIt formatTo(OutputIt out) const;
+
+        /**
+         * @if zh
+         * @brief 将十六进制表示写入输出迭代器
+         * @details 16个原始字节
+         *
+         * @else
+         * @brief Write the hexadecimal representation to an output iterator
+         * @details The 16 raw bytes
+         *
+         * @endif
+         */
+        template<typename OutputIt>
+        OutputIt formatHexTo(OutputIt out) const;
     };
 
     /**
@@ -20,7 +20,7 @@
 #include "../../utils/md5.h"
 #include "../../utils/utils.h"
 #include "../../utils/uuid.h"
-#include <sstream>
+#include <iterator>
 
 namespace minecraft::protocol {
     namespace detail {
@@ -40,16 +40,28 @@ namespace minecraft::protocol {
             return result;
         }
 
-        inline std::string uuidToString(const std::array<std::byte, 16>& uuidBytes) {
-            std::stringstream ss;
-
+        template<typename OutputIt>
+        OutputIt uuidTo(OutputIt out, const std::array<std::byte, 16>& uuidBytes) {
             for (std::size_t i{0}; i < 16; i++) {
-                ss << std::hex << static_cast<int>(uuidBytes[i]);
+                const auto& pair = minecraft::detail::HEX_PAIRS[static_cast<unsigned char>(uuidBytes[i])];
 
-                if (i == 3 || i == 5 || i == 7 || i == 9) ss << "-";
+                *out++ = pair[0];
+                *out++ = pair[1];
+
+                if (i == 3 || i == 5 || i == 7 || i == 9) *out++ = '-';
             }
 
-            return ss.str();
+            return out;
+        }
+
+        inline std::string uuidToString(const std::array<std::byte, 16>& uuidBytes) {
+            std::string result;
+
+            result.reserve(36);
+
+            uuidTo(std::back_inserter(result), uuidBytes);
+
+            return result;
         }
     }  // namespace detail
 
@@ -77,6 +89,16 @@ namespace minecraft::protocol {
 
     inline std::string UUID::toHexString() const { return minecraft::toHexString(value_); }
 
+    template<typename OutputIt>
+    OutputIt UUID::formatTo(OutputIt out) const {
+        return detail::uuidTo(out, value_);
+    }
+
+    template<typename OutputIt>
+    OutputIt UUID::formatHexTo(OutputIt out) const {
+        return minecraft::hexTo(out, value_);
+    }
+
     template<typename T>
     auto genUUID(T str) {
         return detail::javaUUID(str);
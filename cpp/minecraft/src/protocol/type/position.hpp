@@ -19,6 +19,7 @@
 
 #include "../../utils/utils.h"
 #include "integer.h"
+#include <format>
 
 namespace minecraft::protocol {
 
@@ -68,10 +69,26 @@ namespace minecraft::protocol {
         return Position{x, y, z};
     }
 
-    inline std::string Position::toString() const { return "(" + std::to_string(x_) + ", " + std::to_string(y_) + ", " + std::to_string(z_) + ")"; }
+    inline std::string Position::toString() const {
+        std::string result;
+
+        formatTo(std::back_inserter(result));
+
+        return result;
+    }
 
     inline std::string Position::toHexString() const { return minecraft::toHexString(encode()); }
 
+    template<typename OutputIt>
+    OutputIt Position::formatTo(OutputIt out) const {
+        return std::format_to(out, "({}, {}, {})", x_, y_, z_);
+    }
+
+    template<typename OutputIt>
+    OutputIt Position::formatHexTo(OutputIt out) const {
+        return minecraft::hexTo(out, encode());
+    }
+
 
 }  // namespace minecraft::protocol
 
@@ -19,7 +19,9 @@
 
 #include "prefixedArray.h"
 #include "str.h"
-#include <sstream>
+#include "../../utils/utils.h"
+#include <algorithm>
+#include <iterator>
 
 namespace minecraft::protocol {
 
@@ -49,7 +51,7 @@ namespace minecraft::protocol {
     template<typename T>
     typename PrefixedArray<T>::encodeType PrefixedArray<T>::encode() const {
         if (!cached) {
-            data = VarInt(size_).encode();
+            data = VarInt(static_cast<int>(value_.size())).encode();
 
             for (const auto& elem : value_) data.insert_range(data.end(), elem.encode());
 
@@ -79,28 +81,40 @@ namespace minecraft::protocol {
 
     template<typename T>
     std::string PrefixedArray<T>::toString() const {
-        std::ostringstream oss;
+        std::string result;
 
-        oss << "[";
+        formatTo(std::back_inserter(result));
 
-        for (std::size_t i{0}; i < value_.size(); i++) {
-            if constexpr (requires { value_[i].toString(); })
-                oss << value_[i].toString();
+        return result;
+    }
 
-            else
-                oss << value_[i];
+    template<typename T>
+    std::string PrefixedArray<T>::toHexString() const {
+        return minecraft::toHexString(encode());
+    }
 
-            oss << (i == value_.size() - 1 ? "" : ", ");
+    template<typename T>
+    template<typename OutputIt>
+    OutputIt PrefixedArray<T>::formatTo(OutputIt out) const {
+        *out++ = '[';
+
+        for (std::size_t i{0}; i < value_.size(); i++) {
+            if (i > 0) out = std::ranges::copy(std::string_view(", "), out).out;
+
+            out = minecraft::detail::formatValueTo(out, value_[i]);
         }
 
-        oss << "]";
+        *out++ = ']';
 
-        return oss.str();
+        return out;
     }
 
     template<typename T>
-    std::string PrefixedArray<T>::toHexString() const {
-        return minecraft::toHexString(encode());
+    template<typename OutputIt>
+    OutputIt PrefixedArray<T>::formatHexTo(OutputIt out) const {
+        if (!cached) encode();
+
+        return minecraft::hexTo(out, data);
     }
 
 }  // namespace minecraft::protocol
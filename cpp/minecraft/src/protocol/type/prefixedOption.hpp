@@ -33,7 +33,7 @@ namespace minecraft::protocol {
         size_ = Boolean::size();
 
         if (value.has_value()) {
-            if constexpr (requires { T::size(); })
+            if constexpr (requires(const T& t) { t.size(); })
                 size_ += value.value().size();
             else
                 size_++;
@@ -56,7 +56,7 @@ namespace minecraft::protocol {
         encodeType result{boolBytes.begin(), boolBytes.end()};
 
         if (value_.has_value()) {
-            if constexpr (requires { T::encode(); }) {
+            if constexpr (requires(const T& t) { t.encode(); }) {
                 auto valueBytes = value_.value().encode();
 
                 result.insert_range(result.end(), valueBytes);
@@ -73,8 +73,8 @@ namespace minecraft::protocol {
         data += Boolean::size();
 
         if (boolValue) {
-            if constexpr (requires { T::deencode(data); })
-                return PrefixedOption(T::deencode(data));
+            if constexpr (requires { T::decode(data); })
+                return PrefixedOption(T::decode(data));
 
             else
                 return PrefixedOption(static_cast<T>(*data));
@@ -85,14 +85,11 @@ namespace minecraft::protocol {
 
     template<typename T>
     std::string PrefixedOption<T>::toString() const {
-        if (value_.has_value()) {
-            if constexpr (requires { T::toString(); })
-                return value_.value().toString();
-            else
-                return std::to_string(value_.value());
-        }
+        std::string result;
+
+        formatTo(std::back_inserter(result));
 
-        return "null";
+        return result;
     }
 
     template<typename T>
@@ -100,6 +97,28 @@ namespace minecraft::protocol {
         return minecraft::toHexString(encode());
     }
 
+    template<typename T>
+    template<typename OutputIt>
+    OutputIt PrefixedOption<T>::formatTo(OutputIt out) const {
+        if (value_.has_value()) return minecraft::detail::formatValueTo(out, *value_);
+
+        return std::ranges::copy(std::string_view("null"), out).out;
+    }
+
+    template<typename T>
+    template<typename OutputIt>
+    OutputIt PrefixedOption<T>::formatHexTo(OutputIt out) const {
+        out = minecraft::hexTo(out, Boolean(value_.has_value()).encode());
+
+        if (!value_.has_value()) return out;
+
+        if constexpr (requires { value_->encode(); })
+            return minecraft::hexTo(out, value_->encode(), true);
+
+        else
+            return minecraft::hexTo(out, std::array{static_cast<std::byte>(*value_)}, true);
+    }
+
 }  // namespace minecraft::protocol
 
 #endif  // PREFIXEDOPTION_HPP
@@ -84,19 +84,27 @@ namespace minecraft::protocol {
     }
 
     inline std::string String::toString() const {
-        std::stringstream ss;
+        std::string result;
+
+        result.reserve(value_.size());
 
-        for (std::size_t i = 0; i < value_.size(); ++i)
-            if (std::isprint(static_cast<unsigned char>(value_[i])))
-                ss << value_[i];
-            else
-                ss << (i == 0 ? "" : " ") << "\\0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(value_[i]);
+        formatTo(std::back_inserter(result));
 
-        return ss.str();
+        return result;
     }
 
     inline std::string String::toHexString() const { return minecraft::toHexString(value_); }
 
+    template<typename OutputIt>
+    OutputIt String::formatTo(OutputIt out) const {
+        return minecraft::escapeTo(out, value_);
+    }
+
+    template<typename OutputIt>
+    OutputIt String::formatHexTo(OutputIt out) const {
+        return minecraft::hexTo(out, value_);
+    }
+
 }  // namespace minecraft::protocol
 
 #endif  // STR_HPP
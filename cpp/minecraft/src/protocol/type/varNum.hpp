@@ -18,6 +18,7 @@
 #pragma once
 
 #include "../../utils/utils.h"
+#include <format>
 
 namespace minecraft::protocol::detail {
     template<typename T>
@@ -99,6 +100,20 @@ namespace minecraft::protocol::detail {
         return minecraft::toHexString(encode());
     }
 
+    template<intOrLong T>
+    template<typename OutputIt>
+    OutputIt VarNum<T>::formatTo(OutputIt out) const {
+        return std::format_to(out, "{}", value_);
+    }
+
+    template<intOrLong T>
+    template<typename OutputIt>
+    OutputIt VarNum<T>::formatHexTo(OutputIt out) const {
+        if (data.empty()) encode();
+
+        return minecraft::hexTo(out, data);
+    }
+
 }  // namespace minecraft::protocol::detail
 
 #endif  // VARNUM_HPP
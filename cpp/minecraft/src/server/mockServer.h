@@ -0,0 +1,341 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file mockServer.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 02:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef MOCKSERVER_H
+#define MOCKSERVER_H
+#pragma once
+
+#include "../client/clientBase.h"
+#include "../client/latency.h"
+#include "../protocol/package/definition.h"
+#include "../protocol/package/frame.h"
+#include "../protocol/package/package.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace minecraft::server {
+
+    /** @struct MockServerConfig
+     *
+     * @if zh
+     * @brief 模拟服务器的脚本参数
+     * @details
+     * - @c port 为0时由系统分配临时端口，启动后从 @c MockServer::port 读取
+     * - @c compressionThreshold 为负数时不发送SetCompression，整个会话不压缩
+     * - @c teleportInterval 为0时只在进入游戏阶段后传送一次
+     * - @c trafficRate 为每个连接每秒发送的游戏数据包数量，为0时只有KeepAlive与传送
+     *
+     * @else
+     * @brief Script parameters of the mock server
+     * @details
+     * - a @c port of 0 lets the system pick an ephemeral port, read it from @c MockServer::port after starting
+     * - a negative @c compressionThreshold skips SetCompression, the whole session stays uncompressed
+     * - a @c teleportInterval of 0 teleports only once, right after entering play
+     * - @c trafficRate is the number of play packets per second per connection, 0 sends only KeepAlive and teleports
+     *
+     * @endif
+     * */
+    struct MockServerConfig {
+        std::string host = "127.0.0.1";
+
+        std::uint16_t port = 0;
+
+        int compressionThreshold = 256;
+
+        std::chrono::milliseconds keepAliveInterval{1000};
+
+        std::chrono::milliseconds teleportInterval{0};
+
+        double trafficRate = 0;
+
+        // 落后于目标速率时单轮最多补发的数据包数，超出部分丢弃而不是突发
+        std::size_t trafficBurst = 64;
+
+        std::size_t maxConnections = 1024;
+
+        // 往返时间统计窗口的样本数，所有连接共用
+        std::size_t latencySamples = 4096;
+
+        std::string statusJson = R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":20,"online":0},"description":{"text":"mock server"}})";
+    };
+
+    /** @struct MockServerStats
+     *
+     * @if zh
+     * @brief 所有连接累计的计数与服务器侧测得的往返时间
+     * @details 往返时间从服务器写出KeepAlive或传送到读到对应回复为止，包含客户端的解码与回复排队
+     *
+     * @else
+     * @brief Counters accumulated over all connections and round trips measured on the server side
+     * @details A round trip spans from writing a KeepAlive or teleport to reading the matching reply,
+     * which includes decoding and reply queueing on the client
+     *
+     * @endif
+     * */
+    struct MockServerStats {
+        std::uint64_t accepted = 0;
+
+        std::uint64_t active = 0;
+
+        std::uint64_t logins = 0;
+
+        std::uint64_t packetsSent = 0;
+
+        std::uint64_t packetsReceived = 0;
+
+        std::uint64_t bytesSent = 0;
+
+        std::uint64_t bytesReceived = 0;
+
+        std::uint64_t trafficPackets = 0;
+
+        std::uint64_t movements = 0;
+
+        std::uint64_t protocolErrors = 0;
+
+        client::LatencySummary keepAliveRtt;
+
+        client::LatencySummary teleportRtt;
+    };
+
+    /** @class MockServer
+     *
+     * @if zh
+     * @brief 本地脚本化的Minecraft服务器，用于端到端测试与基准测试
+     * @details
+     * - 每个连接一个线程，按与 @c client::Client 相同的数据包定义收发
+     * - 状态查询返回 @c statusJson 并回应Ping
+     * - 登录：LoginStart后发送SetCompression与LoginSuccess，收到LoginConfirm后进入游戏阶段
+     * - 游戏阶段：立即传送一次，统计客户端的移动数据包，按间隔发送KeepAlive与传送，并以目标速率生成实体速度、实体生成、经验球数据包
+     * - 只监听本地地址时不依赖外部服务器，测试结果可复现
+     *
+     * @else
+     * @brief Local scripted Minecraft server for end-to-end tests and benchmarks
+     * @details
+     * - One thread per connection, sending and parsing with the same packet definitions as @c client::Client
+     * - Status requests get @c statusJson and pings are answered
+     * - Login: SetCompression and LoginSuccess follow LoginStart, LoginConfirm enters play
+     * - Play: one teleport right away, movement packets from the client are counted, KeepAlive and teleports at their intervals, and entity velocity,
+     *   entity spawn and experience orb packets generated at the target rate
+     * - Listening on loopback needs no external server, so results are hermetic
+     *
+     * @endif
+     * */
+    class MockServer {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit MockServer(MockServerConfig config = {});
+
+        MockServer(const MockServer&) = delete;
+
+        MockServer& operator=(const MockServer&) = delete;
+
+        ~MockServer();
+
+        /**
+         * @if zh
+         * @brief 绑定端口并启动接受线程
+         * @return 绑定或监听失败时返回false
+         *
+         * @else
+         * @brief Bind the port and start the accept thread
+         * @return false when binding or listening fails
+         *
+         * @endif
+         * */
+        bool start();
+
+        /**
+         * @if zh
+         * @brief 停止接受新连接，关闭所有连接并等待其线程结束
+         *
+         * @else
+         * @brief Stop accepting, close every connection and wait for their threads
+         *
+         * @endif
+         * */
+        void stop();
+
+        [[nodiscard]] std::uint16_t port() const;
+
+        [[nodiscard]] MockServerStats stats() const;
+
+        [[nodiscard]] const MockServerConfig& config() const;
+
+    private:
+        class Session;
+
+        struct Counters {
+            std::atomic<std::uint64_t> accepted = 0;
+
+            std::atomic<std::uint64_t> active = 0;
+
+            std::atomic<std::uint64_t> logins = 0;
+
+            std::atomic<std::uint64_t> packetsSent = 0;
+
+            std::atomic<std::uint64_t> packetsReceived = 0;
+
+            std::atomic<std::uint64_t> bytesSent = 0;
+
+            std::atomic<std::uint64_t> bytesReceived = 0;
+
+            std::atomic<std::uint64_t> trafficPackets = 0;
+
+            std::atomic<std::uint64_t> movements = 0;
+
+            std::atomic<std::uint64_t> protocolErrors = 0;
+        };
+
+        MockServerConfig settings;
+
+        SOCKET listener = INVALID_SOCKET;
+
+        std::uint16_t boundPort = 0;
+
+        std::atomic_bool stopFlag = false;
+
+        std::thread acceptThread;
+
+        std::mutex sessionsMutex;
+
+        std::vector<std::unique_ptr<Session>> sessions;
+
+        Counters counters;
+
+        client::RollingWindow keepAliveRtt;
+
+        client::RollingWindow teleportRtt;
+
+        void acceptLoop();
+
+        // 回收已结束的连接，调用方持有sessionsMutex
+        void reap();
+    };
+
+    /** @class MockServer::Session
+     *
+     * @if zh
+     * @brief 一个连接的脚本状态机
+     * @details 以短超时等待套接字可读，等待间隙驱动KeepAlive、传送与流量生成；一轮中产生的数据包合并为一次写入
+     *
+     * @else
+     * @brief Scripted state machine of one connection
+     * @details Readability is awaited with a short timeout, the gaps between reads drive KeepAlive, teleports and traffic;
+     * packets produced in one round are coalesced into one write
+     *
+     * @endif
+     * */
+    class MockServer::Session {
+    public:
+        Session(MockServer& server, SOCKET sock, std::uint64_t seed);
+
+        Session(const Session&) = delete;
+
+        Session& operator=(const Session&) = delete;
+
+        ~Session();
+
+        [[nodiscard]] bool finished() const;
+
+    private:
+        static constexpr int TICK_MS = 5;
+
+        // 未回复的挑战最多保留的数量，超出时丢弃最旧的
+        static constexpr std::size_t MAX_PENDING = 64;
+
+        struct Pending {
+            std::int64_t id;
+
+            Clock::time_point sent;
+        };
+
+        MockServer& server;
+
+        SOCKET sock;
+
+        std::atomic_bool done = false;
+
+        protocol::State state = protocol::State::HANDSHAKE;
+
+        bool compress = false;
+
+        protocol::FrameReader reader;
+
+        std::vector<std::byte> frame;
+
+        std::vector<std::byte> outgoing;
+
+        std::array<char, 64 * 1024> recvBuf{};
+
+        std::minstd_rand rng;
+
+        std::vector<Pending> keepAlives;
+
+        std::vector<Pending> teleports;
+
+        std::int64_t nextKeepAliveId = 1;
+
+        int nextTeleportId = 1;
+
+        int nextEntityId = 1;
+
+        Clock::time_point nextKeepAlive;
+
+        Clock::time_point nextTeleport;
+
+        Clock::time_point trafficStart;
+
+        std::uint64_t trafficSent = 0;
+
+        std::thread thread;
+
+        void run();
+
+        void handle(const std::vector<std::byte>& data);
+
+        template<protocol::is_package T>
+        void on(const T& packet);
+
+        void enterPlay();
+
+        void tick(Clock::time_point now);
+
+        void teleport(Clock::time_point now);
+
+        void traffic();
+
+        template<protocol::is_package T>
+        void queue(const T& packet);
+
+        bool flush();
+
+        static void answered(std::vector<Pending>& pending, std::int64_t id, client::RollingWindow& window);
+    };
+
+}  // namespace minecraft::server
+
+#include "mockServer.hpp"
+
+#endif  // MOCKSERVER_H
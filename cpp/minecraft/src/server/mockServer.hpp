@@ -0,0 +1,412 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file mockServer.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 02:10
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef MOCKSERVER_HPP
+#define MOCKSERVER_HPP
+#pragma once
+
+#ifdef _WIN32
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/select.h>
+#endif
+
+#include <algorithm>
+#include <format>
+
+namespace minecraft::server {
+
+    namespace detail {
+#ifdef _WIN32
+        using AddrLen = int;
+
+        inline constexpr int SEND_FLAGS = 0;
+#else
+        using AddrLen = socklen_t;
+
+        // 对端已关闭时send返回错误而不是触发SIGPIPE
+        inline constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#endif
+
+        inline void setNoDelay(const SOCKET sock) {
+            const int enable = 1;
+
+            setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&enable), sizeof(enable));
+        }
+    }  // namespace detail
+
+    inline MockServer::MockServer(MockServerConfig config)
+        : settings(std::move(config))
+        , keepAliveRtt(settings.latencySamples)
+        , teleportRtt(settings.latencySamples) {}
+
+    inline MockServer::~MockServer() { stop(); }
+
+    inline bool MockServer::start() {
+        if (listener != INVALID_SOCKET) return false;
+
+        client::detail::scoketInit();
+
+        const auto fail = [this] {
+            client::detail::socketClose(listener);
+            listener = INVALID_SOCKET;
+
+            return false;
+        };
+
+        listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+        if (listener == INVALID_SOCKET) return fail();
+
+        const int reuse = 1;
+
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port   = htons(settings.port);
+
+        if (inet_pton(AF_INET, settings.host.c_str(), &addr.sin_addr) != 1) return fail();
+
+        if (bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR || listen(listener, SOMAXCONN) == SOCKET_ERROR) return fail();
+
+        detail::AddrLen length = sizeof(addr);
+
+        if (getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &length) == SOCKET_ERROR) return fail();
+
+        boundPort = ntohs(addr.sin_port);
+
+        stopFlag     = false;
+        acceptThread = std::thread(&MockServer::acceptLoop, this);
+
+        debugInfo([this] { return std::format("Mock server listening on {}:{}", settings.host, boundPort); });
+
+        return true;
+    }
+
+    inline void MockServer::stop() {
+        stopFlag = true;
+
+        if (acceptThread.joinable()) acceptThread.join();
+
+        // 连接线程在下一次等待超时时看到停止标志，析构时等待其结束
+        {
+            std::lock_guard lock(sessionsMutex);
+
+            sessions.clear();
+        }
+
+        if (listener != INVALID_SOCKET) {
+            client::detail::socketClose(listener);
+            listener = INVALID_SOCKET;
+        }
+    }
+
+    inline std::uint16_t MockServer::port() const { return boundPort; }
+
+    inline const MockServerConfig& MockServer::config() const { return settings; }
+
+    inline MockServerStats MockServer::stats() const {
+        constexpr auto order = std::memory_order_relaxed;
+
+        return {counters.accepted.load(order),
+                counters.active.load(order),
+                counters.logins.load(order),
+                counters.packetsSent.load(order),
+                counters.packetsReceived.load(order),
+                counters.bytesSent.load(order),
+                counters.bytesReceived.load(order),
+                counters.trafficPackets.load(order),
+                counters.movements.load(order),
+                counters.protocolErrors.load(order),
+                keepAliveRtt.summary(),
+                teleportRtt.summary()};
+    }
+
+    inline void MockServer::acceptLoop() {
+        while (!stopFlag) {
+            // accept本身不受接收超时影响，先用select等待，保证能及时看到停止标志
+            fd_set readable;
+            FD_ZERO(&readable);
+            FD_SET(listener, &readable);
+
+            timeval timeout{0, client::RECV_TICK_MS * 1000};
+
+            if (select(static_cast<int>(listener) + 1, &readable, nullptr, nullptr, &timeout) <= 0) continue;
+
+            const SOCKET sock = accept(listener, nullptr, nullptr);
+
+            if (sock == INVALID_SOCKET) continue;
+
+            std::lock_guard lock(sessionsMutex);
+
+            reap();
+
+            if (sessions.size() >= settings.maxConnections) {
+                closesocket(sock);
+                continue;
+            }
+
+            detail::setNoDelay(sock);
+
+            const auto index = counters.accepted.fetch_add(1, std::memory_order_relaxed);
+
+            counters.active.fetch_add(1, std::memory_order_relaxed);
+
+            sessions.push_back(std::make_unique<Session>(*this, sock, index + 1));
+        }
+    }
+
+    inline void MockServer::reap() {
+        std::erase_if(sessions, [](const auto& session) { return session->finished(); });
+    }
+
+    inline MockServer::Session::Session(MockServer& server, const SOCKET sock, const std::uint64_t seed)
+        : server(server)
+        , sock(sock)
+        , rng(static_cast<std::minstd_rand::result_type>(seed)) {
+        thread = std::thread(&Session::run, this);
+    }
+
+    inline MockServer::Session::~Session() {
+        if (thread.joinable()) thread.join();
+    }
+
+    inline bool MockServer::Session::finished() const { return done.load(std::memory_order_acquire); }
+
+    inline void MockServer::Session::run() {
+        while (!server.stopFlag) {
+            const int ready = client::detail::waitReadable(sock, TICK_MS);
+
+            if (ready < 0) break;
+
+            // 超时时不读取，直接推进定时发送
+            if (ready > 0) {
+                const int len = recv(sock, recvBuf.data(), static_cast<int>(recvBuf.size()), 0);
+
+                if (len == SOCKET_ERROR || len == 0) break;
+
+                server.counters.bytesReceived.fetch_add(static_cast<std::uint64_t>(len), std::memory_order_relaxed);
+
+                reader.feed(reinterpret_cast<const std::byte*>(recvBuf.data()), static_cast<std::size_t>(len));
+
+                bool valid = true;
+
+                try {
+                    while (reader.next(frame)) handle(frame);
+                } catch (const std::exception& e) {
+                    server.counters.protocolErrors.fetch_add(1, std::memory_order_relaxed);
+
+                    debugInfo<LogLevel::WARNING>([&e] { return std::format("Mock server dropped a connection: {}", e.what()); });
+
+                    valid = false;
+                }
+
+                if (!valid) break;
+            }
+
+            if (state == protocol::State::PLAY) tick(Clock::now());
+
+            if (!flush()) break;
+        }
+
+        closesocket(sock);
+
+        server.counters.active.fetch_sub(1, std::memory_order_relaxed);
+
+        done.store(true, std::memory_order_release);
+    }
+
+    inline void MockServer::Session::handle(const std::vector<std::byte>& data) {
+        server.counters.packetsReceived.fetch_add(1, std::memory_order_relaxed);
+
+        const auto f = [this]<protocol::is_package T>(const T& packet) { on(packet); };
+
+        protocol::detail::DispatchTable<protocol::ClientPacketList, decltype(f), protocol::AcceptAll>::dispatch(state, protocol::peekPacketId(data, compress), data, compress, f,
+                                                                                                                protocol::AcceptAll{});
+    }
+
+    template<protocol::is_package T>
+    void MockServer::Session::on(const T& packet) {
+        using namespace protocol;
+        namespace svr = server_bound;
+        namespace cli = client_bound;
+
+        if constexpr (std::is_same_v<T, cli::handshake_step::HandShakePacketType>)
+            state = packet.template get<"NextState">().value() == 1 ? State::STATUS : State::LOGIN;
+
+        else if constexpr (std::is_same_v<T, cli::status_step::RequestPacketType>)
+            queue(svr::status_step::ResponsePacketType{String(server.settings.statusJson)});
+
+        else if constexpr (std::is_same_v<T, cli::status_step::PingPacketType>)
+            queue(svr::status_step::PongPacketType{Long(packet.template get<"Payload">().value())});
+
+        else if constexpr (std::is_same_v<T, cli::login_step::LoginStartPacketType>) {
+            // SetCompression本身不压缩，之后双方都切换到压缩格式
+            if (server.settings.compressionThreshold >= 0) {
+                queue(svr::login_step::CompressionPacketType{VarInt(server.settings.compressionThreshold)});
+
+                compress = true;
+            }
+
+            queue(svr::login_step::LoginSuccessPacketType{packet.template get<"UUID">(), packet.template get<"Name">()});
+        }
+
+        else if constexpr (std::is_same_v<T, cli::login_step::LoginConfirmPacketType>)
+            enterPlay();
+
+        else if constexpr (std::is_same_v<T, cli::play_step::KeepAlivePacketType>)
+            answered(keepAlives, packet.template get<"KeepAliveID">().value(), server.keepAliveRtt);
+
+        else if constexpr (std::is_same_v<T, cli::play_step::TeleportConfirmPacketType>)
+            answered(teleports, packet.template get<"TeleportID">().value(), server.teleportRtt);
+
+        else if constexpr (std::is_same_v<T, cli::play_step::SetPlayerPositionPacketType>)
+            server.counters.movements.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void MockServer::Session::enterPlay() {
+        const auto now = Clock::now();
+
+        state = protocol::State::PLAY;
+
+        server.counters.logins.fetch_add(1, std::memory_order_relaxed);
+
+        teleport(now);
+
+        nextKeepAlive = now;
+        trafficStart  = now;
+    }
+
+    inline void MockServer::Session::tick(const Clock::time_point now) {
+        const auto& settings = server.settings;
+
+        if (settings.keepAliveInterval.count() > 0 && now >= nextKeepAlive) {
+            // 与原版服务器相同，以毫秒时间戳作为ID，客户端据此估计到达延迟
+            const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            const auto id     = std::max<std::int64_t>(millis, nextKeepAliveId);
+
+            nextKeepAliveId = id + 1;
+
+            if (keepAlives.size() >= MAX_PENDING) keepAlives.erase(keepAlives.begin());
+
+            keepAlives.push_back({id, now});
+
+            queue(protocol::server_bound::play_step::KeepAlivePacketType{protocol::Long(id)});
+
+            nextKeepAlive = now + settings.keepAliveInterval;
+        }
+
+        if (settings.teleportInterval.count() > 0 && now >= nextTeleport) teleport(now);
+
+        if (settings.trafficRate <= 0) return;
+
+        const auto due = static_cast<std::uint64_t>(std::chrono::duration<double>(now - trafficStart).count() * settings.trafficRate);
+
+        if (due > trafficSent + settings.trafficBurst) trafficSent = due - settings.trafficBurst;
+
+        for (; trafficSent < due; ++trafficSent) traffic();
+    }
+
+    inline void MockServer::Session::teleport(const Clock::time_point now) {
+        using namespace protocol;
+
+        const auto id = nextTeleportId++;
+
+        if (teleports.size() >= MAX_PENDING) teleports.erase(teleports.begin());
+
+        teleports.push_back({id, now});
+
+        std::uniform_real_distribution coordinate(-1000.0, 1000.0);
+
+        queue(server_bound::play_step::SynchronizePlayerPositionPacketType{Double(coordinate(rng)), Double(64.0), Double(coordinate(rng)), Float(0.0f), Float(0.0f), Byte(0), VarInt(id)});
+
+        nextTeleport = now + server.settings.teleportInterval;
+    }
+
+    inline void MockServer::Session::traffic() {
+        using namespace protocol;
+        namespace play = server_bound::play_step;
+
+        std::uniform_real_distribution coordinate(-1000.0, 1000.0);
+        std::uniform_real_distribution height(-64.0, 320.0);
+        std::uniform_real_distribution angle(0.0f, 360.0f);
+        std::uniform_int_distribution velocity(-800, 800);
+
+        const auto v = [&] { return Short(static_cast<std::int16_t>(velocity(rng))); };
+
+        // 大致按真实服务器的比例：速度更新为主，其次是实体生成与经验球
+        if (const auto roll = rng() % 20; roll < 12)
+            queue(play::SetEntityVelocityPacketType{VarInt(static_cast<int>(rng() % 512) + 1), v(), v(), v()});
+
+        else if (roll < 17) {
+            std::array<std::byte, 16> uuid;
+
+            std::ranges::generate(uuid, [this] { return static_cast<std::byte>(rng()); });
+
+            queue(play::SpawnEntity2PacketType{VarInt(nextEntityId++), UUID(uuid), VarInt(static_cast<int>(rng() % 150)), Double(coordinate(rng)), Double(height(rng)), Double(coordinate(rng)),
+                                               Angle(angle(rng)), Angle(angle(rng)), Angle(angle(rng)), VarInt(0), v(), v(), v()});
+        }
+
+        else
+            queue(play::SpawnExperienceOrbPacketType{VarInt(nextEntityId++), Double(coordinate(rng)), Double(height(rng)), Double(coordinate(rng)),
+                                                     Short(static_cast<std::int16_t>(rng() % 2477 + 1))});
+
+        server.counters.trafficPackets.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template<protocol::is_package T>
+    void MockServer::Session::queue(const T& packet) {
+        const auto bytes = packet.serialize(compress, server.settings.compressionThreshold);
+
+        outgoing.insert(outgoing.end(), bytes.begin(), bytes.end());
+
+        server.counters.packetsSent.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline bool MockServer::Session::flush() {
+        std::size_t offset = 0;
+
+        while (offset < outgoing.size()) {
+            const int sent = send(sock, reinterpret_cast<const char*>(outgoing.data() + offset), static_cast<int>(outgoing.size() - offset), detail::SEND_FLAGS);
+
+            if (sent == SOCKET_ERROR) return false;
+
+            offset += static_cast<std::size_t>(sent);
+        }
+
+        server.counters.bytesSent.fetch_add(offset, std::memory_order_relaxed);
+
+        outgoing.clear();
+
+        return true;
+    }
+
+    inline void MockServer::Session::answered(std::vector<Pending>& pending, const std::int64_t id, client::RollingWindow& window) {
+        const auto it = std::ranges::find(pending, id, &Pending::id);
+
+        if (it == pending.end()) return;
+
+        window.add(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - it->sent));
+
+        pending.erase(it);
+    }
+
+}  // namespace minecraft::server
+
+#endif  // MOCKSERVER_HPP
@@ -0,0 +1,104 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file inlineFunction.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 13:20
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef INLINEFUNCTION_H
+#define INLINEFUNCTION_H
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace minecraft {
+
+    template<typename Sig, std::size_t Capacity = 64>
+    class InlineFunction;
+
+    /** @class InlineFunction
+     *
+     * @if zh
+     * @brief 带内联缓冲区的仅移动可调用对象包装
+     * @details
+     * - 不超过 @a Capacity 、对齐不超过 @c max_align_t 且可无异常移动的可调用对象存放在内部缓冲区中，构造与调用都不会分配堆内存
+     * - 其余可调用对象在构造时分配一次堆内存，缓冲区只存指针，移动时不再分配
+     * - 调用只有一次间接函数调用，无RTTI
+     *
+     * @else
+     * @brief Move-only callable wrapper with an inline buffer
+     * @details
+     * - Callables of at most @a Capacity bytes, aligned no stricter than @c max_align_t and nothrow movable live in the internal buffer,
+     *   neither construction nor invocation allocates
+     * - Any other callable is allocated once on construction and the buffer only holds the pointer, moves do not allocate
+     * - A call costs one indirect function call, no RTTI
+     *
+     * @endif
+     * */
+    template<typename R, typename... Args, std::size_t Capacity>
+    class InlineFunction<R(Args...), Capacity> {
+    public:
+        InlineFunction() = default;
+
+        template<typename F>
+            requires(!std::is_same_v<std::remove_cvref_t<F>, InlineFunction> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+        InlineFunction(F&& f);
+
+        InlineFunction(InlineFunction&& other) noexcept;
+
+        InlineFunction& operator=(InlineFunction&& other) noexcept;
+
+        InlineFunction(const InlineFunction&) = delete;
+
+        InlineFunction& operator=(const InlineFunction&) = delete;
+
+        ~InlineFunction();
+
+        R operator()(Args... args) const;
+
+        explicit operator bool() const;
+
+        /**
+         * @if zh
+         * @brief 可调用对象类型 @p F 是否存放在内部缓冲区中（否则在堆上）
+         *
+         * @else
+         * @brief Whether a callable of type @p F is stored in the internal buffer (otherwise on the heap)
+         *
+         * @endif
+         * */
+        template<typename F>
+        static constexpr bool storedInline =
+            sizeof(std::decay_t<F>) <= Capacity && alignof(std::decay_t<F>) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<std::decay_t<F>>;
+
+    private:
+        static_assert(Capacity >= sizeof(void*), "InlineFunction capacity must hold at least a pointer for the heap fallback");
+
+        using Invoker = R (*)(void*, Args&&...);
+
+        // dst 为空时仅析构 src，否则将 src 移动构造到 dst 后析构 src
+        using Manager = void (*)(void* dst, void* src);
+
+        alignas(std::max_align_t) mutable std::byte storage_[Capacity];
+
+        Invoker invoke_ = nullptr;
+
+        Manager manage_ = nullptr;
+
+        void reset();
+    };
+
+}  // namespace minecraft
+
+#include "inlineFunction.hpp"
+
+#endif  // INLINEFUNCTION_H
@@ -0,0 +1,111 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file inlineFunction.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 13:20
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef INLINEFUNCTION_HPP
+#define INLINEFUNCTION_HPP
+#pragma once
+
+#include <functional>
+#include <new>
+#include <utility>
+
+namespace minecraft {
+
+    template<typename R, typename... Args, std::size_t Capacity>
+    template<typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, InlineFunction<R(Args...), Capacity>> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    InlineFunction<R(Args...), Capacity>::InlineFunction(F&& f) {
+        using T = std::decay_t<F>;
+
+        if constexpr (storedInline<T>) {
+            ::new (static_cast<void*>(storage_)) T(std::forward<F>(f));
+
+            invoke_ = [](void* self, Args&&... args) -> R { return std::invoke(*static_cast<T*>(self), std::forward<Args>(args)...); };
+
+            manage_ = [](void* dst, void* src) {
+                if (dst) ::new (dst) T(std::move(*static_cast<T*>(src)));
+
+                static_cast<T*>(src)->~T();
+            };
+        }
+
+        // 放不下时退回堆上存放，缓冲区中只存指针，移动只转移指针
+        else {
+            ::new (static_cast<void*>(storage_)) T*(new T(std::forward<F>(f)));
+
+            invoke_ = [](void* self, Args&&... args) -> R { return std::invoke(**static_cast<T**>(self), std::forward<Args>(args)...); };
+
+            manage_ = [](void* dst, void* src) {
+                if (dst) ::new (dst) T*(*static_cast<T**>(src));
+
+                else
+                    delete *static_cast<T**>(src);
+            };
+        }
+    }
+
+    template<typename R, typename... Args, std::size_t Capacity>
+    InlineFunction<R(Args...), Capacity>::InlineFunction(InlineFunction&& other) noexcept
+        : invoke_(other.invoke_)
+        , manage_(other.manage_) {
+        if (manage_) manage_(storage_, other.storage_);
+
+        other.invoke_ = nullptr;
+        other.manage_ = nullptr;
+    }
+
+    template<typename R, typename... Args, std::size_t Capacity>
+    InlineFunction<R(Args...), Capacity>& InlineFunction<R(Args...), Capacity>::operator=(InlineFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+
+            invoke_ = other.invoke_;
+            manage_ = other.manage_;
+
+            if (manage_) manage_(storage_, other.storage_);
+
+            other.invoke_ = nullptr;
+            other.manage_ = nullptr;
+        }
+
+        return *this;
+    }
+
+    template<typename R, typename... Args, std::size_t Capacity>
+    InlineFunction<R(Args...), Capacity>::~InlineFunction() {
+        reset();
+    }
+
+    template<typename R, typename... Args, std::size_t Capacity>
+    R InlineFunction<R(Args...), Capacity>::operator()(Args... args) const {
+        return invoke_(storage_, std::forward<Args>(args)...);
+    }
+
+    template<typename R, typename... Args, std::size_t Capacity>
+    InlineFunction<R(Args...), Capacity>::operator bool() const {
+        return invoke_ != nullptr;
+    }
+
+    template<typename R, typename... Args, std::size_t Capacity>
+    void InlineFunction<R(Args...), Capacity>::reset() {
+        if (manage_) manage_(nullptr, storage_);
+
+        invoke_ = nullptr;
+        manage_ = nullptr;
+    }
+
+}  // namespace minecraft
+
+#endif  // INLINEFUNCTION_HPP
@@ -0,0 +1,212 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file tracer.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 22:50
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TRACER_H
+#define TRACER_H
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <vector>
+
+/**
+ * @if zh
+ * @brief 编译期追踪开关
+ * @details 未显式定义时随 @c DEBUG 开启；为0时 @c TraceSpan 与 @c traceEvent 编译为空
+ *
+ * @else
+ * @brief Compile-time tracing switch
+ * @details Follows @c DEBUG unless defined explicitly; when 0, @c TraceSpan and @c traceEvent compile to nothing
+ *
+ * @endif
+ * */
+#ifndef MINECRAFT_TRACE
+    #ifdef DEBUG
+        #define MINECRAFT_TRACE 1
+    #else
+        #define MINECRAFT_TRACE 0
+    #endif
+#endif
+
+namespace minecraft {
+
+    inline constexpr bool TRACE_ENABLED = MINECRAFT_TRACE != 0;
+
+    enum class TraceKind : std::uint8_t { SPAN, EVENT };
+
+    /** @struct TraceEvent
+     *
+     * @if zh
+     * @brief 一条追踪记录，时间为稳定时钟纳秒，瞬时事件的 @c duration 为0
+     *
+     * @else
+     * @brief One trace record, times are steady-clock nanoseconds, instant events have a @c duration of 0
+     *
+     * @endif
+     * */
+    struct TraceEvent {
+        const char* name;
+
+        TraceKind kind;
+
+        std::uint32_t thread;
+
+        std::uint64_t start;
+
+        std::uint64_t duration;
+
+        std::int64_t arg;
+    };
+
+    namespace detail {
+        std::uint64_t traceNow();
+
+        /** @class TraceRing
+         *
+         * @if zh
+         * @brief 单线程写入的追踪环，满后覆盖最旧的记录
+         * @details 字段以relaxed原子存储，读取方在读完后复查写入位置，丢弃读取期间被覆盖的槽位
+         *
+         * @else
+         * @brief Single-writer trace ring, the oldest records are overwritten once full
+         * @details Fields are stored as relaxed atomics, the reader re-checks the write position afterwards and drops slots overwritten meanwhile
+         *
+         * @endif
+         * */
+        class TraceRing {
+        public:
+            static constexpr std::size_t CAPACITY = 1024;
+
+            explicit TraceRing(std::uint32_t thread);
+
+            void push(const char* name, TraceKind kind, std::uint64_t start, std::uint64_t duration, std::int64_t arg);
+
+            void collect(std::vector<TraceEvent>& out) const;
+
+            const std::uint32_t thread;
+
+        private:
+            struct Slot {
+                std::atomic<const char*> name = nullptr;
+
+                std::atomic<TraceKind> kind = TraceKind::EVENT;
+
+                std::atomic<std::uint64_t> start = 0;
+
+                std::atomic<std::uint64_t> duration = 0;
+
+                std::atomic<std::int64_t> arg = 0;
+            };
+
+            std::array<Slot, CAPACITY> slots;
+
+            std::atomic<std::uint64_t> head = 0;
+        };
+    }  // namespace detail
+
+    /** @class Tracer
+     *
+     * @if zh
+     * @brief 收集所有线程的追踪环
+     * @details 每个线程首次记录时创建自己的环，线程退出后环仍保留，作为飞行记录器在出错后导出
+     *
+     * @else
+     * @brief Collects the trace rings of every thread
+     * @details Each thread creates its ring on its first record, rings outlive their threads so they can be exported as a flight recorder after a failure
+     *
+     * @endif
+     * */
+    class Tracer {
+    public:
+        static Tracer& instance();
+
+        detail::TraceRing& ring();
+
+        [[nodiscard]] std::vector<TraceEvent> collect() const;
+
+        void writeChromeTrace(std::ostream& out) const;
+
+        bool writeChromeTrace(const std::string& path) const;
+
+    private:
+        Tracer() = default;
+
+        mutable std::mutex mutex;
+
+        std::vector<std::shared_ptr<detail::TraceRing>> rings;
+    };
+
+    /** @class TraceSpan
+     *
+     * @if zh
+     * @brief 作用域追踪区间，构造时计时，析构时写入当前线程的追踪环
+     * @details 不包装被调用的函数，不捕获异常；关闭追踪时为空类型
+     * @param name 必须是静态存储期的字符串
+     *
+     * @else
+     * @brief Scoped trace span, timed from construction and written to the calling thread's ring on destruction
+     * @details Wraps nothing and catches nothing; an empty type when tracing is disabled
+     * @param name Must be a string with static storage duration
+     *
+     * @endif
+     * */
+    class TraceSpan {
+    public:
+        explicit TraceSpan(const char* name, std::int64_t arg = 0);
+
+        TraceSpan(const TraceSpan&) = delete;
+
+        TraceSpan& operator=(const TraceSpan&) = delete;
+
+        ~TraceSpan();
+
+#if MINECRAFT_TRACE
+    private:
+        const char* name;
+
+        std::int64_t arg;
+
+        std::uint64_t start;
+#endif
+    };
+
+    void traceEvent(const char* name, std::int64_t arg = 0);
+
+    /**
+     * @if zh
+     * @brief 报告被吞掉的异常
+     * @details 与 @c Debugger 相同的回溯格式输出到标准错误，并记录一条 "error" 事件；只在异常路径上调用，源码位置在调用处取得
+     *
+     * @else
+     * @brief Report a swallowed exception
+     * @details Prints the same traceback format as @c Debugger to stderr and records an "error" event; only called on the
+     * exception path, the source location is taken at the call site
+     *
+     * @endif
+     * */
+    void traceError(const std::exception& e, const std::source_location& loc = std::source_location::current());
+
+}  // namespace minecraft
+
+#include "tracer.hpp"
+
+#endif  // TRACER_H
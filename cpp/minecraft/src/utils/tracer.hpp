@@ -0,0 +1,161 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file tracer.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 22:50
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef TRACER_HPP
+#define TRACER_HPP
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <iostream>
+
+namespace minecraft {
+
+    namespace detail {
+        inline std::uint64_t traceNow() {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        inline TraceRing::TraceRing(const std::uint32_t thread)
+            : thread(thread) {}
+
+        inline void TraceRing::push(const char* name, const TraceKind kind, const std::uint64_t start, const std::uint64_t duration, const std::int64_t arg) {
+            const auto index = head.load(std::memory_order_relaxed);
+            auto& slot       = slots[index % CAPACITY];
+
+            slot.name.store(name, std::memory_order_relaxed);
+            slot.kind.store(kind, std::memory_order_relaxed);
+            slot.start.store(start, std::memory_order_relaxed);
+            slot.duration.store(duration, std::memory_order_relaxed);
+            slot.arg.store(arg, std::memory_order_relaxed);
+
+            head.store(index + 1, std::memory_order_release);
+        }
+
+        inline void TraceRing::collect(std::vector<TraceEvent>& out) const {
+            const auto end   = head.load(std::memory_order_acquire);
+            const auto begin = end > CAPACITY ? end - CAPACITY : 0;
+            const auto first = out.size();
+
+            for (auto i = begin; i < end; ++i) {
+                const auto& slot = slots[i % CAPACITY];
+
+                out.push_back({slot.name.load(std::memory_order_relaxed), slot.kind.load(std::memory_order_relaxed), thread, slot.start.load(std::memory_order_relaxed),
+                               slot.duration.load(std::memory_order_relaxed), slot.arg.load(std::memory_order_relaxed)});
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // 读取期间写入方可能已覆盖最旧的槽位，正在写入的下一个槽位同样不可信
+            const auto next  = head.load(std::memory_order_relaxed) + 1;
+            const auto stale = next > CAPACITY + begin ? std::min(next - CAPACITY - begin, end - begin) : 0;
+
+            out.erase(out.begin() + static_cast<std::ptrdiff_t>(first), out.begin() + static_cast<std::ptrdiff_t>(first + stale));
+        }
+    }  // namespace detail
+
+    inline Tracer& Tracer::instance() {
+        static Tracer tracer;
+
+        return tracer;
+    }
+
+    inline detail::TraceRing& Tracer::ring() {
+        thread_local std::shared_ptr<detail::TraceRing> local = [this] {
+            std::lock_guard lock(mutex);
+
+            return rings.emplace_back(std::make_shared<detail::TraceRing>(static_cast<std::uint32_t>(rings.size())));
+        }();
+
+        return *local;
+    }
+
+    inline std::vector<TraceEvent> Tracer::collect() const {
+        std::vector<TraceEvent> events;
+
+        {
+            std::lock_guard lock(mutex);
+
+            for (const auto& ring : rings) ring->collect(events);
+        }
+
+        std::ranges::sort(events, {}, &TraceEvent::start);
+
+        return events;
+    }
+
+    inline void Tracer::writeChromeTrace(std::ostream& out) const {
+        const auto events = collect();
+
+        out << "[";
+
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            const auto& e = events[i];
+
+            // 名称均为代码中的字面量，无需转义
+            if (e.kind == TraceKind::SPAN)
+                out << std::format(R"({}{{"name":"{}","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{},"args":{{"arg":{}}}}})", i ? ",\n" : "\n", e.name,
+                                   static_cast<double>(e.start) / 1e3, static_cast<double>(e.duration) / 1e3, e.thread, e.arg);
+            else
+                out << std::format(R"({}{{"name":"{}","ph":"i","s":"t","ts":{:.3f},"pid":1,"tid":{},"args":{{"arg":{}}}}})", i ? ",\n" : "\n", e.name,
+                                   static_cast<double>(e.start) / 1e3, e.thread, e.arg);
+        }
+
+        out << "\n]\n";
+    }
+
+    inline bool Tracer::writeChromeTrace(const std::string& path) const {
+        std::ofstream out(path, std::ios::trunc);
+
+        if (!out) return false;
+
+        writeChromeTrace(out);
+
+        return static_cast<bool>(out.flush());
+    }
+
+#if MINECRAFT_TRACE
+    inline TraceSpan::TraceSpan(const char* name, const std::int64_t arg)
+        : name(name)
+        , arg(arg)
+        , start(detail::traceNow()) {}
+
+    inline TraceSpan::~TraceSpan() { Tracer::instance().ring().push(name, TraceKind::SPAN, start, detail::traceNow() - start, arg); }
+
+    inline void traceEvent(const char* name, const std::int64_t arg) { Tracer::instance().ring().push(name, TraceKind::EVENT, detail::traceNow(), 0, arg); }
+#else
+    inline TraceSpan::TraceSpan(const char*, std::int64_t) {}
+
+    inline TraceSpan::~TraceSpan() = default;
+
+    inline void traceEvent(const char*, std::int64_t) {}
+#endif
+
+    inline void traceError(const std::exception& e, const std::source_location& loc) {
+        static std::atomic_bool first = true;
+
+        if (first.exchange(false)) std::cerr << "Traceback (most recent call last):" << std::endl;
+
+        std::cerr << "    File " << loc.file_name() << ", line " << loc.line() << ", in <" << loc.function_name() << ">"
+                  << "\n\t" << e.what() << std::endl;
+
+        traceEvent("error", static_cast<std::int64_t>(loc.line()));
+    }
+
+}  // namespace minecraft
+
+#endif  // TRACER_HPP
@@ -21,6 +21,8 @@
 #include <array>
 #include <string>
 #include <type_traits>
+#include <vector>
+#include <zlib.h>
 
 namespace minecraft {
     template<typename T>
@@ -32,9 +34,45 @@ namespace minecraft {
                                        : N % 2 == 0 ? binpow_impl<T, V, N / 2> * binpow_impl<T, V, N / 2>
                                                     : binpow_impl<T, V, N / 2> * binpow_impl<T, V, N / 2> * V;
 
+        // enumMax每轮探测的枚举值个数
+        inline constexpr std::size_t ENUM_PROBE = 8;
+
         template<typename T, std::size_t N = 0>
         constexpr auto enumMax();
 
+        /**
+         * @if zh
+         * @brief 字节到两位小写十六进制字符的查找表
+         *
+         * @else
+         * @brief Lookup table from a byte to its two lowercase hex digits
+         *
+         * @endif
+         * */
+        inline constexpr auto HEX_PAIRS = [] {
+            constexpr char digits[] = "0123456789abcdef";
+
+            std::array<std::array<char, 2>, 256> table{};
+
+            for (std::size_t i = 0; i < table.size(); ++i) table[i] = {digits[i >> 4], digits[i & 0x0F]};
+
+            return table;
+        }();
+
+        /**
+         * @if zh
+         * @brief 将单个值写入输出迭代器
+         * @details 依次尝试 @c formatTo 、 @c toString ，浮点数按 @c std::to_string 的格式输出， @c std::byte 按字符输出
+         *
+         * @else
+         * @brief Write a single value to an output iterator
+         * @details Tries @c formatTo, then @c toString; floating point values follow @c std::to_string, @c std::byte is written as a character
+         *
+         * @endif
+         * */
+        template<typename OutputIt, typename T>
+        OutputIt formatValueTo(OutputIt out, const T& value);
+
     }  // namespace detail
 
     template<numeric auto V, int N = 1>
@@ -43,6 +81,32 @@ namespace minecraft {
     template<typename T>
     constexpr T binpow(T base, int exp);
 
+    /**
+     * @if zh
+     * @brief 将字节序列以 "\\0xab \\0xcd" 的形式写入输出迭代器
+     * @param separated 为真时在第一个字节前也写入分隔符，用于拼接多段字节
+     *
+     * @else
+     * @brief Write a byte sequence as "\\0xab \\0xcd" to an output iterator
+     * @param separated When true a separator is written before the first byte as well, for joining several runs
+     *
+     * @endif
+     * */
+    template<typename OutputIt, typename T>
+    OutputIt hexTo(OutputIt out, const T& value, bool separated = false);
+
+    /**
+     * @if zh
+     * @brief 写入字节序列，可打印字符原样输出，其余字符以十六进制转义
+     *
+     * @else
+     * @brief Write a byte sequence, printable characters as-is and the rest as hex escapes
+     *
+     * @endif
+     * */
+    template<typename OutputIt, typename T>
+    OutputIt escapeTo(OutputIt out, const T& value);
+
     template<typename T>
     std::string toHexString(const T& value);
 
@@ -67,10 +131,90 @@ namespace minecraft {
         requires std::is_enum_v<T>
     constexpr auto enumToStr(T value);
 
+    /** @class Inflater
+     *
+     * @if zh
+     * @brief 可复用的raw deflate解压流
+     * @details
+     * - zlib流只初始化一次，之后每帧用 @c inflateReset 复位，不再为每帧分配与释放32KiB窗口
+     * - @c prefix 只解压开头一段并让流挂起；紧接着对同一输入再次调用 @c prefix 或 @c inflate 时复用已解压的前缀，从挂起处继续，不重复解压
+     * - 是否为同一输入按已读取的压缩字节逐字节比较判定，缓冲区被复用时不会误用旧状态
+     * - 每个线程一个实例（@c local），客户端的接收线程即每个连接一个
+     *
+     * @else
+     * @brief Reusable raw deflate stream
+     * @details
+     * - The zlib stream is initialised once and reset per frame with @c inflateReset, no 32 KiB window is allocated and freed per frame
+     * - @c prefix inflates only the beginning and leaves the stream suspended; a following @c prefix or @c inflate of the same input
+     *   reuses the inflated prefix and resumes where it stopped instead of inflating again
+     * - Whether it is the same input is decided by comparing the compressed bytes read so far, so a reused buffer never picks up stale state
+     * - One instance per thread (@c local), which for the client means one per connection's receive thread
+     *
+     * @endif
+     * */
+    class Inflater {
+    public:
+        static constexpr std::size_t PREFIX = 256;
+
+        Inflater();
+
+        Inflater(const Inflater&) = delete;
+
+        Inflater& operator=(const Inflater&) = delete;
+
+        ~Inflater();
+
+        /**
+         * @if zh
+         * @brief 解压开头至多 @p outSize 字节（不超过 @c PREFIX）
+         * @return 实际解压出的字节数
+         *
+         * @else
+         * @brief Inflate at most the first @p outSize bytes (no more than @c PREFIX)
+         * @return Number of bytes actually inflated
+         *
+         * @endif
+         * */
+        std::size_t prefix(const std::byte* data, std::size_t size, std::byte* out, std::size_t outSize);
+
+        /**
+         * @if zh
+         * @brief 完整解压，输出必须恰好为 @p outSize 字节，否则抛出异常
+         *
+         * @else
+         * @brief Inflate completely, the output must be exactly @p outSize bytes or an exception is thrown
+         *
+         * @endif
+         * */
+        void inflate(const std::byte* data, std::size_t size, std::byte* out, std::size_t outSize);
+
+        static Inflater& local();
+
+    private:
+        z_stream stream{};
+
+        std::array<std::byte, PREFIX> head{};
+
+        std::size_t headSize = 0;
+
+        // 挂起的前缀解压已读取的压缩字节，用于判定后续完整解压是否为同一输入
+        std::vector<std::byte> consumed;
+
+        bool suspended = false;
+
+        [[nodiscard]] bool resumable(const std::byte* data, std::size_t size) const;
+
+        void rewind(const std::byte* data, std::size_t size);
+    };
+
     std::vector<std::byte> decompressData(const std::vector<std::byte>& data, std::size_t size);
 
+    std::vector<std::byte> decompressData(const std::byte* data, std::size_t size, std::size_t outSize);
+
     std::vector<std::byte> compressData(const std::vector<std::byte>& data);
 
+    std::size_t inflatePrefix(const std::byte* data, std::size_t size, std::byte* out, std::size_t outSize);
+
     template<typename T>
     struct ArgsTraits;
 
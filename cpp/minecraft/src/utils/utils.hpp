@@ -17,7 +17,12 @@
 #define UTILS_HPP
 #pragma once
 
+#include <algorithm>
+#include <cctype>
+#include <format>
 #include <iomanip>
+#include <iterator>
+#include <span>
 #include <sstream>
 #include <zlib.h>
 #include <iostream>
@@ -27,11 +32,38 @@ namespace minecraft {
     namespace detail {
         template<typename T, std::size_t N>
         constexpr auto enumMax() {
-            if constexpr (constexpr auto Value = static_cast<T>(N); enumToStr<Value>().find(")") == std::string_view::npos)
-                return enumMax<T, N + 1>();
+            // 一次探测一组取值，递归深度降为逐个探测的1/ENUM_PROBE
+            constexpr auto named = []<std::size_t... I>(std::index_sequence<I...>) {
+                return std::array<bool, ENUM_PROBE>{(enumToStr<static_cast<T>(N + I)>().find(")") == std::string_view::npos)...};
+            }(std::make_index_sequence<ENUM_PROBE>{});
+
+            constexpr auto first = static_cast<std::size_t>(std::ranges::find(named, false) - named.begin());
+
+            if constexpr (first == ENUM_PROBE)
+                return enumMax<T, N + ENUM_PROBE>();
+
+            else
+                return N + first;
+        }
+
+        template<typename OutputIt, typename T>
+        OutputIt formatValueTo(OutputIt out, const T& value) {
+            if constexpr (requires { value.formatTo(out); })
+                return value.formatTo(out);
+
+            else if constexpr (requires { value.toString(); })
+                return std::ranges::copy(value.toString(), out).out;
+
+            else if constexpr (std::is_same_v<T, std::byte>) {
+                *out++ = static_cast<char>(value);
+                return out;
+            }
+
+            else if constexpr (std::is_floating_point_v<T>)
+                return std::format_to(out, "{:f}", value);
 
             else
-                return N;
+                return std::format_to(out, "{}", value);
         }
     }  // namespace detail
 
@@ -49,16 +81,48 @@ namespace minecraft {
         return result;
     }
 
+    template<typename OutputIt, typename T>
+    OutputIt hexTo(OutputIt out, const T& value, bool separated) {
+        for (const auto byte : value) {
+            const auto& pair = detail::HEX_PAIRS[static_cast<unsigned char>(byte)];
+
+            if (separated) *out++ = ' ';
+
+            *out++ = '\\';
+            *out++ = '0';
+            *out++ = 'x';
+            *out++ = pair[0];
+            *out++ = pair[1];
+
+            separated = true;
+        }
+
+        return out;
+    }
+
+    template<typename OutputIt, typename T>
+    OutputIt escapeTo(OutputIt out, const T& value) {
+        for (std::size_t i = 0; const auto byte : value) {
+            if (const auto c = static_cast<unsigned char>(byte); std::isprint(c))
+                *out++ = static_cast<char>(c);
+            else
+                out = hexTo(out, std::span(&c, 1), i != 0);
+
+            ++i;
+        }
+
+        return out;
+    }
+
     template<typename T>
     std::string toHexString(const T& value) {
-        std::ostringstream oss;
+        std::string result;
 
-        oss << std::hex << std::setfill('0');
+        result.reserve(std::size(value) * 6);
 
-        for (std::size_t i = 0; const auto byte : value)
-            oss << (i++ == 0 ? "" : " ") << "\\0x" << std::setw(2) << static_cast<int>(byte);
+        hexTo(std::back_inserter(result), value);
 
-        return oss.str();
+        return result;
     }
 
     template<std::size_t N>
@@ -118,41 +182,118 @@ namespace minecraft {
         return start == std::string_view::npos ? name : std::string_view{name.data() + start + 2, name.size() - start - 2};
     }
 
+    namespace detail {
+        // 变量模板只求值一次，各处enumToStr(value)共用同一张名称表
+        template<typename T>
+        inline constexpr auto enumNames = []<std::size_t... I>(std::index_sequence<I...>) {
+            return std::array<std::string_view, sizeof...(I)>{enumToStr<static_cast<T>(I)>()...};
+        }(std::make_index_sequence<enumMax<T>()>{});
+    }  // namespace detail
+
     template<typename T>
         requires std::is_enum_v<T>
     constexpr auto enumToStr(T value) {
-        constexpr auto num = detail::enumMax<T>();
+        return detail::enumNames<T>[static_cast<std::size_t>(value)];
+    }
+
+    inline Inflater::Inflater() {
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) throw std::runtime_error("inflateInit failed");
+    }
 
-        constexpr auto names = []<std::size_t... I>(std::index_sequence<I...>) { return std::array<std::string_view, num>{enumToStr<static_cast<T>(I)>()...}; }(std::make_index_sequence<num>{});
+    inline Inflater::~Inflater() { inflateEnd(&stream); }
 
-        return names[static_cast<std::size_t>(value)];
+    inline Inflater& Inflater::local() {
+        thread_local Inflater inflater;
+
+        return inflater;
     }
 
-    inline std::vector<std::byte> decompressData(const std::vector<std::byte>& data, std::size_t size) {
-        std::vector<std::byte> result{size};
+    inline bool Inflater::resumable(const std::byte* data, const std::size_t size) const {
+        return suspended && consumed.size() <= size && std::equal(consumed.begin(), consumed.end(), data);
+    }
 
-        z_stream stream;
-        stream.next_in   = (Bytef*)data.data();
-        stream.avail_in  = data.size();
-        stream.next_out  = reinterpret_cast<Bytef*>(result.data());
-        stream.avail_out = result.size();
+    inline void Inflater::rewind(const std::byte* data, const std::size_t size) {
+        inflateReset(&stream);
 
-        stream.zalloc = Z_NULL;
-        stream.zfree  = Z_NULL;
-        stream.opaque = Z_NULL;
+        headSize        = 0;
+        stream.next_in  = reinterpret_cast<Bytef*>(const_cast<std::byte*>(data));
+        stream.avail_in = static_cast<uInt>(size);
+    }
+
+    inline std::size_t Inflater::prefix(const std::byte* data, const std::size_t size, std::byte* out, const std::size_t outSize) {
+        const auto want = std::min(outSize, head.size());
+
+        // 同一输入：已有前缀足够时直接复制，不足时从挂起处接着解压
+        if (!resumable(data, size)) rewind(data, size);
+
+        else {
+            stream.next_in  = reinterpret_cast<Bytef*>(const_cast<std::byte*>(data + consumed.size()));
+            stream.avail_in = static_cast<uInt>(size - consumed.size());
+        }
+
+        suspended = false;
+
+        if (headSize < want) {
+            stream.next_out  = reinterpret_cast<Bytef*>(head.data() + headSize);
+            stream.avail_out = static_cast<uInt>(want - headSize);
+
+            // 输出缓冲区写满即停止，不解压剩余数据
+            const auto ret = ::inflate(&stream, Z_SYNC_FLUSH);
+
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) throw std::runtime_error(std::format("inflate failed with code {}", ret));
+
+            headSize = stream.total_out;
+        }
+
+        suspended = true;
+        consumed.assign(data, reinterpret_cast<const std::byte*>(stream.next_in));
 
-        int ret = inflateInit2(&stream, -MAX_WBITS);
-        if (ret != Z_OK) throw std::runtime_error("inflateInit failed");
+        const auto n = std::min(headSize, want);
 
-        ret = inflate(&stream, Z_FINISH);
-        inflateEnd(&stream);
+        std::copy_n(head.data(), n, out);
+
+        return n;
+    }
+
+    inline void Inflater::inflate(const std::byte* data, const std::size_t size, std::byte* out, const std::size_t outSize) {
+        const auto resume = resumable(data, size) && headSize <= outSize;
+
+        suspended = false;
+
+        // 同一输入：前缀直接复制，流从上次读取的位置继续
+        if (resume) {
+            std::copy_n(head.data(), headSize, out);
+
+            stream.next_in  = reinterpret_cast<Bytef*>(const_cast<std::byte*>(data + consumed.size()));
+            stream.avail_in = static_cast<uInt>(size - consumed.size());
+        }
+
+        else
+            rewind(data, size);
+
+        stream.next_out  = reinterpret_cast<Bytef*>(out + (resume ? headSize : 0));
+        stream.avail_out = static_cast<uInt>(outSize - (resume ? headSize : 0));
+
+        const auto ret = ::inflate(&stream, Z_FINISH);
 
         if (ret != Z_STREAM_END)
             throw std::runtime_error(std::format("inflate failed with code {}, avail_in={}, avail_out={}", ret, stream.avail_in, stream.avail_out));
+    }
+
+    inline std::vector<std::byte> decompressData(const std::vector<std::byte>& data, const std::size_t size) { return decompressData(data.data(), data.size(), size); }
+
+    inline std::vector<std::byte> decompressData(const std::byte* data, const std::size_t size, const std::size_t outSize) {
+        std::vector<std::byte> result(outSize);
+
+        Inflater::local().inflate(data, size, result.data(), result.size());
 
         return result;
     }
 
+    inline std::size_t inflatePrefix(const std::byte* data, const std::size_t size, std::byte* out, const std::size_t outSize) {
+        return Inflater::local().prefix(data, size, out, outSize);
+    }
+
     inline std::vector<std::byte> compressData(const std::vector<std::byte>& data) {
         if (data.empty()) return {};
 
@@ -0,0 +1,124 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file chunkStore.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 05:40
+ * @brief In-memory store of the loaded chunk columns, fed by Chunk Data, Update Light, Update Section Blocks and Unload Chunk
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef CHUNKSTORE_H
+#define CHUNKSTORE_H
+#pragma once
+
+#include "../protocol/package/definition.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+namespace minecraft::world {
+
+    /** @class ChunkStore
+     *
+     * @if zh
+     * @brief 已加载区块列的存储，区块段保持调色板压缩形式
+     * @details
+     * - 以区块坐标为键，存入时复制Chunk Data数据包中解码出的 @c ChunkColumn ，之后的修改不会影响交给回调的数据包
+     * - 不保留光照时不复制光照数组，光照通常占区块列内存的大部分
+     * - 非线程安全，由同一线程写入与查询
+     *
+     * @else
+     * @brief Store of the loaded chunk columns, sections stay in their paletted packed form
+     * @details
+     * - Keyed by chunk coordinates, the @c ChunkColumn decoded from the Chunk Data packet is copied on insertion,
+     *   so later changes never reach the packet handed to callbacks
+     * - Without light the light arrays are not copied, they usually make up most of a column's memory
+     * - Not thread safe, write and query from the same thread
+     *
+     * @endif
+     * */
+    class ChunkStore {
+    public:
+        using Column = protocol::ChunkColumn::Data;
+
+        explicit ChunkStore(int minY = -64, bool keepLight = true);
+
+        void apply(const protocol::server_bound::play_step::ChunkDataPacketType& packet);
+
+        void apply(const protocol::server_bound::play_step::UpdateLightPacketType& packet);
+
+        void apply(const protocol::server_bound::play_step::UnloadChunkPacketType& packet);
+
+        /**
+         * @if zh
+         * @brief 将方块变化直接写入对应区块段
+         * @return 区块段未加载时为false，变化被忽略
+         *
+         * @else
+         * @brief Write block changes straight into their section
+         * @return False when the section is not loaded, the changes are then ignored
+         *
+         * @endif
+         * */
+        bool apply(const protocol::server_bound::play_step::UpdateSectionBlocksPacketType& packet);
+
+        /**
+         * @if zh
+         * @brief 按区块坐标查找区块列
+         * @return 未加载时为空指针
+         *
+         * @else
+         * @brief Find a column by chunk coordinates
+         * @return Null when not loaded
+         *
+         * @endif
+         * */
+        [[nodiscard]] const Column* find(std::int32_t chunkX, std::int32_t chunkZ) const;
+
+        /**
+         * @if zh
+         * @brief 按世界坐标查询方块状态ID
+         * @return 区块未加载或高度超出世界时为空
+         *
+         * @else
+         * @brief Look up a block state id by world coordinates
+         * @return Empty when the chunk is not loaded or the height is outside the world
+         *
+         * @endif
+         * */
+        [[nodiscard]] std::optional<std::int32_t> blockAt(std::int32_t x, std::int32_t y, std::int32_t z) const;
+
+        [[nodiscard]] std::optional<std::int32_t> biomeAt(std::int32_t x, std::int32_t y, std::int32_t z) const;
+
+        [[nodiscard]] std::size_t size() const;
+
+        [[nodiscard]] std::size_t memoryUsage() const;
+
+        [[nodiscard]] int minY() const;
+
+        void clear();
+
+    private:
+        std::unordered_map<std::uint64_t, std::shared_ptr<Column>> columns;
+
+        int minY_;
+
+        bool keepLight;
+
+        static std::uint64_t key(std::int32_t chunkX, std::int32_t chunkZ);
+
+        [[nodiscard]] const protocol::ChunkSection* section(std::int32_t x, std::int32_t y, std::int32_t z) const;
+    };
+
+}  // namespace minecraft::world
+
+#include "chunkStore.hpp"
+
+#endif  // CHUNKSTORE_H
@@ -0,0 +1,118 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file chunkStore.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 05:40
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef CHUNKSTORE_HPP
+#define CHUNKSTORE_HPP
+#pragma once
+
+#include "chunkStore.h"
+#include <ranges>
+
+namespace minecraft::world {
+
+    inline ChunkStore::ChunkStore(const int minY, const bool keepLight)
+        : minY_(minY)
+        , keepLight(keepLight) {}
+
+    inline std::uint64_t ChunkStore::key(const std::int32_t chunkX, const std::int32_t chunkZ) {
+        return static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkX)) << 32 | static_cast<std::uint32_t>(chunkZ);
+    }
+
+    inline void ChunkStore::apply(const protocol::server_bound::play_step::ChunkDataPacketType& packet) {
+        const auto& source = *packet.field<"Column">().value();
+
+        // 存储持有自己的副本：同一数据包随后交给用户回调，分片模式下还会在工作线程上被读取，之后的光照合并与方块变化不能改到它
+        auto column = std::make_shared<Column>(Column{source.heightmaps, source.sections, source.blockEntityCount, source.blockEntities, keepLight ? source.light : protocol::LightData{}});
+
+        columns.insert_or_assign(key(packet.get<"ChunkX">().value(), packet.get<"ChunkZ">().value()), std::move(column));
+    }
+
+    inline void ChunkStore::apply(const protocol::server_bound::play_step::UpdateLightPacketType& packet) {
+        if (!keepLight) return;
+
+        // 光照更新可能先于区块到达，此时没有可合并的目标，等待随后Chunk Data中的完整光照
+        if (const auto it = columns.find(key(packet.get<"ChunkX">().value(), packet.get<"ChunkZ">().value())); it != columns.end())
+            it->second->light.merge(packet.field<"Light">());
+    }
+
+    inline void ChunkStore::apply(const protocol::server_bound::play_step::UnloadChunkPacketType& packet) {
+        columns.erase(key(packet.get<"ChunkX">().value(), packet.get<"ChunkZ">().value()));
+    }
+
+    inline bool ChunkStore::apply(const protocol::server_bound::play_step::UpdateSectionBlocksPacketType& packet) {
+        // 段坐标打包为 x(22位) | z(22位) | y(20位)，均为有符号数
+        const auto position = packet.get<"ChunkSectionPostion">().value();
+
+        const auto it = columns.find(key(static_cast<std::int32_t>(position >> 42), static_cast<std::int32_t>(position << 22 >> 42)));
+
+        if (it == columns.end()) return false;
+
+        const auto index = static_cast<std::int64_t>(position << 44 >> 44) - (minY_ >> 4);
+
+        auto& sections = it->second->sections;
+
+        if (index < 0 || static_cast<std::size_t>(index) >= sections.size()) return false;
+
+        sections[static_cast<std::size_t>(index)].set(packet.field<"Blocks">());
+
+        return true;
+    }
+
+    inline const ChunkStore::Column* ChunkStore::find(const std::int32_t chunkX, const std::int32_t chunkZ) const {
+        const auto it = columns.find(key(chunkX, chunkZ));
+
+        return it == columns.end() ? nullptr : it->second.get();
+    }
+
+    inline const protocol::ChunkSection* ChunkStore::section(const std::int32_t x, const std::int32_t y, const std::int32_t z) const {
+        const auto* column = find(x >> 4, z >> 4);
+
+        if (!column || y < minY_) return nullptr;
+
+        const auto index = static_cast<std::size_t>(y - minY_) >> 4;
+
+        return index < column->sections.size() ? &column->sections[index] : nullptr;
+    }
+
+    inline std::optional<std::int32_t> ChunkStore::blockAt(const std::int32_t x, const std::int32_t y, const std::int32_t z) const {
+        if (const auto* s = section(x, y, z)) return s->blockAt(x, y - minY_, z);
+
+        return std::nullopt;
+    }
+
+    inline std::optional<std::int32_t> ChunkStore::biomeAt(const std::int32_t x, const std::int32_t y, const std::int32_t z) const {
+        if (const auto* s = section(x, y, z)) return s->biomeAt(x, y - minY_, z);
+
+        return std::nullopt;
+    }
+
+    inline std::size_t ChunkStore::size() const { return columns.size(); }
+
+    inline std::size_t ChunkStore::memoryUsage() const {
+        // 哈希表本身：桶数组与每个节点（键值对加链表指针）
+        std::size_t result = sizeof(ChunkStore) + columns.bucket_count() * sizeof(void*) + columns.size() * (sizeof(decltype(columns)::value_type) + sizeof(void*));
+
+        for (const auto& column : columns | std::views::values) result += column->memoryUsage();
+
+        return result;
+    }
+
+    inline int ChunkStore::minY() const { return minY_; }
+
+    inline void ChunkStore::clear() { columns.clear(); }
+
+}  // namespace minecraft::world
+
+#endif  // CHUNKSTORE_HPP
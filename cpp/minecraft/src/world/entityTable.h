@@ -0,0 +1,246 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file entityTable.h
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 06:30
+ * @brief Structure-of-arrays table of the tracked entities, fed by the spawn, velocity and remove packets
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef ENTITYTABLE_H
+#define ENTITYTABLE_H
+#pragma once
+
+#include "../protocol/package/definition.h"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace minecraft::world {
+
+    namespace detail {
+        /** @class EntityIndex
+         *
+         * @if zh
+         * @brief 实体ID到表中行号的开放寻址哈希表
+         * @details
+         * - 容量为2的幂，负载不超过一半，线性探测
+         * - 删除时向后移动后继项填补空位，不留墓碑，长时间运行后查找长度不退化
+         *
+         * @else
+         * @brief Open-addressing hash map from entity id to row in the table
+         * @details
+         * - Power-of-two capacity, load kept at most half, linear probing
+         * - Erasing shifts the following entries back into the hole instead of leaving tombstones, so probe lengths do not degrade over a long session
+         *
+         * @endif
+         * */
+        class EntityIndex {
+        public:
+            static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+            [[nodiscard]] std::uint32_t find(std::int32_t id) const;
+
+            void assign(std::int32_t id, std::uint32_t row);
+
+            void erase(std::int32_t id);
+
+            void clear();
+
+            [[nodiscard]] std::size_t size() const;
+
+            [[nodiscard]] std::size_t memoryUsage() const;
+
+        private:
+            struct Entry {
+                std::int32_t id;
+
+                std::uint32_t row = NONE;
+            };
+
+            std::vector<Entry> entries;
+
+            std::size_t count = 0;
+
+            [[nodiscard]] std::size_t home(std::int32_t id) const;
+
+            [[nodiscard]] std::size_t probe(std::int32_t id) const;
+
+            void grow();
+        };
+    }  // namespace detail
+
+    /** @class EntityTable
+     *
+     * @if zh
+     * @brief 以结构数组存放的实体表
+     * @details
+     * - 每个属性一列连续存放：ID、类型、位置、速度、朝向，同一行属于同一实体
+     * - 移除时用最后一行填补，各列始终紧凑，按列扫描对缓存友好，也便于编译器向量化
+     * - 速度单位为方块每刻（数据包中的值除以8000），朝向单位为度
+     * - 旧式的Spawn Player与Spawn Experience Orb不带类型，分别记为 @c PLAYER 与 @c EXPERIENCE_ORB
+     * - 非线程安全，由同一线程写入与查询
+     *
+     * @else
+     * @brief Table of entities stored as a structure of arrays
+     * @details
+     * - Each attribute is one contiguous column: id, type, position, velocity, rotation; the same row across columns is one entity
+     * - Removal fills the hole with the last row so the columns stay dense, column scans are cache friendly and easy for the compiler to vectorize
+     * - Velocity is in blocks per tick (the packet value divided by 8000), rotation in degrees
+     * - The legacy Spawn Player and Spawn Experience Orb carry no type, they are recorded as @c PLAYER and @c EXPERIENCE_ORB
+     * - Not thread safe, write and query from the same thread
+     *
+     * @endif
+     * */
+    class EntityTable {
+    public:
+        static constexpr std::int32_t PLAYER = -1;
+
+        static constexpr std::int32_t EXPERIENCE_ORB = -2;
+
+        /** @struct Entity
+         *
+         * @if zh
+         * @brief 一个实体的各列值，仅用于单个实体的读写
+         *
+         * @else
+         * @brief Values of one entity across the columns, for single-entity reads and writes only
+         *
+         * @endif
+         * */
+        struct Entity {
+            std::int32_t id = 0;
+
+            std::int32_t type = 0;
+
+            double x = 0, y = 0, z = 0;
+
+            float vx = 0, vy = 0, vz = 0;
+
+            float yaw = 0, pitch = 0;
+        };
+
+        void apply(const protocol::server_bound::play_step::SpawnEntityPacketType& packet);
+
+        void apply(const protocol::server_bound::play_step::SpawnEntity2PacketType& packet);
+
+        void apply(const protocol::server_bound::play_step::SpawnPlayerPacketType& packet);
+
+        void apply(const protocol::server_bound::play_step::SpawnExperienceOrbPacketType& packet);
+
+        void apply(const protocol::server_bound::play_step::SetEntityVelocityPacketType& packet);
+
+        void apply(const protocol::server_bound::play_step::RemoveEntitiesPacketType& packet);
+
+        /**
+         * @if zh
+         * @brief 加入或覆盖一个实体（同一ID重复生成时覆盖原有行）
+         *
+         * @else
+         * @brief Add or overwrite an entity (spawning an id again overwrites its row)
+         *
+         * @endif
+         * */
+        void spawn(const Entity& entity);
+
+        /**
+         * @if zh
+         * @brief 移除一个实体，最后一行移入其位置
+         * @return 实体不存在时为false
+         *
+         * @else
+         * @brief Remove an entity, the last row moves into its place
+         * @return False when the entity is not tracked
+         *
+         * @endif
+         * */
+        bool remove(std::int32_t id);
+
+        [[nodiscard]] std::optional<Entity> find(std::int32_t id) const;
+
+        /**
+         * @if zh
+         * @brief 按ID取行号，用于直接访问各列
+         * @return 实体不存在时为空；行号在下一次移除前有效
+         *
+         * @else
+         * @brief Row of an id, for direct column access
+         * @return Empty when the entity is not tracked; the row stays valid until the next removal
+         *
+         * @endif
+         * */
+        [[nodiscard]] std::optional<std::size_t> row(std::int32_t id) const;
+
+        /**
+         * @if zh
+         * @brief 所有实体按各自速度前进 @p ticks 刻
+         * @details 三个独立的逐列循环，没有分支与跨行依赖，可被编译器向量化
+         *
+         * @else
+         * @brief Move every entity by its velocity for @p ticks ticks
+         * @details Three independent per-column loops with no branches and no cross-row dependency, so the compiler can vectorize them
+         *
+         * @endif
+         * */
+        void advance(double ticks = 1);
+
+        [[nodiscard]] std::span<const std::int32_t> ids() const;
+
+        [[nodiscard]] std::span<const std::int32_t> types() const;
+
+        [[nodiscard]] std::span<const double> x() const;
+
+        [[nodiscard]] std::span<const double> y() const;
+
+        [[nodiscard]] std::span<const double> z() const;
+
+        [[nodiscard]] std::span<const float> vx() const;
+
+        [[nodiscard]] std::span<const float> vy() const;
+
+        [[nodiscard]] std::span<const float> vz() const;
+
+        [[nodiscard]] std::span<const float> yaw() const;
+
+        [[nodiscard]] std::span<const float> pitch() const;
+
+        [[nodiscard]] std::size_t size() const;
+
+        [[nodiscard]] std::size_t memoryUsage() const;
+
+        void reserve(std::size_t n);
+
+        void clear();
+
+    private:
+        detail::EntityIndex index;
+
+        std::vector<std::int32_t> ids_;
+
+        std::vector<std::int32_t> types_;
+
+        std::vector<double> x_, y_, z_;
+
+        std::vector<float> vx_, vy_, vz_;
+
+        std::vector<float> yaw_, pitch_;
+
+        void write(std::size_t row, const Entity& entity);
+
+        // 数据包中的速度单位为1/8000方块每刻
+        static float velocity(std::int16_t value);
+    };
+
+}  // namespace minecraft::world
+
+#include "entityTable.hpp"
+
+#endif  // ENTITYTABLE_H
@@ -0,0 +1,280 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file entityTable.hpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 06:30
+ * @brief
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+#ifndef ENTITYTABLE_HPP
+#define ENTITYTABLE_HPP
+#pragma once
+
+#include "entityTable.h"
+#include <bit>
+
+namespace minecraft::world {
+
+    namespace detail {
+        inline std::size_t EntityIndex::home(const std::int32_t id) const {
+            // 斐波那契散列取高位，连续分配的实体ID也能均匀分布
+            const auto hash = static_cast<std::uint32_t>(id) * 0x9E3779B1u;
+
+            return static_cast<std::size_t>(hash >> (32 - std::countr_zero(entries.size())));
+        }
+
+        inline std::size_t EntityIndex::probe(const std::int32_t id) const {
+            const auto mask = entries.size() - 1;
+
+            auto i = home(id);
+
+            while (entries[i].row != NONE && entries[i].id != id) i = (i + 1) & mask;
+
+            return i;
+        }
+
+        inline void EntityIndex::grow() {
+            auto old = std::move(entries);
+
+            entries.assign(old.empty() ? 16 : old.size() * 2, Entry{});
+
+            for (const auto& entry : old)
+                if (entry.row != NONE) entries[probe(entry.id)] = entry;
+        }
+
+        inline std::uint32_t EntityIndex::find(const std::int32_t id) const {
+            if (entries.empty()) return NONE;
+
+            return entries[probe(id)].row;
+        }
+
+        inline void EntityIndex::assign(const std::int32_t id, const std::uint32_t row) {
+            if ((count + 1) * 2 > entries.size()) grow();
+
+            auto& entry = entries[probe(id)];
+
+            if (entry.row == NONE) count++;
+
+            entry = {id, row};
+        }
+
+        inline void EntityIndex::erase(const std::int32_t id) {
+            if (entries.empty()) return;
+
+            const auto mask = entries.size() - 1;
+
+            auto hole = probe(id);
+
+            if (entries[hole].row == NONE) return;
+
+            count--;
+
+            // 向后移动：后继项的理想位置不在 (hole, next] 之间时，移入空位
+            for (auto next = (hole + 1) & mask; entries[next].row != NONE; next = (next + 1) & mask) {
+                if (((next - home(entries[next].id)) & mask) < ((next - hole) & mask)) continue;
+
+                entries[hole] = entries[next];
+                hole          = next;
+            }
+
+            entries[hole].row = NONE;
+        }
+
+        inline void EntityIndex::clear() {
+            entries.clear();
+            count = 0;
+        }
+
+        inline std::size_t EntityIndex::size() const { return count; }
+
+        inline std::size_t EntityIndex::memoryUsage() const { return entries.capacity() * sizeof(Entry); }
+    }  // namespace detail
+
+    inline float EntityTable::velocity(const std::int16_t value) { return static_cast<float>(value) / 8000.0f; }
+
+    inline void EntityTable::write(const std::size_t row, const Entity& entity) {
+        ids_[row]   = entity.id;
+        types_[row] = entity.type;
+        x_[row]     = entity.x;
+        y_[row]     = entity.y;
+        z_[row]     = entity.z;
+        vx_[row]    = entity.vx;
+        vy_[row]    = entity.vy;
+        vz_[row]    = entity.vz;
+        yaw_[row]   = entity.yaw;
+        pitch_[row] = entity.pitch;
+    }
+
+    inline void EntityTable::spawn(const Entity& entity) {
+        if (const auto existing = index.find(entity.id); existing != detail::EntityIndex::NONE) {
+            write(existing, entity);
+
+            return;
+        }
+
+        const auto row = ids_.size();
+
+        for (auto* column : {&ids_, &types_}) column->emplace_back();
+        for (auto* column : {&x_, &y_, &z_}) column->emplace_back();
+        for (auto* column : {&vx_, &vy_, &vz_, &yaw_, &pitch_}) column->emplace_back();
+
+        write(row, entity);
+
+        index.assign(entity.id, static_cast<std::uint32_t>(row));
+    }
+
+    inline bool EntityTable::remove(const std::int32_t id) {
+        const auto row = index.find(id);
+
+        if (row == detail::EntityIndex::NONE) return false;
+
+        const auto last = ids_.size() - 1;
+
+        // 最后一行移入空位，再让索引指向它的新行号
+        if (row != last) {
+            const auto swap = [row, last](auto& column) { column[row] = column[last]; };
+
+            swap(ids_);
+            swap(types_);
+            swap(x_);
+            swap(y_);
+            swap(z_);
+            swap(vx_);
+            swap(vy_);
+            swap(vz_);
+            swap(yaw_);
+            swap(pitch_);
+
+            index.assign(ids_[row], row);
+        }
+
+        for (auto* column : {&ids_, &types_}) column->pop_back();
+        for (auto* column : {&x_, &y_, &z_}) column->pop_back();
+        for (auto* column : {&vx_, &vy_, &vz_, &yaw_, &pitch_}) column->pop_back();
+
+        index.erase(id);
+
+        return true;
+    }
+
+    inline void EntityTable::apply(const protocol::server_bound::play_step::SpawnEntityPacketType& packet) {
+        spawn({packet.get<"EntityID">().value(), packet.get<"Type">().value(), packet.get<"X">().value(), packet.get<"Y">().value(), packet.get<"Z">().value(),
+               velocity(packet.get<"VelocityX">().value()), velocity(packet.get<"VelocityY">().value()), velocity(packet.get<"VelocityZ">().value()),
+               packet.field<"Yaw">().toDegrees(), packet.field<"Pitch">().toDegrees()});
+    }
+
+    inline void EntityTable::apply(const protocol::server_bound::play_step::SpawnEntity2PacketType& packet) {
+        spawn({packet.get<"EntityID">().value(), packet.get<"Type">().value(), packet.get<"X">().value(), packet.get<"Y">().value(), packet.get<"Z">().value(),
+               velocity(packet.get<"VelocityX">().value()), velocity(packet.get<"VelocityY">().value()), velocity(packet.get<"VelocityZ">().value()),
+               packet.field<"Yaw">().toDegrees(), packet.field<"Pitch">().toDegrees()});
+    }
+
+    inline void EntityTable::apply(const protocol::server_bound::play_step::SpawnPlayerPacketType& packet) {
+        spawn({.id    = packet.get<"EntityID">().value(),
+               .type  = PLAYER,
+               .x     = packet.get<"X">().value(),
+               .y     = packet.get<"Y">().value(),
+               .z     = packet.get<"Z">().value(),
+               .yaw   = packet.field<"Yaw">().toDegrees(),
+               .pitch = packet.field<"Pitch">().toDegrees()});
+    }
+
+    inline void EntityTable::apply(const protocol::server_bound::play_step::SpawnExperienceOrbPacketType& packet) {
+        spawn({.id = packet.get<"EntityID">().value(), .type = EXPERIENCE_ORB, .x = packet.get<"X">().value(), .y = packet.get<"Y">().value(), .z = packet.get<"Z">().value()});
+    }
+
+    inline void EntityTable::apply(const protocol::server_bound::play_step::SetEntityVelocityPacketType& packet) {
+        const auto row = index.find(packet.get<"EntityID">().value());
+
+        if (row == detail::EntityIndex::NONE) return;
+
+        vx_[row] = velocity(packet.get<"VelocityX">().value());
+        vy_[row] = velocity(packet.get<"VelocityY">().value());
+        vz_[row] = velocity(packet.get<"VelocityZ">().value());
+    }
+
+    inline void EntityTable::apply(const protocol::server_bound::play_step::RemoveEntitiesPacketType& packet) {
+        for (const auto& id : packet.field<"EntityIDs">().value()) remove(id.value());
+    }
+
+    inline std::optional<EntityTable::Entity> EntityTable::find(const std::int32_t id) const {
+        const auto row = index.find(id);
+
+        if (row == detail::EntityIndex::NONE) return std::nullopt;
+
+        return Entity{ids_[row], types_[row], x_[row], y_[row], z_[row], vx_[row], vy_[row], vz_[row], yaw_[row], pitch_[row]};
+    }
+
+    inline std::optional<std::size_t> EntityTable::row(const std::int32_t id) const {
+        const auto row = index.find(id);
+
+        if (row == detail::EntityIndex::NONE) return std::nullopt;
+
+        return row;
+    }
+
+    inline void EntityTable::advance(const double ticks) {
+        const auto n = ids_.size();
+
+        // 位置与速度列类型不同，按严格别名规则互不重叠，无需 __restrict 即可向量化
+        const auto step = [n, ticks](double* position, const float* velocity) {
+            for (std::size_t i = 0; i < n; i++) position[i] += static_cast<double>(velocity[i]) * ticks;
+        };
+
+        step(x_.data(), vx_.data());
+        step(y_.data(), vy_.data());
+        step(z_.data(), vz_.data());
+    }
+
+    inline std::span<const std::int32_t> EntityTable::ids() const { return ids_; }
+
+    inline std::span<const std::int32_t> EntityTable::types() const { return types_; }
+
+    inline std::span<const double> EntityTable::x() const { return x_; }
+
+    inline std::span<const double> EntityTable::y() const { return y_; }
+
+    inline std::span<const double> EntityTable::z() const { return z_; }
+
+    inline std::span<const float> EntityTable::vx() const { return vx_; }
+
+    inline std::span<const float> EntityTable::vy() const { return vy_; }
+
+    inline std::span<const float> EntityTable::vz() const { return vz_; }
+
+    inline std::span<const float> EntityTable::yaw() const { return yaw_; }
+
+    inline std::span<const float> EntityTable::pitch() const { return pitch_; }
+
+    inline std::size_t EntityTable::size() const { return ids_.size(); }
+
+    inline std::size_t EntityTable::memoryUsage() const {
+        return sizeof(EntityTable) + index.memoryUsage() + (ids_.capacity() + types_.capacity()) * sizeof(std::int32_t)
+               + (x_.capacity() + y_.capacity() + z_.capacity()) * sizeof(double)
+               + (vx_.capacity() + vy_.capacity() + vz_.capacity() + yaw_.capacity() + pitch_.capacity()) * sizeof(float);
+    }
+
+    inline void EntityTable::reserve(const std::size_t n) {
+        for (auto* column : {&ids_, &types_}) column->reserve(n);
+        for (auto* column : {&x_, &y_, &z_}) column->reserve(n);
+        for (auto* column : {&vx_, &vy_, &vz_, &yaw_, &pitch_}) column->reserve(n);
+    }
+
+    inline void EntityTable::clear() {
+        index.clear();
+
+        for (auto* column : {&ids_, &types_}) column->clear();
+        for (auto* column : {&x_, &y_, &z_}) column->clear();
+        for (auto* column : {&vx_, &vy_, &vz_, &yaw_, &pitch_}) column->clear();
+    }
+
+}  // namespace minecraft::world
+
+#endif  // ENTITYTABLE_HPP
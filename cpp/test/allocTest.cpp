@@ -0,0 +1,417 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file allocTest.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 03:20
+ * @brief Counts heap and pmr allocations on hot paths and fails when any of them differs from its expected count
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+
+#include "../minecraft/src/client/client.h"
+#include "../minecraft/src/client/handlers.h"
+#include "../minecraft/src/protocol/package/definition.h"
+#include "../minecraft/src/protocol/package/package.h"
+#include "../minecraft/src/server/mockServer.h"
+#include <cstdlib>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    // 只统计当前线程，避免被服务器与客户端的其他线程干扰
+    thread_local std::size_t heapAllocations = 0;
+
+    thread_local std::size_t heapFrees = 0;
+
+    thread_local std::size_t pmrAllocations = 0;
+
+    void* allocate(const std::size_t size) {
+        ++heapAllocations;
+
+        return std::malloc(size ? size : 1);
+    }
+
+    void* allocateAligned(const std::size_t size, const std::align_val_t align) {
+        ++heapAllocations;
+
+        const auto alignment = static_cast<std::size_t>(align);
+        const auto rounded   = (size + alignment - 1) / alignment * alignment;
+
+#ifdef _WIN32
+        return _aligned_malloc(rounded ? rounded : alignment, alignment);
+#else
+        return std::aligned_alloc(alignment, rounded ? rounded : alignment);
+#endif
+    }
+
+    void release(void* ptr) noexcept {
+        if (!ptr) return;
+
+        ++heapFrees;
+
+        std::free(ptr);
+    }
+
+    void releaseAligned(void* ptr) noexcept {
+        if (!ptr) return;
+
+        ++heapFrees;
+
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    /** @class CountingResource
+     *
+     * @if zh
+     * @brief 统计经由默认pmr资源的分配，再转交上游资源
+     * @details 上游为new_delete_resource时同一次分配也会计入堆分配
+     *
+     * @else
+     * @brief Counts allocations made through the default pmr resource, then forwards them upstream
+     * @details With new_delete_resource upstream the same allocation also shows up as a heap allocation
+     *
+     * @endif
+     * */
+    class CountingResource final : public std::pmr::memory_resource {
+    public:
+        explicit CountingResource(std::pmr::memory_resource* upstream)
+            : upstream(upstream) {}
+
+    private:
+        std::pmr::memory_resource* upstream;
+
+        void* do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+            ++pmrAllocations;
+
+            return upstream->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, const std::size_t bytes, const std::size_t alignment) override { upstream->deallocate(ptr, bytes, alignment); }
+
+        [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+    };
+}  // namespace
+
+void* operator new(const std::size_t size) {
+    if (const auto ptr = allocate(size)) return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size) {
+    if (const auto ptr = allocate(size)) return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void* operator new(const std::size_t size, const std::align_val_t align) {
+    if (const auto ptr = allocateAligned(size, align)) return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t align) {
+    if (const auto ptr = allocateAligned(size, align)) return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { release(ptr); }
+
+void operator delete[](void* ptr) noexcept { release(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { release(ptr); }
+
+void operator delete[](void* ptr, std::size_t) noexcept { release(ptr); }
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { release(ptr); }
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { release(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { releaseAligned(ptr); }
+
+void operator delete[](void* ptr, std::align_val_t) noexcept { releaseAligned(ptr); }
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { releaseAligned(ptr); }
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { releaseAligned(ptr); }
+
+namespace alloc {
+    using namespace minecraft::protocol;
+    using minecraft::client::HandlerList;
+
+    using KeepAlivePacketType       = server_bound::play_step::KeepAlivePacketType;
+    using TeleportConfirmPacketType = client_bound::play_step::TeleportConfirmPacketType;
+
+    constexpr int THRESHOLD = 256;
+
+    constexpr std::size_t ITERATIONS = 1000;
+
+    /**
+     * @if zh
+     * @brief 各路径每次执行的期望分配次数
+     * @details 数值由逐行分析当前实现得出（见各常量的注释），不是实测后抄录；实现变化导致的任何增减都应先更新这里
+     *
+     * @else
+     * @brief Expected allocations per execution of each path
+     * @details Derived by walking the current implementation line by line (see the comment on each constant), not
+     * copied from a measurement; any change in either direction must update these first
+     *
+     * @endif
+     * */
+    namespace expected {
+        // 字段在栈上的tuple中解码，Long不持有堆内存；压缩帧低于阈值时原地解析
+        constexpr std::size_t DECODE = 0;
+
+        // InlineFunction内联保存回调，单线程模式不加锁
+        constexpr std::size_t DISPATCH = 0;
+
+        // ID与字段的VarInt各2次（编码缓存、返回副本），追加字段1次，长度前缀2次，前插长度1次，返回缓存副本1次
+        constexpr std::size_t SERIALIZE = 9;
+
+        // ID、字段、数据长度、包长度的VarInt各2次，三段拼接到data 2次、到result 3次，返回缓存副本1次
+        constexpr std::size_t SERIALIZE_COMPRESSED = 14;
+    }  // namespace expected
+
+    struct Count {
+        std::size_t heap = 0;
+
+        std::size_t frees = 0;
+
+        std::size_t pmr = 0;
+    };
+
+    /**
+     * @if zh
+     * @brief 先执行一次预热（线程局部追踪缓冲、静态表等一次性初始化），再统计 @p iterations 次执行的分配
+     *
+     * @else
+     * @brief Run once to warm up (thread-local trace buffers, static tables and other one-time setup), then count the allocations of @p iterations runs
+     *
+     * @endif
+     * */
+    template<typename F>
+    Count measure(F&& f, const std::size_t iterations = ITERATIONS) {
+        f();
+
+        const Count before{heapAllocations, heapFrees, pmrAllocations};
+
+        for (std::size_t i = 0; i < iterations; i++) f();
+
+        return {heapAllocations - before.heap, heapFrees - before.frees, pmrAllocations - before.pmr};
+    }
+
+    class Checker {
+    public:
+        void expect(const std::string& name, const Count& count, const std::size_t perRun, const std::size_t iterations = ITERATIONS) {
+            const auto ok = count.heap == perRun * iterations && count.pmr == 0;
+
+            failed += !ok;
+
+            std::cout << std::format("{:<4} {:<48} {:>8.2f} allocs/op (expected {}), {:>8.2f} frees/op, {} pmr", ok ? "ok" : "FAIL", name,
+                                     static_cast<double>(count.heap) / static_cast<double>(iterations), perRun, static_cast<double>(count.frees) / static_cast<double>(iterations),
+                                     count.pmr)
+                      << std::endl;
+        }
+
+        [[nodiscard]] int failures() const { return failed; }
+
+    private:
+        int failed = 0;
+    };
+
+    void decode(Checker& checker) {
+        const auto plain      = KeepAlivePacketType{Long(1'760'000'000'000)}.serialize(false, -1);
+        const auto compressed = KeepAlivePacketType{Long(1'760'000'000'000)}.serialize(true, THRESHOLD);
+
+        std::int64_t sink = 0;
+
+        checker.expect("KeepAlive decode", measure([&] { sink += KeepAlivePacketType::deserialize(plain.data(), false).get<"KeepAliveID">().value(); }), expected::DECODE);
+
+        checker.expect("KeepAlive decode (compressed frame)", measure([&] { sink += KeepAlivePacketType::deserialize(compressed.data(), true).get<"KeepAliveID">().value(); }),
+                       expected::DECODE);
+
+        if (sink == 0) std::cout << "unreachable" << std::endl;
+    }
+
+    void dispatch(Checker& checker) {
+        const auto packet = KeepAlivePacketType{Long(42)};
+
+        HandlerList<KeepAlivePacketType> handlers;
+        std::int64_t sink = 0;
+
+        handlers.add([&sink](const KeepAlivePacketType& p) { sink += p.get<"KeepAliveID">().value(); }, -1);
+
+        checker.expect("KeepAlive handler dispatch", measure([&] { handlers.dispatch(packet); }), expected::DISPATCH);
+
+        // 回调抛出异常后列表仍须压缩：到期的一次性回调归还槽位，之后的注册与分发不再分配
+        for (const auto concurrent : {false, true}) {
+            HandlerList<KeepAlivePacketType> once;
+
+            once.setConcurrent(concurrent);
+            once.add([](const KeepAlivePacketType&) { throw std::runtime_error("handler failed"); }, 1);
+
+            try {
+                once.dispatch(packet);
+            } catch (const std::runtime_error&) {}
+
+            checker.expect(concurrent ? "Once handler after a throwing handler (concurrent)" : "Once handler after a throwing handler", measure([&] {
+                               once.add([&sink](const KeepAlivePacketType& p) { sink += p.get<"KeepAliveID">().value(); }, 1);
+                               once.dispatch(packet);
+                           }),
+                           expected::DISPATCH);
+        }
+
+        // 与Client接收路径相同：读ID、查跳转表、解码、分发
+        const auto plain      = packet.serialize(false, -1);
+        const auto compressed = KeepAlivePacketType{Long(42)}.serialize(true, THRESHOLD);
+
+        const auto cb   = [&handlers]<is_package T>(const T& p) {
+            if constexpr (std::is_same_v<T, KeepAlivePacketType>) handlers.dispatch(p);
+        };
+        const auto pred = []<is_package T>(std::type_identity<T>, int) { return std::is_same_v<T, KeepAlivePacketType>; };
+
+        checker.expect("KeepAlive parsePacket + dispatch", measure([&] { parsePacket(State::PLAY, plain, false, cb, pred); }), expected::DECODE + expected::DISPATCH);
+
+        checker.expect("KeepAlive parsePacket + dispatch (compressed frame)", measure([&] { parsePacket(State::PLAY, compressed, true, cb, pred); }),
+                       expected::DECODE + expected::DISPATCH);
+    }
+
+    void serialize(Checker& checker) {
+        int id = 0;
+
+        checker.expect("TeleportConfirm serialize", measure([&] { (void)TeleportConfirmPacketType{VarInt(++id % 100)}.serialize(false, -1); }), expected::SERIALIZE);
+
+        checker.expect("TeleportConfirm serialize (compressed frame)", measure([&] { (void)TeleportConfirmPacketType{VarInt(++id % 100)}.serialize(true, THRESHOLD); }),
+                       expected::SERIALIZE_COMPRESSED);
+    }
+
+    /**
+     * @if zh
+     * @brief 统计 @c Client::emit 的分配
+     * @details 客户端连接本地模拟服务器但不启动收发线程，数据包只进入发送队列；
+     * 队列首次入队的分配因标准库而异（libstdc++在构造时已分配首个节点，MSVC在入队时分配），
+     * 因此先对同类型的空队列入队一次作为基准，要求emit恰好等于序列化加上这一基准
+     *
+     * @else
+     * @brief Count the allocations of @c Client::emit
+     * @details The client connects to the local mock server but its threads are not started, packets only enter the send queue.
+     * The allocations of a first push differ between standard libraries (libstdc++ allocates the first node on construction, MSVC on push),
+     * so a first push into an empty queue of the same type is measured as the baseline, and emit must equal serialization plus that baseline
+     *
+     * @endif
+     * */
+    void emit(Checker& checker) {
+        using minecraft::client::Client;
+
+        minecraft::server::MockServer server;
+
+        if (!server.start()) {
+            std::cout << "skip emit: cannot start the mock server" << std::endl;
+
+            return;
+        }
+
+        constexpr std::size_t CLIENTS = 8;
+
+        Count baseline;
+
+        for (std::size_t i = 0; i < CLIENTS; i++) {
+            std::queue<Client::QueueEntry> queue;
+            std::vector<std::byte> bytes;
+            std::optional<std::function<void()>> callback;
+
+            const auto heap = heapAllocations;
+
+            queue.emplace(std::move(bytes), 0, std::move(callback), std::chrono::steady_clock::now(), Client::SendTag{});
+
+            baseline.heap += heapAllocations - heap;
+        }
+
+        const auto queuePush = baseline.heap / CLIENTS;
+
+        Count plain, withCallback;
+
+        for (std::size_t i = 0; i < CLIENTS; i++) {
+            Client client{"127.0.0.1", static_cast<short>(server.port())};
+
+            const Count before{heapAllocations, heapFrees, pmrAllocations};
+
+            client.emit(TeleportConfirmPacketType{VarInt(static_cast<int>(i))});
+
+            plain.heap += heapAllocations - before.heap;
+            plain.frees += heapFrees - before.frees;
+            plain.pmr += pmrAllocations - before.pmr;
+        }
+
+        for (std::size_t i = 0; i < CLIENTS; i++) {
+            Client client{"127.0.0.1", static_cast<short>(server.port())};
+
+            const auto id = static_cast<int>(i);
+            const Count before{heapAllocations, heapFrees, pmrAllocations};
+
+            // 与协议内置的传送确认相同，回调只捕获指针与ID，应存放在std::function的内联缓冲中
+            client.emit(TeleportConfirmPacketType{VarInt(id)}, [&client, id] { (void)client.skippedBytes(State::PLAY, id); });
+
+            withCallback.heap += heapAllocations - before.heap;
+            withCallback.frees += heapFrees - before.frees;
+            withCallback.pmr += pmrAllocations - before.pmr;
+        }
+
+        checker.expect("TeleportConfirm emit", plain, expected::SERIALIZE + queuePush, CLIENTS);
+
+        checker.expect("TeleportConfirm emit with reply callback", withCallback, expected::SERIALIZE + queuePush, CLIENTS);
+
+        server.stop();
+    }
+}  // namespace alloc
+
+int main() {
+    CountingResource counting(std::pmr::new_delete_resource());
+
+    std::pmr::set_default_resource(&counting);
+
+    alloc::Checker checker;
+
+    alloc::decode(checker);
+
+    alloc::dispatch(checker);
+
+    alloc::serialize(checker);
+
+    alloc::emit(checker);
+
+    std::pmr::set_default_resource(nullptr);
+
+#if defined(_ITERATOR_DEBUG_LEVEL) && _ITERATOR_DEBUG_LEVEL != 0
+    // 调试迭代器为每个容器额外分配代理对象，计数不可比较
+    std::cout << "Checked iterators are enabled, allocation limits are reported but not enforced" << std::endl;
+
+    return 0;
+#else
+    if (checker.failures()) std::cerr << checker.failures() << " allocation check(s) failed" << std::endl;
+
+    return checker.failures() ? 1 : 0;
+#endif
+}
@@ -0,0 +1,620 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file benchmark.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 00:40
+ * @brief Encode/decode microbenchmarks for every wire type and a few whole packets, results written as JSON
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+
+#include "../minecraft/src/protocol/package/definition.h"
+#include "../minecraft/src/protocol/package/package.h"
+#include "../minecraft/src/world/entityTable.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+    std::atomic<std::size_t> allocations = 0;
+}  // namespace
+
+// 统计全部堆分配，基准只读取区间内的差值
+void* operator new(const std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (const auto ptr = std::malloc(size ? size : 1)) return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace bench {
+    using namespace minecraft::protocol;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t POOL = 1024;
+
+    struct Options {
+        std::chrono::milliseconds minTime{200};
+
+        std::string filter;
+
+        std::string out;
+    };
+
+    struct Result {
+        std::string name;
+
+        std::string op;
+
+        std::uint64_t iterations;
+
+        double nsPerOp;
+
+        double bytesPerSec;
+
+        double allocsPerOp;
+    };
+
+    template<typename T>
+    void keep(const T& value) {
+        static const volatile void* sink;
+
+        sink = &value;
+
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+
+    class Runner {
+    public:
+        explicit Runner(Options options)
+            : options(std::move(options)) {}
+
+        /**
+         * @if zh
+         * @brief 运行一项基准
+         * @details 以1024次为一批循环直到累计时间达到下限；@p f 接收迭代序号并返回本次处理的字节数
+         *
+         * @else
+         * @brief Run one benchmark
+         * @details Loops in batches of 1024 until the accumulated time reaches the minimum; @p f receives the iteration
+         * index and returns the bytes it processed
+         *
+         * @endif
+         * */
+        template<typename F>
+        void run(const std::string& name, const std::string& op, F&& f) {
+            if (!options.filter.empty() && (name + "/" + op).find(options.filter) == std::string::npos) return;
+
+            for (std::size_t i = 0; i < POOL; i++) keep(f(i));
+
+            std::uint64_t iterations = 0;
+            std::uint64_t bytes      = 0;
+            Clock::duration elapsed{};
+
+            const auto allocsBefore = allocations.load(std::memory_order_relaxed);
+
+            while (elapsed < options.minTime) {
+                const auto start = Clock::now();
+
+                for (std::size_t i = 0; i < 1024; i++) bytes += f(iterations + i);
+
+                elapsed += Clock::now() - start;
+                iterations += 1024;
+            }
+
+            const auto allocs  = allocations.load(std::memory_order_relaxed) - allocsBefore;
+            const auto seconds = std::chrono::duration<double>(elapsed).count();
+
+            results.push_back({name, op, iterations, seconds * 1e9 / static_cast<double>(iterations), static_cast<double>(bytes) / seconds,
+                               static_cast<double>(allocs) / static_cast<double>(iterations)});
+
+            const auto& r = results.back();
+
+            std::cerr << std::format("{:<40} {:<7} {:>10.1f} ns/op {:>10.1f} MB/s {:>6.2f} allocs/op", r.name, r.op, r.nsPerOp, r.bytesPerSec / 1e6, r.allocsPerOp) << std::endl;
+        }
+
+        void writeJson(std::ostream& out) const {
+#ifdef DEBUG
+            constexpr bool debug = true;
+#else
+            constexpr bool debug = false;
+#endif
+
+            out << std::format(R"({{"debug":{},"min_time_ms":{},"benchmarks":[)", debug, options.minTime.count());
+
+            for (std::size_t i = 0; i < results.size(); i++) {
+                const auto& r = results[i];
+
+                out << std::format(R"({}{{"name":"{}","op":"{}","iterations":{},"ns_per_op":{:.3f},"bytes_per_sec":{:.1f},"allocs_per_op":{:.3f}}})", i ? ",\n" : "\n", r.name, r.op,
+                                   r.iterations, r.nsPerOp, r.bytesPerSec, r.allocsPerOp);
+            }
+
+            out << "\n]}\n";
+        }
+
+    private:
+        Options options;
+
+        std::vector<Result> results;
+    };
+
+    /**
+     * @if zh
+     * @brief 预先生成的取值池，编码基准从值构造字段，解码基准读取对应的编码结果
+     *
+     * @else
+     * @brief Pre-generated value pool, encode benchmarks build fields from the values and decode benchmarks read the matching encodings
+     *
+     * @endif
+     * */
+    template<typename V>
+    struct Pool {
+        std::vector<V> values;
+
+        std::vector<std::vector<std::byte>> encoded;
+
+        template<typename G, typename E>
+        Pool(G&& generate, E&& encode) {
+            values.reserve(POOL);
+            encoded.reserve(POOL);
+
+            for (std::size_t i = 0; i < POOL; i++) {
+                values.push_back(generate());
+
+                const auto bytes = encode(values.back());
+
+                encoded.emplace_back(bytes.begin(), bytes.end());
+            }
+        }
+
+        const V& value(const std::size_t i) const { return values[i % POOL]; }
+
+        const std::vector<std::byte>& bytes(const std::size_t i) const { return encoded[i % POOL]; }
+    };
+
+    inline std::mt19937_64 rng{0x6D635F62656E6368};
+
+    template<typename T>
+    T uniform(T min, T max) {
+        if constexpr (std::is_floating_point_v<T>)
+            return std::uniform_real_distribution<T>(min, max)(rng);
+        else
+            return std::uniform_int_distribution<T>(min, max)(rng);
+    }
+
+    // 长度与ID多为单字节，实体ID约两到三字节，少数负数占满五字节
+    inline int varIntValue() {
+        const auto p = uniform(0, 99);
+
+        if (p < 60) return uniform(0, 127);
+        if (p < 90) return uniform(128, 16383);
+        if (p < 99) return uniform(16384, (1 << 21) - 1);
+
+        return uniform(std::numeric_limits<int>::min(), -1);
+    }
+
+    // 方块更新记录：方块状态ID左移12位后拼接区段内坐标
+    inline long varLongValue() { return static_cast<long>(uniform(1, 27000)) << 12 | uniform(0, 4095); }
+
+    // 玩家名占多数，其次是聊天消息，少量JSON文本
+    inline std::string stringValue() {
+        constexpr std::string_view alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_";
+
+        const auto p      = uniform(0, 99);
+        const auto length = p < 70 ? uniform(3, 16) : p < 95 ? uniform(20, 256) : uniform(1024, 4096);
+
+        std::string result(static_cast<std::size_t>(length), ' ');
+
+        for (auto& c : result) c = alphabet[uniform<std::size_t>(0, alphabet.size() - 1)];
+
+        return result;
+    }
+
+    inline double coordinate() { return uniform(-5000.0, 5000.0); }
+
+    inline std::array<std::byte, 16> uuidValue() {
+        std::array<std::byte, 16> result{};
+
+        for (auto& b : result) b = static_cast<std::byte>(uniform(0, 255));
+
+        return result;
+    }
+
+    template<typename T, typename V, typename G>
+    void fixedField(Runner& runner, const std::string& name, G&& generate) {
+        const Pool<V> pool(generate, [](const V& v) { return T(v).encode(); });
+
+        runner.run(name, "encode", [&pool](const std::size_t i) {
+            const auto encoded = T(pool.value(i)).encode();
+
+            keep(encoded);
+
+            return encoded.size();
+        });
+
+        runner.run(name, "decode", [&pool](const std::size_t i) {
+            keep(T::decode(pool.bytes(i).data()));
+
+            return pool.bytes(i).size();
+        });
+    }
+
+    inline void fields(Runner& runner) {
+        fixedField<VarInt, int>(runner, "VarInt", varIntValue);
+        fixedField<VarLong, long>(runner, "VarLong", varLongValue);
+        fixedField<minecraft::protocol::Byte, std::int8_t>(runner, "Byte", [] { return static_cast<std::int8_t>(uniform(-128, 127)); });
+        fixedField<UByte, std::uint8_t>(runner, "UByte", [] { return static_cast<std::uint8_t>(uniform(0, 255)); });
+        fixedField<Short, std::int16_t>(runner, "Short", [] { return static_cast<std::int16_t>(uniform(-8000, 8000)); });
+        fixedField<UShort, std::uint16_t>(runner, "UShort", [] { return static_cast<std::uint16_t>(uniform(0, 65535)); });
+        fixedField<Int, std::int32_t>(runner, "Int", [] { return uniform<std::int32_t>(0, 1'000'000); });
+        fixedField<Long, std::int64_t>(runner, "Long", [] { return uniform<std::int64_t>(1'600'000'000'000, 1'900'000'000'000); });
+        fixedField<Float, float>(runner, "Float", [] { return uniform(-180.0f, 180.0f); });
+        fixedField<Double, double>(runner, "Double", coordinate);
+        fixedField<String, std::string>(runner, "String", stringValue);
+        fixedField<UUID, std::array<std::byte, 16>>(runner, "UUID", uuidValue);
+        fixedField<Angle, float>(runner, "Angle", [] { return uniform(0.0f, 360.0f); });
+
+        {
+            const Pool<std::array<std::int64_t, 3>> pool([] { return std::array<std::int64_t, 3>{uniform(-5000, 5000), uniform(-64, 320), uniform(-5000, 5000)}; },
+                                                         [](const auto& v) { return Position(v[0], v[1], v[2]).encode(); });
+
+            runner.run("Position", "encode", [&pool](const std::size_t i) {
+                const auto& v      = pool.value(i);
+                const auto encoded = Position(v[0], v[1], v[2]).encode();
+
+                keep(encoded);
+
+                return encoded.size();
+            });
+
+            runner.run("Position", "decode", [&pool](const std::size_t i) {
+                keep(Position::decode(pool.bytes(i).data()));
+
+                return pool.bytes(i).size();
+            });
+        }
+
+        {
+            // 插件消息负载，构造函数不公开，从字节解码得到字段
+            const Pool<std::vector<std::byte>> pool(
+                [] {
+                    std::vector<std::byte> result(static_cast<std::size_t>(uniform(16, 256)));
+
+                    for (auto& b : result) b = static_cast<std::byte>(uniform(0, 255));
+
+                    return result;
+                },
+                [](const auto& v) { return v; });
+
+            runner.run("Array<Byte>", "encode", [&pool](const std::size_t i) {
+                const auto& bytes  = pool.bytes(i);
+                const auto encoded = Array<>::decode(bytes.data(), bytes.size()).encode();
+
+                keep(encoded);
+
+                return encoded.size();
+            });
+
+            runner.run("Array<Byte>", "decode", [&pool](const std::size_t i) {
+                keep(Array<>::decode(pool.bytes(i).data(), pool.bytes(i).size()));
+
+                return pool.bytes(i).size();
+            });
+        }
+
+        {
+            const Pool<std::vector<VarInt>> pool(
+                [] {
+                    std::vector<VarInt> result;
+
+                    for (auto n = uniform(1, 8); n > 0; n--) result.emplace_back(varIntValue());
+
+                    return result;
+                },
+                [](const auto& v) {
+                    std::vector<std::byte> result;
+
+                    for (const auto& e : v) {
+                        const auto bytes = e.encode();
+
+                        result.insert(result.end(), bytes.begin(), bytes.end());
+                    }
+
+                    return result;
+                });
+
+            runner.run("Array<VarInt>", "decode", [&pool](const std::size_t i) {
+                keep(Array<VarInt>::decode(pool.bytes(i).data(), pool.bytes(i).size()));
+
+                return pool.bytes(i).size();
+            });
+        }
+
+        {
+            constexpr std::array dimensions{"minecraft:overworld", "minecraft:the_nether", "minecraft:the_end", "paper:resource_world"};
+
+            const Pool<std::vector<Identifier>> pool(
+                [&dimensions] {
+                    std::vector<Identifier> result;
+
+                    for (auto n = uniform(1, 4); n > 0; n--) result.emplace_back(dimensions[uniform<std::size_t>(0, dimensions.size() - 1)]);
+
+                    return result;
+                },
+                [](const auto& v) { return PrefixedArray<Identifier>(v).encode(); });
+
+            runner.run("PrefixedArray<Identifier>", "encode", [&pool](const std::size_t i) {
+                const auto encoded = PrefixedArray<Identifier>(pool.value(i)).encode();
+
+                keep(encoded);
+
+                return encoded.size();
+            });
+
+            runner.run("PrefixedArray<Identifier>", "decode", [&pool](const std::size_t i) {
+                keep(PrefixedArray<Identifier>::decode(pool.bytes(i).data()));
+
+                return pool.bytes(i).size();
+            });
+        }
+
+        {
+            // 死亡位置：约一半的登录包携带
+            const Pool<std::optional<Position>> pool(
+                []() -> std::optional<Position> {
+                    if (uniform(0, 1)) return Position(uniform(-5000, 5000), uniform(-64, 320), uniform(-5000, 5000));
+
+                    return std::nullopt;
+                },
+                [](const auto& v) { return Option<Position>(v).encode(); });
+
+            runner.run("Option<Position>", "encode", [&pool](const std::size_t i) {
+                const auto encoded = Option<Position>(pool.value(i)).encode();
+
+                keep(encoded);
+
+                return encoded.size();
+            });
+
+            runner.run("Option<Position>", "decode", [&pool](const std::size_t i) {
+                keep(Option<Position>::decode(pool.bytes(i).data(), Boolean(pool.value(i).has_value())));
+
+                return pool.bytes(i).size();
+            });
+        }
+    }
+
+    /**
+     * @if zh
+     * @brief 整包序列化与反序列化，压缩模式使用常见的256字节阈值
+     *
+     * @else
+     * @brief Whole-packet serialization and deserialization, compressed mode uses the common threshold of 256 bytes
+     *
+     * @endif
+     * */
+    template<typename P, typename M>
+    void package(Runner& runner, const std::string& name, M&& make) {
+        for (const bool compressed : {false, true}) {
+            const auto suffix = compressed ? "/compressed" : "";
+
+            std::vector<std::vector<std::byte>> frames;
+
+            for (std::size_t i = 0; i < POOL; i++) frames.push_back(make().serialize(compressed, 256));
+
+            // 每次迭代重新构造数据包，否则会命中序列化缓存
+            std::vector<P> packets;
+
+            for (std::size_t i = 0; i < POOL; i++) packets.push_back(make());
+
+            runner.run(name + suffix, "encode", [&packets, compressed](const std::size_t i) {
+                auto packet        = packets[i % POOL];
+                const auto encoded = packet.serialize(compressed, 256);
+
+                keep(encoded);
+
+                return encoded.size();
+            });
+
+            runner.run(name + suffix, "decode", [&frames, compressed](const std::size_t i) {
+                const auto& frame = frames[i % POOL];
+
+                keep(P::deserialize(frame.data(), compressed));
+
+                return frame.size();
+            });
+        }
+    }
+
+    inline void packages(Runner& runner) {
+        using client_bound::handshake_step::HandShakePacketType;
+        using server_bound::login_step::LoginSuccessPacketType;
+        using server_bound::status_step::ResponsePacketType;
+
+        package<HandShakePacketType>(runner, "HandShake", [] {
+            return HandShakePacketType{VarInt(765), String(std::format("mc{}.example.net", uniform(1, 99))), UShort(25565), VarInt(2)};
+        });
+
+        package<server_bound::play_step::KeepAlivePacketType>(runner, "KeepAlive", [] { return server_bound::play_step::KeepAlivePacketType{Long(uniform<std::int64_t>(0, 1'900'000'000'000))}; });
+
+        package<LoginSuccessPacketType>(runner, "LoginSuccess", [] { return LoginSuccessPacketType{UUID(uuidValue()), String(stringValue().substr(0, 16))}; });
+
+        package<server_bound::play_step::SpawnEntity2PacketType>(runner, "SpawnEntity", [] {
+            return server_bound::play_step::SpawnEntity2PacketType{
+                VarInt(uniform(1, 200'000)), UUID(uuidValue()), VarInt(uniform(0, 150)), Double(coordinate()), Double(uniform(-64.0, 320.0)), Double(coordinate()), Angle(uniform(0.0f, 360.0f)),
+                Angle(uniform(0.0f, 360.0f)), Angle(uniform(0.0f, 360.0f)), VarInt(0), Short(static_cast<std::int16_t>(uniform(-800, 800))), Short(static_cast<std::int16_t>(uniform(-800, 800))),
+                Short(static_cast<std::int16_t>(uniform(-800, 800)))};
+        });
+
+        package<server_bound::play_step::SynchronizePlayerPositionPacketType>(runner, "SynchronizePlayerPosition", [] {
+            return server_bound::play_step::SynchronizePlayerPositionPacketType{Double(coordinate()),
+                                                                                Double(uniform(-64.0, 320.0)),
+                                                                                Double(coordinate()),
+                                                                                Float(uniform(-180.0f, 180.0f)),
+                                                                                Float(uniform(-90.0f, 90.0f)),
+                                                                                minecraft::protocol::Byte(0),
+                                                                                VarInt(uniform(1, 1000))};
+        });
+
+        package<ResponsePacketType>(runner, "StatusResponse", [] {
+            return ResponsePacketType{String(std::format(R"({{"version":{{"name":"1.21.4","protocol":769}},"players":{{"max":{},"online":{}}},"description":"{}"}})",
+                                                                                    uniform(20, 1000), uniform(0, 20), stringValue()))};
+        });
+    }
+
+    inline std::vector<BlockChange> blockChanges(const std::size_t count, const int minState, const int maxState) {
+        std::vector<BlockChange> changes;
+
+        for (std::size_t i = 0; i < count; i++)
+            changes.push_back({uniform(minState, maxState), static_cast<std::uint8_t>(uniform(0, 15)), static_cast<std::uint8_t>(uniform(0, 15)), static_cast<std::uint8_t>(uniform(0, 15))});
+
+        return changes;
+    }
+
+    /**
+     * @if zh
+     * @brief 方块变化写入区块段：爆炸式的整批写入空气，以及迫使调色板转为直接模式的随机写入
+     * @details 每次迭代从同一基准段复制，复制本身也计入耗时
+     *
+     * @else
+     * @brief Block changes written into a section: an explosion-like batch of air, and random writes that force the palette into direct mode
+     * @details Every iteration copies the same base section, the copy is included in the time
+     *
+     * @endif
+     * */
+    inline void sections(Runner& runner) {
+        ChunkSection base;
+
+        base.set(SectionBlocks(blockChanges(PalettedContainer::BLOCKS, 1, 12)));
+
+        for (const auto& [name, count, maxState] : {std::tuple{"SectionBlocks/explosion", 512, 0}, std::tuple{"SectionBlocks/direct", 256, 4000}}) {
+            std::vector<SectionBlocks> batches;
+
+            for (std::size_t i = 0; i < POOL; i++) batches.emplace_back(blockChanges(static_cast<std::size_t>(count), 0, maxState));
+
+            runner.run(name, "apply", [&base, &batches](const std::size_t i) {
+                auto section = base;
+
+                section.set(batches[i % POOL]);
+
+                keep(section.blockCount);
+
+                return batches[i % POOL].size();
+            });
+        }
+
+        package<server_bound::play_step::UpdateSectionBlocksPacketType>(runner, "UpdateSectionBlocks", [] {
+            return server_bound::play_step::UpdateSectionBlocksPacketType{Long(static_cast<std::int64_t>(uniform(-1000, 1000)) << 42 | uniform(0, 23)), VarInt(256),
+                                                                          SectionBlocks(blockChanges(256, 0, 27000))};
+        });
+    }
+
+    /**
+     * @if zh
+     * @brief 实体表：一万个实体的整表位置推进，以及随机ID的生成与移除交替
+     *
+     * @else
+     * @brief Entity table: advancing the positions of ten thousand entities, and spawns alternating with removals of random ids
+     *
+     * @endif
+     * */
+    inline void entities(Runner& runner) {
+        constexpr std::size_t COUNT = 10'000;
+
+        minecraft::world::EntityTable table;
+
+        for (std::size_t i = 0; i < COUNT; i++)
+            table.spawn({.id = static_cast<std::int32_t>(i), .x = coordinate(), .y = uniform(-64.0, 320.0), .z = coordinate(), .vx = uniform(-0.1f, 0.1f), .vz = uniform(-0.1f, 0.1f)});
+
+        runner.run("EntityTable", "advance", [&table](std::size_t) {
+            table.advance();
+
+            keep(table.x()[0]);
+
+            return table.size() * 3 * (sizeof(double) + sizeof(float));
+        });
+
+        std::vector<std::int32_t> ids;
+
+        for (std::size_t i = 0; i < POOL; i++) ids.push_back(uniform(0, static_cast<int>(COUNT) * 2));
+
+        runner.run("EntityTable", "churn", [&table, &ids](const std::size_t i) {
+            const auto id = ids[i % POOL];
+
+            if (!table.remove(id)) table.spawn({.id = id});
+
+            keep(table.size());
+
+            return sizeof(minecraft::world::EntityTable::Entity);
+        });
+    }
+}  // namespace bench
+
+int main(const int argc, char* argv[]) {
+    bench::Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+
+        if (arg == "--filter" && i + 1 < argc)
+            options.filter = argv[++i];
+
+        else if (arg == "--min-time" && i + 1 < argc)
+            options.minTime = std::chrono::milliseconds(std::atoi(argv[++i]));
+
+        else if (arg == "--out" && i + 1 < argc)
+            options.out = argv[++i];
+
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--filter <substring>] [--min-time <ms>] [--out <json file>]" << std::endl;
+
+            return 1;
+        }
+    }
+
+    bench::Runner runner(options);
+
+    bench::fields(runner);
+    bench::packages(runner);
+    bench::sections(runner);
+    bench::entities(runner);
+
+    if (options.out.empty())
+        runner.writeJson(std::cout);
+
+    else {
+        std::ofstream out(options.out, std::ios::trunc);
+
+        if (!out) {
+            std::cerr << "Cannot open " << options.out << std::endl;
+
+            return 1;
+        }
+
+        runner.writeJson(out);
+    }
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file captureDump.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/18 21:10
+ * @brief Offline pretty-printer for capture files written by @c Client::capture
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+
+#include "../minecraft/src/protocol/package/capture.h"
+#include <iostream>
+
+int main(const int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <capture file>..." << std::endl;
+
+        return 1;
+    }
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            const auto count = minecraft::protocol::printCapture(argv[i], std::cout);
+
+            std::cerr << argv[i] << ": " << count << " records" << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,259 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file compileBenchmark.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 04:40
+ * @brief Generates translation units that include client.h plus N synthetic packets, times the compiler frontend on each and reports the cost per added packet
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef MC_CXX_COMPILER
+    #define MC_CXX_COMPILER "c++"
+#endif
+
+#ifndef MC_SOURCE_DIR
+    #define MC_SOURCE_DIR "."
+#endif
+
+#ifndef MC_ZLIB_INCLUDE
+    #define MC_ZLIB_INCLUDE "../zlib/include"
+#endif
+
+namespace compile {
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::vector<std::size_t> packets{0, 8, 16, 32, 64};
+
+        int repeat = 3;
+
+        std::string compiler = MC_CXX_COMPILER;
+
+        std::string flags;
+
+        std::string out;
+    };
+
+    struct Sample {
+        std::size_t packets = 0;
+
+        // 未定义MC_PROTOCOL_EXTERN_PACKETS，内置数据包在本翻译单元中实例化
+        double implicitSeconds = 0;
+
+        // 定义了MC_PROTOCOL_EXTERN_PACKETS，内置数据包只做extern声明
+        double externSeconds = 0;
+    };
+
+    std::vector<std::size_t> parseList(const std::string_view text) {
+        std::vector<std::size_t> values;
+
+        for (std::size_t begin = 0; begin <= text.size();) {
+            const auto end = std::min(text.find(',', begin), text.size());
+
+            if (end > begin) values.push_back(std::strtoull(std::string(text.substr(begin, end - begin)).c_str(), nullptr, 10));
+
+            begin = end + 1;
+        }
+
+        return values;
+    }
+
+    /**
+     * @if zh
+     * @brief 生成包含client.h与 @p count 个合成数据包的翻译单元
+     * @details 每个数据包的字段组合与真实数据包相近，并像客户端一样调用解码、编码与格式化，使其实例化全部编解码路径
+     *
+     * @else
+     * @brief Generate a translation unit including client.h and @p count synthetic packets
+     * @details Each packet has a field mix close to real packets and is decoded, encoded and formatted the way the client does,
+     * so every codec path gets instantiated
+     *
+     * @endif
+     * */
+    std::string generate(const std::size_t count) {
+        std::string source = std::format("#include \"{}/minecraft/src/client/client.h\"\n\nusing namespace minecraft::protocol;\n\nnamespace bench {{\n", MC_SOURCE_DIR);
+
+        for (std::size_t i = 0; i < count; i++)
+            source += std::format(R"(    using Packet{0} = Package<{0}, FI<"EntityID", VarInt>, FI<"Name{0}", String>, FI<"Time", Long>, FI<"X", Double>, FI<"Yaw", Angle>, FI<"OnGround", Boolean>>;)"
+                                  "\n",
+                                  i);
+
+        source += "}  // namespace bench\n\nstd::size_t touch(const std::byte* data) {\n    std::size_t total = 0;\n";
+
+        for (std::size_t i = 0; i < count; i++)
+            source += std::format("    {{\n        const auto p = bench::Packet{0}::deserialize(data, true);\n        total += p.serialize(true, 256).size() + std::format(\"{{}}\", p).size();\n    }}\n", i);
+
+        source += "    return total;\n}\n";
+
+        return source;
+    }
+
+    std::string command(const Options& options, const std::filesystem::path& file, const bool externPackets) {
+#ifdef _MSC_VER
+        auto cmd = std::format(R"("{}" /nologo /std:c++latest /EHsc /Zs /I "{}" {}{} "{}" > NUL 2>&1)", options.compiler, MC_ZLIB_INCLUDE, externPackets ? "/DMC_PROTOCOL_EXTERN_PACKETS " : "",
+                               options.flags, file.string());
+#else
+        auto cmd = std::format(R"("{}" -std=c++23 -fsyntax-only -I "{}" {}{} "{}" > /dev/null 2>&1)", options.compiler, MC_ZLIB_INCLUDE, externPackets ? "-DMC_PROTOCOL_EXTERN_PACKETS " : "",
+                               options.flags, file.string());
+#endif
+
+#ifdef _WIN32
+        // cmd /c 会去掉整行最外层的一对引号
+        cmd = '"' + cmd + '"';
+#endif
+
+        return cmd;
+    }
+
+    // 多次编译取最短时间，排除磁盘缓存与调度的干扰
+    double time(const std::string& cmd, const int repeat) {
+        auto best = std::chrono::duration<double>::max();
+
+        for (int i = 0; i < repeat; i++) {
+            const auto start = Clock::now();
+
+            if (std::system(cmd.c_str()) != 0) throw std::runtime_error("Compilation failed: " + cmd);
+
+            best = std::min(best, std::chrono::duration<double>(Clock::now() - start));
+        }
+
+        return best.count();
+    }
+
+    // 最小二乘斜率：每增加一个数据包的前端时间
+    double slope(const std::vector<Sample>& samples, double Sample::* field) {
+        if (samples.size() < 2) return 0;
+
+        double meanX = 0, meanY = 0;
+
+        for (const auto& s : samples) {
+            meanX += static_cast<double>(s.packets);
+            meanY += s.*field;
+        }
+
+        meanX /= static_cast<double>(samples.size());
+        meanY /= static_cast<double>(samples.size());
+
+        double num = 0, den = 0;
+
+        for (const auto& s : samples) {
+            num += (static_cast<double>(s.packets) - meanX) * (s.*field - meanY);
+            den += (static_cast<double>(s.packets) - meanX) * (static_cast<double>(s.packets) - meanX);
+        }
+
+        return den == 0 ? 0 : num / den;
+    }
+
+    void writeJson(std::ostream& out, const Options& options, const std::vector<Sample>& samples) {
+        // Windows路径中的反斜杠在JSON中需要转义，统一换成正斜杠
+        auto compiler = options.compiler;
+        std::ranges::replace(compiler, '\\', '/');
+
+        out << std::format(R"({{"compiler":"{}","repeat":{},"implicit_ms_per_packet":{:.3f},"extern_ms_per_packet":{:.3f},"runs":[)", compiler, options.repeat,
+                           slope(samples, &Sample::implicitSeconds) * 1e3, slope(samples, &Sample::externSeconds) * 1e3);
+
+        for (std::size_t i = 0; i < samples.size(); i++)
+            out << std::format(R"({}{{"packets":{},"implicit_ms":{:.1f},"extern_ms":{:.1f}}})", i ? ",\n" : "\n", samples[i].packets, samples[i].implicitSeconds * 1e3, samples[i].externSeconds * 1e3);
+
+        out << "\n]}\n";
+    }
+}  // namespace compile
+
+int main(const int argc, char* argv[]) {
+    compile::Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+
+        if (arg == "--packets" && i + 1 < argc)
+            options.packets = compile::parseList(argv[++i]);
+
+        else if (arg == "--repeat" && i + 1 < argc)
+            options.repeat = std::max(1, std::atoi(argv[++i]));
+
+        else if (arg == "--compiler" && i + 1 < argc)
+            options.compiler = argv[++i];
+
+        else if (arg == "--flags" && i + 1 < argc)
+            options.flags = std::string(argv[++i]) + " ";
+
+        else if (arg == "--out" && i + 1 < argc)
+            options.out = argv[++i];
+
+        else {
+            options.packets.clear();
+            break;
+        }
+    }
+
+    if (options.packets.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--packets <n,n,...>] [--repeat <n>] [--compiler <path>] [--flags <extra compiler flags>] [--out <json file>]" << std::endl;
+
+        return 1;
+    }
+
+    const auto file = std::filesystem::temp_directory_path() / "mc_compile_benchmark.cpp";
+
+    std::vector<compile::Sample> samples;
+
+    try {
+        for (const auto count : options.packets) {
+            std::ofstream(file, std::ios::trunc) << compile::generate(count);
+
+            auto& s = samples.emplace_back();
+
+            s.packets         = count;
+            s.implicitSeconds = compile::time(compile::command(options, file, false), options.repeat);
+            s.externSeconds   = compile::time(compile::command(options, file, true), options.repeat);
+
+            std::cerr << std::format("{:>4} packets  implicit {:>8.1f} ms  extern {:>8.1f} ms", s.packets, s.implicitSeconds * 1e3, s.externSeconds * 1e3) << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+
+        std::filesystem::remove(file);
+
+        return 1;
+    }
+
+    std::filesystem::remove(file);
+
+    std::cerr << std::format("per added packet: implicit {:.2f} ms, extern {:.2f} ms", compile::slope(samples, &compile::Sample::implicitSeconds) * 1e3,
+                             compile::slope(samples, &compile::Sample::externSeconds) * 1e3)
+              << std::endl;
+
+    if (options.out.empty())
+        compile::writeJson(std::cout, options, samples);
+
+    else {
+        std::ofstream out(options.out, std::ios::trunc);
+
+        if (!out) {
+            std::cerr << "Cannot open " << options.out << std::endl;
+
+            return 1;
+        }
+
+        compile::writeJson(out, options, samples);
+    }
+
+    return 0;
+}
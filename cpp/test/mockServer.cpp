@@ -0,0 +1,95 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file mockServer.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 02:10
+ * @brief Runs the scripted mock server standalone so clients and benchmarks can connect to it
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+
+#include "../minecraft/src/server/mockServer.h"
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <string>
+#include <thread>
+
+int main(const int argc, char* argv[]) {
+    using namespace minecraft::server;
+
+    MockServerConfig config;
+    config.port = 25565;
+
+    int duration = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+
+        if (arg == "--host" && i + 1 < argc)
+            config.host = argv[++i];
+
+        else if (arg == "--port" && i + 1 < argc)
+            config.port = static_cast<std::uint16_t>(std::atoi(argv[++i]));
+
+        else if (arg == "--threshold" && i + 1 < argc)
+            config.compressionThreshold = std::atoi(argv[++i]);
+
+        else if (arg == "--rate" && i + 1 < argc)
+            config.trafficRate = std::atof(argv[++i]);
+
+        else if (arg == "--keepalive" && i + 1 < argc)
+            config.keepAliveInterval = std::chrono::milliseconds(std::atoi(argv[++i]));
+
+        else if (arg == "--teleport" && i + 1 < argc)
+            config.teleportInterval = std::chrono::milliseconds(std::atoi(argv[++i]));
+
+        else if (arg == "--max-connections" && i + 1 < argc)
+            config.maxConnections = std::strtoull(argv[++i], nullptr, 10);
+
+        else if (arg == "--duration" && i + 1 < argc)
+            duration = std::atoi(argv[++i]);
+
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--host <ip>] [--port <port>] [--threshold <bytes, -1 disables>] [--rate <packets/s per connection>] [--keepalive <ms>] [--teleport <ms>]"
+                         " [--max-connections <n>] [--duration <s, 0 runs forever>]"
+                      << std::endl;
+
+            return 1;
+        }
+    }
+
+    MockServer server(config);
+
+    if (!server.start()) {
+        std::cerr << std::format("Cannot listen on {}:{}", config.host, config.port) << std::endl;
+
+        return 1;
+    }
+
+    std::cerr << std::format("Listening on {}:{}", config.host, server.port()) << std::endl;
+
+    const auto ms = [](const std::chrono::nanoseconds d) { return static_cast<double>(d.count()) / 1e6; };
+
+    for (int elapsed = 1; duration <= 0 || elapsed <= duration; elapsed++) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+
+        const auto s = server.stats();
+
+        std::cerr << std::format("[{:>4}s] active {:>5}  logins {:>6}  sent {:>10} packets {:>8.2f} MB  received {:>8} packets  keepalive p50 {:.3f} ms p99 {:.3f} ms  errors {}", elapsed,
+                                 s.active, s.logins, s.packetsSent, static_cast<double>(s.bytesSent) / 1e6, s.packetsReceived, ms(s.keepAliveRtt.p50), ms(s.keepAliveRtt.p99),
+                                 s.protocolErrors)
+                  << std::endl;
+    }
+
+    server.stop();
+
+    return 0;
+}
@@ -0,0 +1,368 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file replayBenchmark.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 01:30
+ * @brief Replays the inbound side of a capture file through framing, @c parsePacket and handler dispatch as fast as possible
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+
+#include "../minecraft/src/client/handlers.h"
+#include "../minecraft/src/protocol/package/capture.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace replay {
+    using namespace minecraft::protocol;
+    using minecraft::client::HandlerTable;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int THRESHOLD = 256;
+
+    struct Options {
+        std::string capture;
+
+        int iterations = 20;
+
+        std::size_t chunk = 16 * 1024;
+
+        bool handlers = true;
+
+        std::string out;
+    };
+
+    struct FrameMeta {
+        State state;
+
+        bool compressed;
+    };
+
+    /**
+     * @if zh
+     * @brief 一种回放模式：按接收顺序拼接的线路字节及每帧的状态与压缩标记
+     *
+     * @else
+     * @brief One replay mode: the wire bytes in receive order plus the state and compression flag of every frame
+     *
+     * @endif
+     * */
+    struct Stream {
+        std::string mode;
+
+        std::vector<std::byte> wire;
+
+        std::vector<FrameMeta> frames;
+    };
+
+    struct Result {
+        std::string mode;
+
+        std::uint64_t packets = 0;
+
+        std::uint64_t bytes = 0;
+
+        double seconds = 0;
+
+        Clock::duration framing{};
+
+        Clock::duration decode{};
+
+        Clock::duration dispatch{};
+    };
+
+    std::vector<std::byte> varInt(const int value) {
+        const auto bytes = VarInt(value).encode();
+
+        return {bytes.begin(), bytes.end()};
+    }
+
+    /**
+     * @if zh
+     * @brief 取出帧中的数据包ID与数据部分，压缩帧先解压
+     *
+     * @else
+     * @brief Extract the packet id and data of a frame, inflating compressed frames first
+     *
+     * @endif
+     * */
+    std::vector<std::byte> frameBody(const std::vector<std::byte>& frame, const bool compressed) {
+        auto [length, lengthShift] = parseVarInt<int>(frame.data());
+        const auto* data           = frame.data() + lengthShift;
+
+        if (!compressed) return {data, data + length};
+
+        auto [dataLength, dataShift] = parseVarInt<int>(data);
+        const auto* payload          = data + dataShift;
+        const auto payloadSize       = static_cast<std::size_t>(length - dataShift);
+
+        if (dataLength == 0) return {payload, payload + payloadSize};
+
+        return minecraft::decompressData({payload, payload + payloadSize}, static_cast<std::size_t>(dataLength));
+    }
+
+    std::vector<std::byte> uncompressedFrame(const std::vector<std::byte>& body) {
+        auto frame = varInt(static_cast<int>(body.size()));
+
+        frame.insert(frame.end(), body.begin(), body.end());
+
+        return frame;
+    }
+
+    std::vector<std::byte> compressedFrame(const std::vector<std::byte>& body) {
+        std::vector<std::byte> inner;
+
+        if (body.size() >= THRESHOLD) {
+            inner           = varInt(static_cast<int>(body.size()));
+            const auto zlib = minecraft::compressData(body);
+
+            inner.insert(inner.end(), zlib.begin(), zlib.end());
+        }
+
+        else {
+            inner = varInt(0);
+            inner.insert(inner.end(), body.begin(), body.end());
+        }
+
+        auto frame = varInt(static_cast<int>(inner.size()));
+
+        frame.insert(frame.end(), inner.begin(), inner.end());
+
+        return frame;
+    }
+
+    /**
+     * @if zh
+     * @brief 读取抓包中收到的帧，生成原样、全部未压缩、全部压缩三种回放流
+     * @details 后两种模式在整个会话中统一帧格式，压缩模式使用256字节阈值
+     *
+     * @else
+     * @brief Read the inbound frames of a capture and build three replay streams: as recorded, all uncompressed and all compressed
+     * @details The last two use one frame format for the whole session, the compressed one with a threshold of 256 bytes
+     *
+     * @endif
+     * */
+    std::vector<Stream> load(const std::string& path) {
+        CaptureReader reader(path);
+        CaptureRecord record;
+
+        std::vector<Stream> streams{{"recorded"}, {"uncompressed"}, {"compressed"}};
+
+        while (reader.next(record)) {
+            if (record.direction != Direction::INBOUND) continue;
+
+            const auto body = frameBody(record.frame, record.compressed);
+
+            const std::array frames{record.frame, uncompressedFrame(body), compressedFrame(body)};
+            const std::array flags{record.compressed, false, true};
+
+            for (std::size_t i = 0; i < streams.size(); i++) {
+                streams[i].wire.insert(streams[i].wire.end(), frames[i].begin(), frames[i].end());
+                streams[i].frames.push_back({record.state, flags[i]});
+            }
+        }
+
+        return streams;
+    }
+
+    /**
+     * @if zh
+     * @brief 以与 @c Client 相同的方式回放一遍
+     * @details 按固定块大小模拟套接字读取，逐帧解析并分发到回调表；@p profile 为真时对各阶段计时，否则只测总吞吐
+     *
+     * @else
+     * @brief Replay the stream once the way @c Client does
+     * @details Simulates socket reads of a fixed chunk size, parses every frame and dispatches it to the handler table;
+     * when @p profile is true each stage is timed, otherwise only the total throughput is measured
+     *
+     * @endif
+     * */
+    void replayOnce(const Stream& stream, HandlerTable& handlers, const Options& options, const bool profile, Result& result) {
+        FrameReader reader;
+        std::vector<std::byte> frame;
+        std::size_t index = 0;
+
+        Clock::time_point mark;
+
+        auto cb = [&handlers, &result, &mark, profile]<is_package T>(const T& packet) {
+            Clock::time_point decoded;
+
+            if (profile) {
+                decoded = Clock::now();
+                result.decode += decoded - mark;
+            }
+
+            std::get<minecraft::client::HandlerList<T>>(handlers).dispatch(packet);
+
+            if (profile) result.dispatch += Clock::now() - decoded;
+        };
+
+        auto pred = [&handlers]<is_package T>(std::type_identity<T>, int) { return !std::get<minecraft::client::HandlerList<T>>(handlers).empty(); };
+
+        for (std::size_t offset = 0; offset < stream.wire.size(); offset += options.chunk) {
+            const auto size = std::min(options.chunk, stream.wire.size() - offset);
+
+            if (profile) mark = Clock::now();
+
+            reader.feed(stream.wire.data() + offset, size);
+
+            while (reader.next(frame)) {
+                if (profile) {
+                    const auto framed = Clock::now();
+
+                    result.framing += framed - mark;
+                    mark = framed;
+                }
+
+                const auto& meta = stream.frames[index++];
+
+                parsePacket(meta.state, frame, meta.compressed, cb, pred);
+
+                if (profile) mark = Clock::now();
+            }
+        }
+
+        result.packets += index;
+        result.bytes += stream.wire.size();
+    }
+
+    Result run(const Stream& stream, HandlerTable& handlers, const Options& options) {
+        Result result{stream.mode};
+
+        // 预热一遍，避免首轮的页错误与分配计入结果
+        replayOnce(stream, handlers, options, false, result);
+
+        result = {stream.mode};
+
+        const auto start = Clock::now();
+
+        for (int i = 0; i < options.iterations; i++) replayOnce(stream, handlers, options, false, result);
+
+        result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        // 单独的一遍计时各阶段，计时开销不影响吞吐数字
+        Result profile{stream.mode};
+
+        replayOnce(stream, handlers, options, true, profile);
+
+        result.framing  = profile.framing;
+        result.decode   = profile.decode;
+        result.dispatch = profile.dispatch;
+
+        return result;
+    }
+
+    void writeJson(std::ostream& out, const Options& options, const std::vector<Result>& results, const std::size_t frames) {
+        out << std::format(R"({{"capture":"{}","frames":{},"iterations":{},"chunk":{},"handlers":{},"modes":[)", options.capture, frames, options.iterations, options.chunk, options.handlers);
+
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const auto& r      = results[i];
+            const auto perPass = static_cast<double>(r.packets) / options.iterations;
+            const auto ns      = [perPass](const Clock::duration d) { return perPass ? static_cast<double>(std::chrono::nanoseconds(d).count()) / perPass : 0.0; };
+
+            out << std::format(
+                R"({}{{"mode":"{}","packets":{},"bytes":{},"packets_per_sec":{:.1f},"mb_per_sec":{:.3f},"framing_ns_per_packet":{:.1f},"decode_ns_per_packet":{:.1f},"dispatch_ns_per_packet":{:.1f}}})",
+                i ? ",\n" : "\n", r.mode, r.packets, r.bytes, static_cast<double>(r.packets) / r.seconds, static_cast<double>(r.bytes) / r.seconds / 1e6, ns(r.framing), ns(r.decode), ns(r.dispatch));
+        }
+
+        out << "\n]}\n";
+    }
+}  // namespace replay
+
+int main(const int argc, char* argv[]) {
+    replay::Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+
+        if (arg == "--iterations" && i + 1 < argc)
+            options.iterations = std::max(1, std::atoi(argv[++i]));
+
+        else if (arg == "--chunk" && i + 1 < argc)
+            options.chunk = std::max<std::size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+
+        else if (arg == "--no-handlers")
+            options.handlers = false;
+
+        else if (arg == "--out" && i + 1 < argc)
+            options.out = argv[++i];
+
+        else if (options.capture.empty() && !arg.starts_with("--"))
+            options.capture = argv[i];
+
+        else {
+            options.capture.clear();
+            break;
+        }
+    }
+
+    if (options.capture.empty()) {
+        std::cerr << "Usage: " << argv[0] << " <capture file> [--iterations <n>] [--chunk <bytes>] [--no-handlers] [--out <json file>]" << std::endl;
+
+        return 1;
+    }
+
+    try {
+        const auto streams = replay::load(options.capture);
+
+        if (streams.front().frames.empty()) {
+            std::cerr << options.capture << ": no inbound frames" << std::endl;
+
+            return 1;
+        }
+
+        // 每种数据包挂一个空回调，迫使全部帧完整解码并分发；--no-handlers 时走跳过解码的路径
+        minecraft::client::HandlerTable handlers;
+
+        if (options.handlers) std::apply([](auto&... lists) { (lists.add([](const auto&) {}, -1), ...); }, handlers);
+
+        std::vector<replay::Result> results;
+
+        for (const auto& stream : streams) {
+            results.push_back(replay::run(stream, handlers, options));
+
+            const auto& r      = results.back();
+            const auto perPass = static_cast<double>(r.packets) / options.iterations;
+
+            std::cerr << std::format("{:<13} {:>12.0f} packets/s {:>9.2f} MB/s   framing {:>7.1f} ns  decode {:>8.1f} ns  dispatch {:>6.1f} ns", r.mode, static_cast<double>(r.packets) / r.seconds,
+                                     static_cast<double>(r.bytes) / r.seconds / 1e6, static_cast<double>(std::chrono::nanoseconds(r.framing).count()) / perPass,
+                                     static_cast<double>(std::chrono::nanoseconds(r.decode).count()) / perPass, static_cast<double>(std::chrono::nanoseconds(r.dispatch).count()) / perPass)
+                      << std::endl;
+        }
+
+        if (options.out.empty())
+            replay::writeJson(std::cout, options, results, streams.front().frames.size());
+
+        else {
+            std::ofstream out(options.out, std::ios::trunc);
+
+            if (!out) {
+                std::cerr << "Cannot open " << options.out << std::endl;
+
+                return 1;
+            }
+
+            replay::writeJson(out, options, results, streams.front().frames.size());
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,393 @@
+// Copyright (c) 2025. All rights reserved.
+// This source code is licensed under the CC BY-NC-SA
+// (Creative Commons Attribution-NonCommercial-NoDerivatives) License, By Xiao Songtao.
+// This software is protected by copyright law. Reproduction, distribution, or use for commercial
+// purposes is prohibited without the author's permission. If you have any questions or require
+// permission, please contact the author: 2207150234@st.sziit.edu.cn
+
+/**
+ * @file swarm.cpp
+ * @author edocsitahw
+ * @version 1.1
+ * @date 2026/10/19 02:50
+ * @brief Starts N clients against the in-process mock server and reports how connection rate, throughput, CPU, memory and reply latency scale with N and the core count
+ * @copyright CC BY-NC-SA 2025. All rights reserved.
+ * */
+
+#ifdef _WIN32
+    #include <windows.h>
+
+    #include <psapi.h>
+
+    #pragma comment(lib, "Psapi.lib")
+#else
+    #include <sched.h>
+    #include <sys/resource.h>
+    #include <unistd.h>
+#endif
+
+#include "../minecraft/src/client/client.h"
+#include "../minecraft/src/server/mockServer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace swarm {
+    using namespace minecraft;
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::vector<std::size_t> clients{1, 10, 100, 1000};
+
+        // 0表示不限制，使用全部核心
+        std::vector<std::size_t> cores{0};
+
+        int duration = 10;
+
+        int loginTimeout = 60;
+
+        double moveRate = 20;
+
+        double trafficRate = 20;
+
+        int keepAlive = 1000;
+
+        int threshold = 256;
+
+        std::string out;
+    };
+
+    struct Result {
+        std::size_t clients = 0;
+
+        std::size_t cores = 0;
+
+        std::size_t logins = 0;
+
+        double connectSeconds = 0;
+
+        double packetsPerSec = 0;
+
+        double bytesPerSec = 0;
+
+        double cpuPerConnection = 0;
+
+        double rssPerConnection = 0;
+
+        client::LatencySummary keepAlive;
+
+        client::LatencySummary teleport;
+
+        std::uint64_t errors = 0;
+    };
+
+    std::vector<std::size_t> parseList(const std::string_view text) {
+        std::vector<std::size_t> values;
+
+        for (std::size_t begin = 0; begin <= text.size();) {
+            const auto end = std::min(text.find(',', begin), text.size());
+
+            if (end > begin) values.push_back(std::strtoull(std::string(text.substr(begin, end - begin)).c_str(), nullptr, 10));
+
+            begin = end + 1;
+        }
+
+        return values;
+    }
+
+    /**
+     * @if zh
+     * @brief 进程累计消耗的CPU时间（用户态与内核态之和）
+     *
+     * @else
+     * @brief CPU time consumed by the process so far, user plus kernel
+     *
+     * @endif
+     * */
+    std::chrono::nanoseconds processCpu() {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+
+        GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+
+        const auto ticks = [](const FILETIME& t) { return (static_cast<std::uint64_t>(t.dwHighDateTime) << 32 | t.dwLowDateTime) * 100; };
+
+        return std::chrono::nanoseconds(ticks(kernel) + ticks(user));
+#else
+        rusage usage{};
+
+        getrusage(RUSAGE_SELF, &usage);
+
+        const auto micros = [](const timeval& t) { return static_cast<std::int64_t>(t.tv_sec) * 1'000'000 + t.tv_usec; };
+
+        return std::chrono::microseconds(micros(usage.ru_utime) + micros(usage.ru_stime));
+#endif
+    }
+
+    std::size_t residentBytes() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters{};
+
+        GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+
+        return counters.WorkingSetSize;
+#else
+        std::ifstream statm("/proc/self/statm");
+        std::size_t size = 0, resident = 0;
+
+        statm >> size >> resident;
+
+        return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    /**
+     * @if zh
+     * @brief 将进程限制在前 @p cores 个核心上，0表示解除限制
+     * @details 只影响之后创建的线程，因此每轮在启动服务器与客户端之前调用
+     *
+     * @else
+     * @brief Restrict the process to the first @p cores cores, 0 lifts the restriction
+     * @details Only threads created afterwards are affected, so it is called before each run starts the server and clients
+     *
+     * @endif
+     * */
+    void restrictCores(const std::size_t cores) {
+        const auto available = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        const auto count     = cores == 0 ? available : std::min(cores, available);
+
+#ifdef _WIN32
+        DWORD_PTR mask = 0;
+
+        for (std::size_t i = 0; i < count && i < sizeof(DWORD_PTR) * 8; i++) mask |= DWORD_PTR{1} << i;
+
+        SetProcessAffinityMask(GetCurrentProcess(), mask);
+#else
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        for (std::size_t i = 0; i < count; i++) CPU_SET(i, &set);
+
+        sched_setaffinity(0, sizeof(set), &set);
+#endif
+    }
+
+    /**
+     * @if zh
+     * @brief 进入游戏阶段后按固定频率发送移动数据包，直到 @p running 为假
+     *
+     * @else
+     * @brief Send movement packets at a fixed rate once in play, until @p running turns false
+     *
+     * @endif
+     * */
+    client::Task<> walk(client::Client& client, const std::atomic_bool& running, const client::EventLoop::Clock::duration period) {
+        using namespace protocol;
+
+        const auto spawn = co_await client.next<server_bound::play_step::SynchronizePlayerPositionPacketType>();
+
+        auto x       = spawn.get<"X">().value();
+        const auto y = spawn.get<"Y">().value();
+        const auto z = spawn.get<"Z">().value();
+
+        while (running) {
+            co_await client.sleep(period);
+
+            x += 0.2;
+
+            client.emit(client_bound::play_step::SetPlayerPositionPacketType{Double(x), Double(y), Double(z), Boolean(true)});
+        }
+    }
+
+    Result run(const Options& options, const std::size_t count, const std::size_t cores) {
+        restrictCores(cores);
+
+        server::MockServer mock({.compressionThreshold = options.threshold,
+                                 .keepAliveInterval    = std::chrono::milliseconds(options.keepAlive),
+                                 .trafficRate          = options.trafficRate,
+                                 .maxConnections       = count});
+
+        if (!mock.start()) throw std::runtime_error("Cannot start the mock server");
+
+        Result result{count, cores};
+
+        std::atomic_bool running = true;
+        std::vector<std::unique_ptr<client::Client>> clients;
+        std::vector<std::thread> runners;
+
+        clients.reserve(count);
+        runners.reserve(count);
+
+        const auto rssBefore = residentBytes();
+        const auto start     = Clock::now();
+        const auto period    = std::chrono::duration_cast<client::EventLoop::Clock::duration>(std::chrono::duration<double>(options.moveRate > 0 ? 1.0 / options.moveRate : 0));
+
+        // 每个客户端的start阻塞到连接结束，各占一个线程
+        for (std::size_t i = 0; i < count; i++) {
+            auto& c = *clients.emplace_back(std::make_unique<client::Client>("127.0.0.1", static_cast<short>(mock.port())));
+
+            if (options.moveRate > 0) c.spawn(walk(c, running, period));
+
+            runners.emplace_back([&c] { c.start(); });
+        }
+
+        const auto deadline = start + std::chrono::seconds(options.loginTimeout);
+
+        while (mock.stats().logins < count && Clock::now() < deadline) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        result.connectSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        result.logins         = mock.stats().logins;
+
+        const auto rssAfter = residentBytes();
+
+        result.rssPerConnection = static_cast<double>(rssAfter > rssBefore ? rssAfter - rssBefore : 0) / static_cast<double>(count);
+
+        // 稳态窗口：登录完成后的计数与CPU时间差
+        const auto before   = mock.stats();
+        const auto cpuStart = processCpu();
+        const auto steady   = Clock::now();
+
+        std::this_thread::sleep_for(std::chrono::seconds(options.duration));
+
+        const auto after   = mock.stats();
+        const auto seconds = std::chrono::duration<double>(Clock::now() - steady).count();
+        const auto cpu     = std::chrono::duration<double>(processCpu() - cpuStart).count();
+
+        result.packetsPerSec    = static_cast<double>(after.packetsSent - before.packetsSent + after.packetsReceived - before.packetsReceived) / seconds;
+        result.bytesPerSec      = static_cast<double>(after.bytesSent - before.bytesSent + after.bytesReceived - before.bytesReceived) / seconds;
+        result.cpuPerConnection = cpu / seconds / static_cast<double>(count);
+        result.keepAlive        = after.keepAliveRtt;
+        result.teleport         = after.teleportRtt;
+        result.errors           = after.protocolErrors;
+
+        running = false;
+
+        // 先让移动协程看到停止标志后结束，再停止客户端
+        if (options.moveRate > 0) std::this_thread::sleep_for(period + std::chrono::milliseconds(client::RECV_TICK_MS * 2));
+
+        for (const auto& c : clients) c->stop();
+
+        for (auto& runner : runners) runner.join();
+
+        clients.clear();
+        mock.stop();
+
+        return result;
+    }
+
+    void writeJson(std::ostream& out, const Options& options, const std::vector<Result>& results) {
+        const auto ms = [](const std::chrono::nanoseconds d) { return static_cast<double>(d.count()) / 1e6; };
+
+        out << std::format(R"({{"duration":{},"move_rate":{},"traffic_rate":{},"keepalive_ms":{},"threshold":{},"hardware_threads":{},"runs":[)", options.duration, options.moveRate,
+                           options.trafficRate, options.keepAlive, options.threshold, std::thread::hardware_concurrency());
+
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const auto& r = results[i];
+
+            out << std::format(R"({}{{"clients":{},"cores":{},"logins":{},"connections_per_sec":{:.1f},"packets_per_sec":{:.1f},"mb_per_sec":{:.3f},"cpu_per_connection":{:.6f},)"
+                               R"("rss_kb_per_connection":{:.1f},"keepalive_p50_ms":{:.3f},"keepalive_p99_ms":{:.3f},"teleport_p50_ms":{:.3f},"teleport_p99_ms":{:.3f},"errors":{}}})",
+                               i ? ",\n" : "\n", r.clients, r.cores, r.logins, static_cast<double>(r.logins) / r.connectSeconds, r.packetsPerSec, r.bytesPerSec / 1e6, r.cpuPerConnection,
+                               r.rssPerConnection / 1024, ms(r.keepAlive.p50), ms(r.keepAlive.p99), ms(r.teleport.p50), ms(r.teleport.p99), r.errors);
+        }
+
+        out << "\n]}\n";
+    }
+}  // namespace swarm
+
+int main(const int argc, char* argv[]) {
+    swarm::Options options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+
+        if (arg == "--clients" && i + 1 < argc)
+            options.clients = swarm::parseList(argv[++i]);
+
+        else if (arg == "--cores" && i + 1 < argc)
+            options.cores = swarm::parseList(argv[++i]);
+
+        else if (arg == "--duration" && i + 1 < argc)
+            options.duration = std::max(1, std::atoi(argv[++i]));
+
+        else if (arg == "--login-timeout" && i + 1 < argc)
+            options.loginTimeout = std::max(1, std::atoi(argv[++i]));
+
+        else if (arg == "--move-rate" && i + 1 < argc)
+            options.moveRate = std::atof(argv[++i]);
+
+        else if (arg == "--traffic-rate" && i + 1 < argc)
+            options.trafficRate = std::atof(argv[++i]);
+
+        else if (arg == "--keepalive" && i + 1 < argc)
+            options.keepAlive = std::max(1, std::atoi(argv[++i]));
+
+        else if (arg == "--threshold" && i + 1 < argc)
+            options.threshold = std::atoi(argv[++i]);
+
+        else if (arg == "--out" && i + 1 < argc)
+            options.out = argv[++i];
+
+        else {
+            options.clients.clear();
+            break;
+        }
+    }
+
+    if (options.clients.empty() || options.cores.empty()) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--clients <n,n,...>] [--cores <n,n,..., 0 = all>] [--duration <s>] [--login-timeout <s>] [--move-rate <packets/s per client>]"
+                     " [--traffic-rate <packets/s per client>] [--keepalive <ms>] [--threshold <bytes>] [--out <json file>]"
+                  << std::endl;
+
+        return 1;
+    }
+
+    std::vector<swarm::Result> results;
+
+    try {
+        for (const auto cores : options.cores) {
+            for (const auto count : options.clients) {
+                if (count == 0) continue;
+
+                results.push_back(swarm::run(options, count, cores));
+
+                const auto& r = results.back();
+
+                std::cerr << std::format("{:>6} clients {:>3} cores  {:>9.1f} conn/s  {:>11.0f} packets/s  CPU {:>6.3f}%/conn  RSS {:>8.1f} KB/conn  keepalive p50 {:.3f} ms p99 {:.3f} ms{}",
+                                         r.clients, r.cores, static_cast<double>(r.logins) / r.connectSeconds, r.packetsPerSec, r.cpuPerConnection * 100, r.rssPerConnection / 1024,
+                                         static_cast<double>(r.keepAlive.p50.count()) / 1e6, static_cast<double>(r.keepAlive.p99.count()) / 1e6,
+                                         r.logins < r.clients ? std::format("  ({} of {} logged in)", r.logins, r.clients) : "")
+                          << std::endl;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+
+        return 1;
+    }
+
+    if (options.out.empty())
+        swarm::writeJson(std::cout, options, results);
+
+    else {
+        std::ofstream out(options.out, std::ios::trunc);
+
+        if (!out) {
+            std::cerr << "Cannot open " << options.out << std::endl;
+
+            return 1;
+        }
+
+        swarm::writeJson(out, options, results);
+    }
+
+    return 0;
+}
@@ -21,6 +21,7 @@
 #include "../minecraft/src/protocol/type/mcuuid.h"
 #include "../minecraft/src/protocol/type/str.h"
 #include "../minecraft/src/protocol/type/varNum.h"
+#include "../minecraft/src/server/mockServer.h"
 #include "../minecraft/src/utils/utils.h"
 #include <iostream>
 #include <sstream>
@@ -126,6 +127,407 @@ void package_test() {
     std::cout << "HandShake decoded value: " << handShakeDeencoded.toString() << std::endl;
 }
 
+void compression_test() {
+    using namespace minecraft::protocol;
+    using BlobPacketType = Package<0x7F, FI<"Blob", Array<>, "__rest__"_ns>>;
+
+    std::vector<std::byte> noise(2048), text(2048);
+
+    for (std::size_t i = 0; i < noise.size(); i++) noise[i] = static_cast<std::byte>((i * 2654435761u) >> 13);
+    for (std::size_t i = 0; i < text.size(); i++) text[i] = static_cast<std::byte>("minecraft "[i % 10]);
+
+    CompressionStats stats;
+
+    auto noiseBytes = BlobPacketType{Array<>::decode(noise.data(), noise.size())}.serialize(true, 256, {}, &stats);
+    auto textBytes  = BlobPacketType{Array<>::decode(text.data(), text.size())}.serialize(true, 256, {}, &stats);
+
+    std::cout << "Noise packet size: " << noiseBytes.size() << ", text packet size: " << textBytes.size() << std::endl;
+    std::cout << "Skipped packets: " << stats.skippedPackets << ", compressed packets: " << stats.compressedPackets << std::endl << std::endl;
+}
+
+void frame_test() {
+    using namespace minecraft::protocol;
+
+    auto first  = server_bound::play_step::KeepAlivePacketType{Long(25565)}.serialize(false, -1);
+    auto second = server_bound::login_step::CompressionPacketType{VarInt(256)}.serialize(false, -1);
+
+    std::vector<std::byte> stream;
+    stream.insert(stream.end(), first.begin(), first.end());
+    stream.insert(stream.end(), second.begin(), second.end());
+
+    FrameReader reader;
+    std::vector<std::byte> frame;
+
+    // 故意在第一个帧中间切开
+    reader.feed(stream.data(), 3);
+    reader.feed(stream.data() + 3, stream.size() - 3);
+
+    while (reader.next(frame)) std::cout << "Frame id: " << peekPacketId(frame, false) << ", size: " << frame.size() << std::endl;
+
+    // 长度前缀超出上限的帧应被拒绝，而不是等待永远凑不齐的数据
+    constexpr std::array badLength{std::byte{0xFF}, std::byte{0xFF}, std::byte{0xFF}, std::byte{0xFF}, std::byte{0x07}};
+
+    FrameReader badReader;
+    badReader.feed(badLength.data(), badLength.size());
+
+    try {
+        badReader.next(frame);
+    } catch (const std::exception& e) {
+        std::cout << "Bad length rejected: " << e.what() << std::endl;
+    }
+
+    std::cout << std::endl;
+}
+
+void executor_test() {
+    using namespace minecraft::client;
+    using namespace minecraft::protocol::server_bound::play_step;
+    using minecraft::protocol::VarInt, minecraft::protocol::Short;
+
+    std::array<std::vector<int>, 4> seen;
+
+    {
+        ShardedExecutor executor(2);
+
+        // 同一实体的速度更新按投递顺序执行
+        for (int i = 0; i < 16; i++) {
+            const SetEntityVelocityPacketType packet{VarInt(i % 4), Short(i), Short(0), Short(0)};
+            const auto entity = packet.get<"EntityID">().value();
+
+            executor.post(ShardKey<SetEntityVelocityPacketType>::of(packet), [&seen, entity, i] { seen[entity].push_back(i); });
+        }
+    }
+
+    for (std::size_t e = 0; e < seen.size(); e++) {
+        std::cout << "Entity " << e << ":";
+
+        for (const auto i : seen[e]) std::cout << " " << i;
+
+        std::cout << std::endl;
+    }
+}
+
+void filter_test() {
+    using namespace minecraft::protocol;
+    using VelocityPacketType = server_bound::play_step::SetEntityVelocityPacketType;
+
+    auto frame = VelocityPacketType{VarInt(25565), Short(1), Short(2), Short(3)}.serialize(false, -1);
+
+    std::array<std::byte, PEEK_WINDOW> scratch;
+    const auto body = peekPacketBody(frame, false, scratch);
+
+    auto filter = minecraft::client::PacketFilter<VelocityPacketType>::bind(minecraft::client::where<"EntityID">.in({42, 25565}));
+
+    std::cout << "EntityID: " << FieldLayout<"EntityID", VelocityPacketType>::read(body).value_or(-1) << ", VelocityZ: " << FieldLayout<"VelocityZ", VelocityPacketType>::read(body).value_or(-1)
+              << ", matches: " << filter.matches(body) << std::endl
+              << std::endl;
+}
+
+minecraft::client::Task<int> delayed_double(minecraft::client::EventLoop& loop, const int value) {
+    co_await minecraft::client::SleepAwaiter(loop, std::chrono::milliseconds(value));
+
+    co_return value * 2;
+}
+
+minecraft::client::Task<> coroutine_script(minecraft::client::EventLoop& loop, int& result) {
+    result = co_await delayed_double(loop, 10);
+    result += co_await delayed_double(loop, 5);
+}
+
+void coroutine_test() {
+    using namespace minecraft::client;
+
+    EventLoop loop;
+    int result = 0;
+
+    loop.post(coroutine_script(loop, result).detach());
+
+    // 模拟接收线程的tick
+    while (loop.pendingTimers() || result == 0) {
+        loop.runTimers();
+        loop.runReady();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::cout << "Coroutine result: " << result << std::endl << std::endl;
+}
+
+void latency_test() {
+    using namespace minecraft::client;
+
+    LatencyTracker tracker;
+    const auto now = LatencyTracker::Clock::now();
+
+    for (int i = 0; i < 100; i++) {
+        const auto id = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count() - i % 7;
+
+        tracker.challenged(Challenge::KEEP_ALIVE, id, now);
+        tracker.replied(Challenge::KEEP_ALIVE, id, now + std::chrono::microseconds(100 + i * 10));
+    }
+
+    const auto reply = tracker.replyLatency(Challenge::KEEP_ALIVE);
+    const auto delay = tracker.keepAliveDelay();
+
+    std::cout << "Reply samples: " << reply.count << ", p50: " << reply.p50.count() << "ns, p99: " << reply.p99.count() << "ns, max: " << reply.max.count() << "ns" << std::endl;
+    std::cout << "Arrival delay p90: " << std::chrono::duration_cast<std::chrono::milliseconds>(delay.p90).count() << "ms" << std::endl << std::endl;
+}
+
+void logging_test() {
+    using namespace minecraft;
+
+    const char bytes[] = {0x0f, 0x00, static_cast<char>(0xfd), 0x05};
+
+    for (int i = 0; i < 1000; i++) debugInfo(std::format("burst {}", i));
+
+    networkBytes<TO_SERVER>(bytes, sizeof(bytes));
+
+    // 关闭级别下惰性消息不会被求值
+    int formatted = 0;
+
+    logConfig.setLevel(LogLevel::WARNING);
+    logConfig.enablePacket(0, 0x25, false);
+
+    debugInfo([&formatted] { return std::format("formatted {}", ++formatted); });
+    packetInfo<TO_CLIENT, LogLevel::CRITICAL>(0, 0x25, [&formatted] { return std::format("formatted {}", ++formatted); });
+    packetInfo<TO_CLIENT, LogLevel::CRITICAL>(0, 0x26, [&formatted] { return std::format("formatted {}", ++formatted); });
+
+    logConfig.setLevel(LogLevel::INFO);
+
+    flushLogs();
+
+    std::cout << "Dropped log records: " << droppedLogRecords() << ", formatted lazy messages: " << formatted << std::endl << std::endl;
+}
+
+void capture_test() {
+    using namespace minecraft::protocol;
+
+    const std::string path = "capture_test.mccp";
+
+    {
+        CaptureWriter writer(path);
+
+        writer.write(Direction::OUTBOUND, State::HANDSHAKE, false, client_bound::handshake_step::HandShakePacketType{VarInt(765), String("localhost"), UShort(25565), VarInt(2)}.serialize(false, -1));
+        writer.write(Direction::INBOUND, State::LOGIN, false, server_bound::login_step::CompressionPacketType{VarInt(256)}.serialize(false, -1));
+        writer.write(Direction::INBOUND, State::PLAY, true, server_bound::play_step::KeepAlivePacketType{Long(25565)}.serialize(true, 256));
+    }
+
+    std::cout << "Captured records: " << printCapture(path, std::cout) << std::endl << std::endl;
+}
+
+void metrics_test() {
+    using namespace minecraft::client;
+    using minecraft::protocol::Direction, minecraft::protocol::State;
+
+    MetricsRegistry registry;
+
+    for (int i = 0; i < 1000; i++) {
+        registry.count(Direction::INBOUND, State::PLAY, 0x24, 40, 120);
+        registry.time(Stage::DECODE, State::PLAY, 0x24, std::chrono::nanoseconds(500 + i * 10));
+    }
+
+    const auto snapshot = registry.snapshot();
+    const auto decode   = snapshot.stage(Stage::DECODE).summary();
+
+    std::cout << "Decode p50: " << decode.p50.count() << "ns, p99: " << decode.p99.count() << "ns" << std::endl;
+    std::cout << snapshot.toPrometheus() << std::endl;
+}
+
+void tracer_test() {
+    using namespace minecraft::protocol;
+
+    const auto frame = server_bound::play_step::KeepAlivePacketType{Long(25565)}.serialize(true, 0);
+
+    for (int i = 0; i < 100; i++) parsePacket(State::PLAY, frame, true, [](const auto&) {});
+
+    minecraft::traceEvent("tracer_test", 100);
+
+    std::cout << "Trace events: " << minecraft::Tracer::instance().collect().size() << std::endl;
+
+    minecraft::Tracer::instance().writeChromeTrace("tracer_test.json");
+}
+
+void timeline_test() {
+    using namespace minecraft::client;
+    using Clock = FrameTimeline::Clock;
+
+    TimelineTracker tracker;
+    tracker.setSlowThreshold(std::chrono::milliseconds(20));
+
+    const auto read = Clock::now();
+
+    // 模拟一个在回调中阻塞的数据包
+    tracker.record({.state        = minecraft::protocol::State::PLAY,
+                    .id           = 0x24,
+                    .read         = read,
+                    .framed       = read + std::chrono::microseconds(20),
+                    .inflated     = read + std::chrono::microseconds(300),
+                    .decoded      = read + std::chrono::microseconds(350),
+                    .handlerStart = read + std::chrono::microseconds(360),
+                    .handlerEnd   = read + std::chrono::milliseconds(45)});
+
+    minecraft::flushLogs();
+
+    std::cout << "Handler p50: " << tracker.stage(FrameStage::HANDLER).p50.count() << "ns, slow packets: " << tracker.slowPackets() << std::endl << std::endl;
+}
+
+void format_test() {
+    using namespace minecraft::protocol;
+
+    const client_bound::handshake_step::HandShakePacketType handShake{VarInt(765), String("localhost"), UShort(25565), VarInt(2)};
+
+    // 缓冲区在多次格式化之间复用，只在容量不足时增长
+    std::string buffer;
+
+    for (int i = 0; i < 3; i++) {
+        buffer.clear();
+
+        handShake.formatTo(std::back_inserter(buffer));
+    }
+
+    std::cout << buffer << std::endl;
+    std::cout << std::format("{} / {:x}", VarInt(25565), VarInt(25565)) << std::endl;
+    std::cout << minecraft::toHexString(handShake.serialize()) << std::endl << std::endl;
+}
+
+void mock_server_test() {
+    using namespace minecraft::client;
+    using namespace minecraft::server;
+
+    MockServer server({.compressionThreshold = 256, .keepAliveInterval = std::chrono::milliseconds(200), .teleportInterval = std::chrono::milliseconds(500), .trafficRate = 500});
+
+    if (!server.start()) return;
+
+    Client client{"127.0.0.1", static_cast<short>(server.port())};
+
+    std::thread runner([&client] { client.start(); });
+
+    std::this_thread::sleep_for(std::chrono::seconds(3));
+
+    client.stop();
+    runner.join();
+
+    const auto stats = server.stats();
+    const auto reply = client.latency().replyLatency(Challenge::KEEP_ALIVE);
+
+    std::cout << "Logins: " << stats.logins << ", sent: " << stats.packetsSent << ", received: " << stats.packetsReceived << ", errors: " << stats.protocolErrors << std::endl;
+    std::cout << "Server KeepAlive RTT p50: " << stats.keepAliveRtt.p50.count() << "ns, teleport RTT p50: " << stats.teleportRtt.p50.count() << "ns" << std::endl;
+    std::cout << "Client KeepAlive reply p50: " << reply.p50.count() << "ns" << std::endl << std::endl;
+
+    server.stop();
+}
+
+void chunk_test() {
+    using namespace minecraft::protocol;
+    using namespace server_bound::play_step;
+
+    std::vector<std::byte> payload;
+
+    const auto put = [&payload](const std::initializer_list<int> bytes) {
+        for (const auto b : bytes) payload.push_back(static_cast<std::byte>(b));
+    };
+
+    // 空高度图，随后两个区块段：全石头的单值段，以及石头与空气交替的4位间接段
+    put({0x0A, 0x00});
+
+    std::vector<std::byte> sections;
+    std::swap(payload, sections);
+
+    put({0x10, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00});
+    put({0x08, 0x00, 0x04, 0x02, 0x00, 0x01, 0x80, 0x02});
+
+    for (int i = 0; i < 256 * 8; i++) put({0x10});
+
+    put({0x00, 0x00, 0x00});
+
+    std::swap(payload, sections);
+    detail::putVarInt(payload, static_cast<std::int32_t>(sections.size()));
+    payload.insert(payload.end(), sections.begin(), sections.end());
+
+    // 无方块实体，光照掩码与数组均为空
+    put({0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+
+    const auto column = ChunkColumn::decode(payload.data(), payload.size());
+    const auto frame  = ChunkDataPacketType{Int(3), Int(-2), ChunkColumn(column)}.serialize(false, -1);
+    const auto packet = ChunkDataPacketType::deserialize(frame.data(), false);
+
+    minecraft::world::ChunkStore store;
+    store.apply(packet);
+
+    std::array<std::int32_t, PalettedContainer::BLOCKS> ids{};
+    packet.get<"Column">().value()->sections[1].blocks.unpack(ids);
+
+    std::cout << packet.toString() << std::endl;
+    std::cout << "Round trip: " << (column.encode() == payload) << ", block (48, -64, -32): " << store.blockAt(48, -64, -32).value_or(-1)
+              << ", block (49, -48, -32): " << store.blockAt(49, -48, -32).value_or(-1) << ", unpacked: " << ids[0] << ids[1] << ids[2] << ids[3] << std::endl;
+    std::cout << "Chunks: " << store.size() << ", memory: " << store.memoryUsage() << " bytes" << std::endl << std::endl;
+}
+
+void section_blocks_test() {
+    using namespace minecraft::protocol;
+    using namespace server_bound::play_step;
+
+    auto column = std::make_shared<ChunkColumn::Data>();
+    column->sections.resize(24);
+
+    minecraft::world::ChunkStore store;
+    store.apply(ChunkDataPacketType{Int(-1), Int(2), ChunkColumn(column)});
+
+    // 段坐标 (-1, 0, 2)，即世界高度0到15，在最低高度-64之上的第4段
+    const std::vector<BlockChange> changes{{1, 0, 0, 0}, {9, 15, 15, 15}, {0, 3, 0, 0}, {5000, 7, 7, 7}};
+
+    const auto frame =
+        UpdateSectionBlocksPacketType{Long(std::int64_t{-1} << 42 | 2 << 20), VarInt(static_cast<int>(changes.size())), SectionBlocks(changes)}.serialize(false, -1);
+    const auto packet = UpdateSectionBlocksPacketType::deserialize(frame.data(), false);
+
+    std::cout << packet.toString() << std::endl;
+    std::cout << "Applied: " << store.apply(packet) << ", block (-16, 0, 32): " << store.blockAt(-16, 0, 32).value_or(-1) << ", block (-1, 15, 47): " << store.blockAt(-1, 15, 47).value_or(-1)
+              << ", block (-9, 7, 39): " << store.blockAt(-9, 7, 39).value_or(-1) << std::endl;
+
+    const auto& section = store.find(-1, 2)->sections[4];
+
+    std::cout << "Block count: " << section.blockCount << ", bits: " << section.blocks.bits() << ", direct: " << section.blocks.direct() << std::endl;
+
+    // 数量字段多于实际条目时解码失败，而不是读出帧外
+    const auto overrun = UpdateSectionBlocksPacketType{Long(0), VarInt(static_cast<int>(changes.size()) + 3), SectionBlocks(changes)}.serialize(false, -1);
+
+    try {
+        (void)UpdateSectionBlocksPacketType::deserialize(overrun.data(), false);
+
+        std::cout << "Overrun accepted" << std::endl << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Overrun rejected: " << e.what() << std::endl << std::endl;
+    }
+}
+
+void entity_test() {
+    using namespace minecraft::protocol;
+    using namespace server_bound::play_step;
+
+    minecraft::world::EntityTable table;
+
+    for (int i = 0; i < 4; i++)
+        table.apply(SpawnEntity2PacketType{VarInt(100 + i), UUID(), VarInt(i), Double(i * 2.0), Double(64.0), Double(-i * 2.0), Angle(0.0f), Angle(90.0f), Angle(0.0f), VarInt(0),
+                                           Short(static_cast<std::int16_t>(800 * i)), Short(0), Short(-800)});
+
+    table.apply(SpawnPlayerPacketType{VarInt(7), UUID(), Double(0.5), Double(70.0), Double(0.5), Angle(180.0f), Angle(0.0f)});
+    table.apply(SetEntityVelocityPacketType{VarInt(7), Short(0), Short(-8000), Short(0)});
+
+    const auto frame  = RemoveEntitiesPacketType{PrefixedArray<VarInt>({VarInt(101), VarInt(999)})}.serialize(false, -1);
+    const auto packet = RemoveEntitiesPacketType::deserialize(frame.data(), false);
+
+    std::cout << packet.toString() << std::endl;
+    table.apply(packet);
+
+    table.advance(10);
+
+    for (std::size_t i = 0; i < table.size(); i++)
+        std::cout << "Entity " << table.ids()[i] << " type " << table.types()[i] << " at (" << table.x()[i] << ", " << table.y()[i] << ", " << table.z()[i] << "), yaw " << table.yaw()[i]
+                  << std::endl;
+
+    std::cout << "Entities: " << table.size() << ", has 101: " << table.find(101).has_value() << ", memory: " << table.memoryUsage() << " bytes" << std::endl << std::endl;
+}
+
 void client_test() {
     using namespace minecraft::client;
 
@@ -147,5 +549,37 @@ int main() {
 
     // package_test();
 
+    // compression_test();
+
+    // frame_test();
+
+    // executor_test();
+
+    // filter_test();
+
+    // coroutine_test();
+
+    // latency_test();
+
+    // logging_test();
+
+    // capture_test();
+
+    // metrics_test();
+
+    // tracer_test();
+
+    // timeline_test();
+
+    // format_test();
+
+    // mock_server_test();
+
+    // chunk_test();
+
+    // section_blocks_test();
+
+    // entity_test();
+
     return 0;
 }